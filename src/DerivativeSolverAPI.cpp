@@ -0,0 +1,209 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file DerivativeSolverAPI.cpp
+ *
+ * Implementation of the C interface of the derivativesolver library.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#include "DerivativeSolverAPI.h"
+
+#include <cstring>
+#include <new>
+#include <string>
+
+#include <Evaluator.h>
+#include <Parser.h>
+#include <ResourceBudget.h>
+#include <Serialization.h>
+#include <SymbolTable.h>
+
+#include "Differentiator.h"
+#include "EGraphOptimizer.h"
+#include "Optimizer.h"
+
+struct ds_expression {
+    PExpression expr;
+};
+
+namespace {
+
+thread_local std::string lastError;
+thread_local ResourceLimits limits;
+
+ds_status fail(ds_status status, const char *message) noexcept {
+    try {
+        lastError = message;
+    } catch (...) {
+        // out of memory, the status is still returned
+        lastError.clear();
+    }
+    return status;
+}
+
+/**
+ * Call the function, translate exceptions into status codes: no exception may
+ * pass the C interface.
+ */
+template <typename F>
+ds_status guard(F function) {
+    try {
+        lastError.clear();
+        return function();
+    } catch (const ParsingException &ex) {
+        return fail(DS_PARSING_ERROR, ex.what());
+    } catch (const BudgetExceededException &ex) {
+        return fail(DS_BUDGET_EXCEEDED, ex.what());
+    } catch (const TraverseException &ex) {
+        return fail(DS_TRAVERSE_ERROR, ex.what());
+    } catch (const std::bad_alloc &ex) {
+        return fail(DS_OUT_OF_MEMORY, "Out of memory.");
+    } catch (const std::exception &ex) {
+        return fail(DS_INTERNAL_ERROR, ex.what());
+    } catch (...) {
+        return fail(DS_INTERNAL_ERROR, "Unknown error.");
+    }
+}
+
+/**
+ * Like guard(), the function runs with the limits of the calling thread.
+ */
+template <typename F>
+ds_status budgeted(F function) {
+    ResourceBudget budget(limits);
+    BudgetScope scope(limits.isUnlimited() ? nullptr : &budget);
+    return guard(function);
+}
+
+ds_status wrap(PExpression expr, ds_expression **result) {
+    *result = new ds_expression{expr};
+    return DS_OK;
+}
+
+/**
+ * Copy the data into the buffer if it fits.
+ */
+ds_status copy(const std::string &data, char *buffer, size_t size, size_t *required) {
+    if (required != nullptr) {
+        *required = data.size();
+    }
+    if (data.size() > size) {
+        return fail(DS_BUFFER_TOO_SMALL, "The buffer is too small.");
+    }
+    std::memcpy(buffer, data.data(), data.size());
+    return DS_OK;
+}
+
+}
+
+const char *ds_last_error(void) {
+    return lastError.c_str();
+}
+
+void ds_set_limits(size_t max_nodes, unsigned int max_passes, unsigned int max_milliseconds) {
+    limits.maxNodes = max_nodes;
+    limits.maxPasses = max_passes;
+    limits.maxMilliseconds = max_milliseconds;
+}
+
+ds_status ds_parse(const char *text, size_t length, ds_expression **result) {
+    if (text == nullptr || result == nullptr) {
+        return fail(DS_INVALID_ARGUMENT, "The text and the result must be given.");
+    }
+    return guard([&]() {
+        // malformed texts are rejected without exceptions
+        Expected<PExpression> expr = tryParse(std::string(text, length));
+        return expr ? wrap(expr.getValue(), result) : fail(DS_PARSING_ERROR, expr.getFailure().message.c_str());
+    });
+}
+
+ds_status ds_check_syntax(const char *text, size_t length, size_t *position) {
+    if (text == nullptr) {
+        return fail(DS_INVALID_ARGUMENT, "The text must be given.");
+    }
+    return guard([&]() {
+        SyntaxCheck result = checkSyntax(std::string(text, length));
+        if (position != nullptr) {
+            *position = result.isValid ? 0 : result.position;
+        }
+        return result.isValid ? DS_OK : fail(DS_PARSING_ERROR, result.reason);
+    });
+}
+
+ds_status ds_differentiate(const ds_expression *expr, const char *variable, ds_expression **result) {
+    if (expr == nullptr || variable == nullptr || result == nullptr) {
+        return fail(DS_INVALID_ARGUMENT, "The expression, the variable and the result must be given.");
+    }
+    return budgeted([&]() {
+        return wrap(differentiate(expr->expr, variable), result);
+    });
+}
+
+ds_status ds_optimize(const ds_expression *expr, unsigned int flags, ds_expression **result) {
+    if (expr == nullptr || result == nullptr || (flags & ~DS_OPTIMIZE_EGRAPH) != 0) {
+        return fail(DS_INVALID_ARGUMENT, "The expression and the result must be given, the flags must be known.");
+    }
+    return budgeted([&]() {
+        return wrap((flags & DS_OPTIMIZE_EGRAPH) != 0 ? optimizeEGraph(expr->expr) : optimize(expr->expr), result);
+    });
+}
+
+ds_status ds_evaluate(const ds_expression *expr, const char *const *names, const double *values, size_t count,
+        double *result) {
+    if (expr == nullptr || result == nullptr || (count > 0 && (names == nullptr || values == nullptr))) {
+        return fail(DS_INVALID_ARGUMENT, "The expression, the result and the values of variables must be given.");
+    }
+    return guard([&]() {
+        SymbolValues symbolValues;
+        for (size_t i = 0; i < count; i++) {
+            // the names unknown to the table do not occur in the expression, they are not interned
+            SymbolId symbol = SymbolTable::global().find(names[i]);
+            if (symbol != SymbolTable::none) {
+                symbolValues.set(symbol, values[i]);
+            }
+        }
+        *result = evaluate(*expr->expr, symbolValues);
+        return DS_OK;
+    });
+}
+
+ds_status ds_print(const ds_expression *expr, int precision, char *buffer, size_t size, size_t *required) {
+    if (expr == nullptr || (buffer == nullptr && size > 0) || precision < 1 || precision > maxNumberPrecision) {
+        return fail(DS_INVALID_ARGUMENT, "The expression and the buffer must be given, the precision must be 1 to 17.");
+    }
+    return guard([&]() {
+        // written directly into the buffer, cut if it is too small
+        size_t length = print(buffer, size, expr->expr, precision);
+        if (required != nullptr) {
+            *required = length + 1;
+        }
+        return length < size ? DS_OK : fail(DS_BUFFER_TOO_SMALL, "The buffer is too small.");
+    });
+}
+
+ds_status ds_serialize(const ds_expression *expr, char *buffer, size_t size, size_t *required) {
+    if (expr == nullptr || (buffer == nullptr && size > 0)) {
+        return fail(DS_INVALID_ARGUMENT, "The expression and the buffer must be given.");
+    }
+    return guard([&]() {
+        return copy(serialize(*expr->expr), buffer, size, required);
+    });
+}
+
+ds_status ds_deserialize(const char *data, size_t size, ds_expression **result) {
+    if ((data == nullptr && size > 0) || result == nullptr) {
+        return fail(DS_INVALID_ARGUMENT, "The data and the result must be given.");
+    }
+    return guard([&]() {
+        return wrap(deserialize(data, size), result);
+    });
+}
+
+void ds_release(ds_expression *expr) {
+    delete expr;
+}
@@ -0,0 +1,137 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file DerivativeSolverAPI.h
+ *
+ * C interface of the derivativesolver library for in-process use.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#ifndef DERIVATIVESOLVERAPI_H
+#define DERIVATIVESOLVERAPI_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Handle of an immutable expression. Handles are created by ds_parse(),
+ * ds_differentiate(), ds_optimize() and ds_deserialize() and must be released
+ * by ds_release(). Several threads can use the same handle at once, unless the
+ * library is built with the non-atomic reference counting (INTRUSIVE_SPOINTER).
+ */
+typedef struct ds_expression ds_expression;
+
+typedef enum {
+    DS_OK = 0,
+    /** The text or the serialized data is not a valid expression. */
+    DS_PARSING_ERROR = 1,
+    /** The expression can not be processed, e.g. division by zero. */
+    DS_TRAVERSE_ERROR = 2,
+    /** The result does not fit into the buffer, see the required size. */
+    DS_BUFFER_TOO_SMALL = 3,
+    /** A null pointer or an unknown flag. */
+    DS_INVALID_ARGUMENT = 4,
+    DS_OUT_OF_MEMORY = 5,
+    /** A limit set by ds_set_limits() is exceeded, no result is created. */
+    DS_BUDGET_EXCEEDED = 6,
+    /** An unexpected error of the library, see ds_last_error(). */
+    DS_INTERNAL_ERROR = 7
+} ds_status;
+
+/** Flags of ds_optimize(). */
+#define DS_OPTIMIZE_EGRAPH 1u
+
+/**
+ * @return The message of the last error of the calling thread, empty string if
+ * the last call succeeded. Valid until the next call by the thread.
+ */
+const char *ds_last_error(void);
+
+/**
+ * Limit the work of each following ds_differentiate() and ds_optimize() call
+ * of the calling thread, 0 stands for no limit (the default).
+ *
+ * @param max_nodes Number of created nodes.
+ * @param max_passes Number of passes of the optimizer.
+ * @param max_milliseconds Wall time of the call.
+ */
+void ds_set_limits(size_t max_nodes, unsigned int max_passes, unsigned int max_milliseconds);
+
+/**
+ * Parse the text of length bytes, the text does not need to be terminated by
+ * zero.
+ *
+ * The names of variables are kept by the process while expressions contain
+ * them, up to SymbolTable::defaultCapacity bytes. Beyond it, the names of 
+ * released expressions are evicted. Only if the names of expressions which are
+ * not released exhaust it, texts with new names fail with DS_PARSING_ERROR.
+ */
+ds_status ds_parse(const char *text, size_t length, ds_expression **result);
+
+/**
+ * Check whether ds_parse() accepts the text, without building the tree. Both
+ * reject more than maxNestingDepth (1000) levels of parentheses.
+ *
+ * @param position Offset of the first error, if any. Can be NULL.
+ * @return DS_OK or DS_PARSING_ERROR, the reason is given by ds_last_error().
+ */
+ds_status ds_check_syntax(const char *text, size_t length, size_t *position);
+
+/**
+ * The derivative by the variable (zero terminated), not simplified.
+ */
+ds_status ds_differentiate(const ds_expression *expr, const char *variable, ds_expression **result);
+
+/**
+ * Simplify the expression by the Optimizer or, with DS_OPTIMIZE_EGRAPH, by the
+ * equality saturation.
+ */
+ds_status ds_optimize(const ds_expression *expr, unsigned int flags, ds_expression **result);
+
+/**
+ * Calculate the value of the expression, count variables are given by the
+ * arrays of names and values. Variables without values are NaN.
+ */
+ds_status ds_evaluate(const ds_expression *expr, const char *const *names, const double *values, size_t count,
+        double *result);
+
+/**
+ * Write the text of the expression into the buffer, terminated by zero.
+ *
+ * @param precision Number of significant digits of constants (1 to 17).
+ * @param required Length of the text with the terminating zero, also set if
+ * the buffer is too small. Can be NULL.
+ */
+ds_status ds_print(const ds_expression *expr, int precision, char *buffer, size_t size, size_t *required);
+
+/**
+ * Write the compact binary form of the expression into the buffer (see
+ * Serialization.h).
+ *
+ * @param required Size of the data, also set if the buffer is too small. Can
+ * be NULL.
+ */
+ds_status ds_serialize(const ds_expression *expr, char *buffer, size_t size, size_t *required);
+
+/**
+ * Restore the expression written by ds_serialize().
+ */
+ds_status ds_deserialize(const char *data, size_t size, ds_expression **result);
+
+/**
+ * Release the handle, NULL is ignored.
+ */
+void ds_release(ds_expression *expr);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* DERIVATIVESOLVERAPI_H */
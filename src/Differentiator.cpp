@@ -12,225 +12,288 @@
  */
 
 #include <ExpressionFactory.h>
+#include <ResourceBudget.h>
 #include "ExceptionThrower.h"
 #include "Differentiator.h"
+#include "ParallelTraversal.tpp"
 
-Differentiator::Differentiator(string var) : variable(var) {
+#include <vector>
+
+Differentiator::Differentiator(string var) : variable(SymbolTable::global().find(var)) {
 }
 
-void Differentiator::visit(const PConstConstant ) throw (TraverseException) {
-    this->setLastVisitResult(createConstant(0));
+PExpression Differentiator::postVisit(const Constant &) throw (TraverseException) {
+    return createConstant(0);
 }
 
-void Differentiator::visit(const PConstVariable expr) throw (TraverseException) {
-    if (expr->name.empty()) {
+PExpression Differentiator::postVisit(const Variable &expr) throw (TraverseException) {
+    if (expr.symbol == SymbolTable::emptySymbol) {
         // inprobable situation
         THROW(TraverseException, "No variable name is given.", "N.A");
     }
     
-    if (expr->name == this->variable) {
-        this->setLastVisitResult(createConstant(1.0));
-        return;
+    if (expr.symbol == this->variable) {
+        return createConstant(1.0);
     }
-    this->setLastVisitResult(createConstant(0.0));
+    return createConstant(0.0);
 }
 
-void Differentiator::visit(const PConstSum expr) throw (TraverseException) {
-    if (!expr->isComplete()) {
-        THROW(TraverseException, "Expression is not consistent (Addition).", "LArg: " + to_string(expr->lArg) + "RArg:" + to_string(expr->rArg));
+PExpression Differentiator::postVisit(const Sum &expr, PExpression &lArg, PExpression &rArg) throw (TraverseException) {
+    if (!expr.isComplete()) {
+        THROW(TraverseException, "Expression is not consistent (Addition).", "LArg: " + to_string(expr.lArg) + "RArg:" + to_string(expr.rArg));
     }
 
-    expr->lArg->traverse(*this);
-    PExpression lArg = this->getLastVisitResult();
-    expr->rArg->traverse(*this);
-    PExpression rArg = this->getLastVisitResult();
-
-    this->setLastVisitResult(createSum(lArg, rArg));
+    return createSum(lArg, rArg);
 }
 
-void Differentiator::visit(const PConstSub expr) throw (TraverseException) {
-    if (!expr->isComplete()) {
-        THROW(TraverseException, "Expression is not consistent (Subtraction).", "LArg: " + to_string(expr->lArg) + "RArg:" + to_string(expr->rArg));
+PExpression Differentiator::postVisit(const Sub &expr, PExpression &lArg, PExpression &rArg) throw (TraverseException) {
+    if (!expr.isComplete()) {
+        THROW(TraverseException, "Expression is not consistent (Subtraction).", "LArg: " + to_string(expr.lArg) + "RArg:" + to_string(expr.rArg));
     }
-    
-    expr->lArg->traverse(*this);
-    PExpression lArg = this->getLastVisitResult();
-    expr->rArg->traverse(*this);
-    PExpression rArg = this->getLastVisitResult();
 
-    this->setLastVisitResult(createSub(lArg, rArg));
+    return createSub(lArg, rArg);
 }
 
-void Differentiator::visit(const PConstDiv expr) throw (TraverseException) {
-    if (!expr->isComplete()) {
-        THROW(TraverseException, "Expression is not consistent (Division).", "LArg: " + to_string(expr->lArg) + "RArg:" + to_string(expr->rArg));
+PExpression Differentiator::postVisit(const Div &expr, PExpression &lArg, PExpression &rArg) throw (TraverseException) {
+    if (!expr.isComplete()) {
+        THROW(TraverseException, "Expression is not consistent (Division).", "LArg: " + to_string(expr.lArg) + "RArg:" + to_string(expr.rArg));
     }
     
     // Quotient rule
 
-    expr->lArg->traverse(*this);
-    PMult difDividendMLeft=createMult(this->getLastVisitResult(), expr->rArg);
-    
-    expr->rArg->traverse(*this);
-    PMult difDividendMRight=createMult(expr->lArg, this->getLastVisitResult());
+    PMult difDividendMLeft=createMult(lArg, expr.rArg);
+    PMult difDividendMRight=createMult(expr.lArg, rArg);
     
     PSub difDividend=createSub(difDividendMLeft, difDividendMRight);
-    PPow difDivisor=createPow(expr->rArg, createConstant(2.0));
+    PPow difDivisor=createPow(expr.rArg, createConstant(2.0));
     
-    this->setLastVisitResult(createDiv(difDividend, difDivisor));
+    return createDiv(difDividend, difDivisor);
 }
 
-void Differentiator::visit(const PConstMult expr) throw (TraverseException) {
-    if (!expr->isComplete()) {
-        THROW(TraverseException, "Expression is not consistent (Multiplication).", "LArg: " + to_string(expr->lArg) + "RArg:" + to_string(expr->rArg));
+PExpression Differentiator::postVisit(const Mult &expr, PExpression &lArg, PExpression &rArg) throw (TraverseException) {
+    if (!expr.isComplete()) {
+        THROW(TraverseException, "Expression is not consistent (Multiplication).", "LArg: " + to_string(expr.lArg) + "RArg:" + to_string(expr.rArg));
     }
     
     // f'g + fg'
     
-    expr->lArg->traverse(*this);
-    PMult leftSumTerm = createMult(this->getLastVisitResult(), expr->rArg);
-
-    expr->rArg->traverse(*this);
-    PMult rightSumTerm = createMult(expr->lArg, this->getLastVisitResult());
+    PMult leftSumTerm = createMult(lArg, expr.rArg);
+    PMult rightSumTerm = createMult(expr.lArg, rArg);
     
-    this->setLastVisitResult(createSum(leftSumTerm, rightSumTerm));
+    return createSum(leftSumTerm, rightSumTerm);
 }
 
-void Differentiator::visit(const PConstPow expr) throw (TraverseException) {
-    if (!expr->isComplete()) {
-        THROW(TraverseException, "Expression is not consistent (Exponentation).", "LArg: " + to_string(expr->lArg) + "RArg:" + to_string(expr->rArg));
+PExpression Differentiator::postVisit(const Pow &expr, PExpression &lArg, PExpression &rArg) throw (TraverseException) {
+    if (!expr.isComplete()) {
+        THROW(TraverseException, "Expression is not consistent (Exponentation).", "LArg: " + to_string(expr.lArg) + "RArg:" + to_string(expr.rArg));
     }
     
     // applying generalized power rule
     // in form (f^g)' = (f^g)*(f'g/f + g'ln(f))
     
     // (f^g)
-    PPow leftMultplier=createPow(expr->lArg, expr->rArg);
+    PPow leftMultplier=createPow(expr.lArg, expr.rArg);
     
     // (f'g/f + g'ln(f))
     PSum rightMultplier=createSum();
     
     // f'g/f 
-    expr->lArg->traverse(*this);
-    rightMultplier->lArg = createMult(this->getLastVisitResult(), createDiv(expr->rArg, expr->lArg));
+    rightMultplier->lArg = createMult(lArg, createDiv(expr.rArg, expr.lArg));
     // g'ln(f)
-    expr->rArg->traverse(*this);
-    rightMultplier->rArg = createMult(this->getLastVisitResult(), createLn(expr->lArg));
+    rightMultplier->rArg = createMult(rArg, createLn(expr.lArg));
     
-    this->setLastVisitResult(createMult(leftMultplier, rightMultplier));
+    return createMult(leftMultplier, rightMultplier);
 }
 
-void Differentiator::visit(const PConstSin expr) throw (TraverseException) {
-    if (!expr->isComplete()) {
-        THROW(TraverseException, "Expression is not consistent (Sine).", "Arg: " + to_string(expr->arg));
+PExpression Differentiator::postVisit(const Sin &expr, PExpression &arg) throw (TraverseException) {
+    if (!expr.isComplete()) {
+        THROW(TraverseException, "Expression is not consistent (Sine).", "Arg: " + to_string(expr.arg));
     }
     
     // the chain rule can be applied here
     // f(g(x))' = g' * f'(g)
     
-    expr->arg->traverse(*this);
-    this->setLastVisitResult(createMult(this->getLastVisitResult(), createCos(expr->arg)));
+    return createMult(arg, createCos(expr.arg));
 }
 
-void Differentiator::visit(const PConstCos expr) throw (TraverseException) {
-    if (!expr->isComplete()) {
-        THROW(TraverseException, "Expression is not consistent (Cosine).", "Arg: " + to_string(expr->arg));
+PExpression Differentiator::postVisit(const Cos &expr, PExpression &arg) throw (TraverseException) {
+    if (!expr.isComplete()) {
+        THROW(TraverseException, "Expression is not consistent (Cosine).", "Arg: " + to_string(expr.arg));
     }
 
     // the chain rule is also applied here
 
-    expr->arg->traverse(*this);
-    this->setLastVisitResult(createMult(
-            this->getLastVisitResult(),
-            createMult(createConstant(-1.0), createSin(expr->arg))
-            )
+    return createMult(
+            arg,
+            createMult(createConstant(-1.0), createSin(expr.arg))
             );
 }
 
-void Differentiator::visit(const PConstTan expr) throw (TraverseException) {
-    if (!expr->isComplete()) {
-        THROW(TraverseException, "Expression is not consistent (Tangent).", "Arg: " + to_string(expr->arg));
+PExpression Differentiator::postVisit(const Tan &expr, PExpression &arg) throw (TraverseException) {
+    if (!expr.isComplete()) {
+        THROW(TraverseException, "Expression is not consistent (Tangent).", "Arg: " + to_string(expr.arg));
     }
 
     // the chain rule is also applied here
 
     // tan'(x) = 1 + (tan(x))^2
-    expr->arg->traverse(*this);
-    this->setLastVisitResult(createMult(
-            this->getLastVisitResult(),
+    return createMult(
+            arg,
             createSum(
             createConstant(1.0),
-            createPow(createTan(expr->arg), createConstant(2.0))
-            )
+            createPow(createTan(expr.arg), createConstant(2.0))
             )
             );
 }
 
-void Differentiator::visit(const PConstCtan expr) throw (TraverseException) {
-    if (!expr->isComplete()) {
-        THROW(TraverseException, "Expression is not consistent (Cotangent).", "Arg: " + to_string(expr->arg));
+PExpression Differentiator::postVisit(const Ctan &expr, PExpression &arg) throw (TraverseException) {
+    if (!expr.isComplete()) {
+        THROW(TraverseException, "Expression is not consistent (Cotangent).", "Arg: " + to_string(expr.arg));
     }
 
     // the chain rule is also applied here
 
     // ctan'(x) = -(1 + (ctan(x))^2)
-    expr->arg->traverse(*this);
-    this->setLastVisitResult(createMult(
-            this->getLastVisitResult(),
+    return createMult(
+            arg,
             createMult(createConstant(-1.0),
             createSum(
             createConstant(1.0),
-            createPow(createCtan(expr->arg), createConstant(2.0))
-            )
+            createPow(createCtan(expr.arg), createConstant(2.0))
             )
             )
             );
 }
 
-void Differentiator::visit(const PConstLn expr) throw (TraverseException) {
-    if (!expr->isComplete()) {
-        THROW(TraverseException, "Expression is not consistent (Logarithm).", "Arg: " + to_string(expr->arg));
+PExpression Differentiator::postVisit(const Ln &expr, PExpression &arg) throw (TraverseException) {
+    if (!expr.isComplete()) {
+        THROW(TraverseException, "Expression is not consistent (Logarithm).", "Arg: " + to_string(expr.arg));
     }
 
     // the chain rule is also applied here
     
-    expr->arg->traverse(*this);
-    this->setLastVisitResult(createMult(
-            this->getLastVisitResult(),
-            createDiv(createConstant(1.0), expr->arg)
-            )
+    return createMult(
+            arg,
+            createDiv(createConstant(1.0), expr.arg)
             );
 }
 
-void Differentiator::visit(const PConstExp expr) throw (TraverseException) {
-        if (!expr->isComplete()) {
-        THROW(TraverseException, "Expression is not consistent (Exponential function).", "Arg: " + to_string(expr->arg));
+PExpression Differentiator::postVisit(const Exp &expr, PExpression &arg) throw (TraverseException) {
+    if (!expr.isComplete()) {
+        THROW(TraverseException, "Expression is not consistent (Exponential function).", "Arg: " + to_string(expr.arg));
     }
 
     // the chain rule is also applied here
 
-    expr->arg->traverse(*this);
-    this->setLastVisitResult(createMult(
-            this->getLastVisitResult(),
-            createExp(expr->arg)
-            )
+    return createMult(
+            arg,
+            createExp(expr.arg)
             );
 }
 
-PExpression Differentiator::getLastVisitResult() const {
-    return this->result;
+PExpression differentiate(PExpression expr, string var, ThreadPool *pool, size_t grainSize) throw(TraverseException){
+    if(expr==nullptr){
+        THROW(TraverseException, "Not possible to differentiate the NULL expression.", "N.A.");
+    }
+    
+    // the derivative is usually larger, a request which is already out of time is not started
+    checkBudget();
+    Differentiator differentiator = Differentiator(var);
+    if(pool==nullptr){
+        return differentiator.traversePostOrder(*expr);
+    }
+    return traverseParallel<PExpression, Differentiator>(*expr, *pool, grainSize, [&var]() {
+        return std::unique_ptr<Differentiator>(new Differentiator(var));
+    }, differentiator);
 }
 
-void Differentiator::setLastVisitResult(PExpression result) {
-    this->result = result;
+Expected<PExpression> tryDifferentiate(PExpression expr, string var, ThreadPool *pool, size_t grainSize){
+    if(expr==nullptr){
+        return Failure{Failure::Traverse, "Not possible to differentiate the NULL expression. Context: N.A."};
+    }
+    try{
+        return differentiate(expr, var, pool, grainSize);
+    }catch(BudgetExceededException ex){
+        return Failure{Failure::Budget, ex.what()};
+    }catch(TraverseException ex){
+        return Failure{Failure::Traverse, ex.what()};
+    }
 }
 
-PExpression differentiate(PExpression expr, string var) throw(TraverseException){
-    if(expr==nullptr){
-        THROW(TraverseException, "Not possible to differentiate the NULL expression.", "N.A.");
+FlatExpression differentiate(const FlatExpression &expr, const string &var) throw(TraverseException){
+    typedef FlatExpression::Index Index;
+    if(expr.size()==0){
+        THROW(TraverseException, "Not possible to differentiate the empty expression.", "N.A.");
     }
     
-    Differentiator differentiator = Differentiator(var);
-    expr->traverse(differentiator);
-    return differentiator.getLastVisitResult();
-}
\ No newline at end of file
+    const SymbolId symbol=SymbolTable::global().find(var);
+    // the derivative refers to nodes of the expression, so it is appended to its copy
+    FlatExpression result = expr;
+    std::vector<Index> derivatives(expr.size());
+    for(Index node=0; node<expr.size(); node++){
+        Index f=expr.lArg(node);
+        Index g=expr.rArg(node);
+        Index df=(expr.type(node)==EConstant || expr.type(node)==EVariable) ? FlatExpression::none : derivatives[f];
+        Index dg=(g==FlatExpression::none) ? FlatExpression::none : derivatives[g];
+        
+        // the same rules as of Differentiator
+        switch(expr.type(node)){
+            case EConstant:
+                derivatives[node]=result.addConstant(0.0);
+                break;
+            case EVariable:
+                derivatives[node]=result.addConstant(expr.symbol(node)==symbol ? 1.0 : 0.0);
+                break;
+            case ESum:
+                derivatives[node]=result.addNode(ESum, df, dg);
+                break;
+            case ESub:
+                derivatives[node]=result.addNode(ESub, df, dg);
+                break;
+            case EDiv:
+                // (f'g - fg')/g^2
+                derivatives[node]=result.addNode(EDiv, 
+                        result.addNode(ESub, result.addNode(EMult, df, g), result.addNode(EMult, f, dg)),
+                        result.addNode(EPow, g, result.addConstant(2.0)));
+                break;
+            case EMult:
+                // f'g + fg'
+                derivatives[node]=result.addNode(ESum, result.addNode(EMult, df, g), result.addNode(EMult, f, dg));
+                break;
+            case EPow:
+                // (f^g)*(f'g/f + g'ln(f))
+                derivatives[node]=result.addNode(EMult, 
+                        result.addNode(EPow, f, g),
+                        result.addNode(ESum, 
+                            result.addNode(EMult, df, result.addNode(EDiv, g, f)),
+                            result.addNode(EMult, dg, result.addNode(ELn, f))));
+                break;
+            case ESin:
+                derivatives[node]=result.addNode(EMult, df, result.addNode(ECos, f));
+                break;
+            case ECos:
+                derivatives[node]=result.addNode(EMult, df, 
+                        result.addNode(EMult, result.addConstant(-1.0), result.addNode(ESin, f)));
+                break;
+            case ETan:
+                derivatives[node]=result.addNode(EMult, df, 
+                        result.addNode(ESum, result.addConstant(1.0), 
+                            result.addNode(EPow, result.addNode(ETan, f), result.addConstant(2.0))));
+                break;
+            case ECtan:
+                derivatives[node]=result.addNode(EMult, df, 
+                        result.addNode(EMult, result.addConstant(-1.0),
+                            result.addNode(ESum, result.addConstant(1.0), 
+                                result.addNode(EPow, result.addNode(ECtan, f), result.addConstant(2.0)))));
+                break;
+            case ELn:
+                derivatives[node]=result.addNode(EMult, df, result.addNode(EDiv, result.addConstant(1.0), f));
+                break;
+            case EExp:
+                derivatives[node]=result.addNode(EMult, df, result.addNode(EExp, f));
+                break;
+        }
+    }
+    
+    return result.compact(derivatives[expr.root()]);
+}
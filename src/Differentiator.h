@@ -14,36 +14,69 @@
 #ifndef SRC_DIFFERENTIATOR_H_
 #define SRC_DIFFERENTIATOR_H_
 
-#include <Visitor.h>
+#include <PostOrderVisitor.h>
+#include <FlatExpression.h>
+#include <Expected.h>
 #include "TraverseException.h"
+#include "ThreadPool.h"
 
 using namespace std;
 
-class Differentiator : public Visitor {
+class Differentiator : public PostOrderVisitor<PExpression> {
 private:
-    PExpression result;
-    string variable;
+    SymbolId variable; // SymbolTable::none if no expression contains it
+    
+protected:
+    PExpression postVisit(const Constant &expr) throw (TraverseException) final;
+    PExpression postVisit(const Variable &expr) throw (TraverseException) final;
+    PExpression postVisit(const Sum &expr, PExpression &lArg, PExpression &rArg) throw (TraverseException) final;
+    PExpression postVisit(const Sub &expr, PExpression &lArg, PExpression &rArg) throw (TraverseException) final;
+    PExpression postVisit(const Mult &expr, PExpression &lArg, PExpression &rArg) throw (TraverseException) final;
+    PExpression postVisit(const Div &expr, PExpression &lArg, PExpression &rArg) throw (TraverseException) final;
+    PExpression postVisit(const Pow &expr, PExpression &lArg, PExpression &rArg) throw (TraverseException) final;
+    PExpression postVisit(const Sin &expr, PExpression &arg) throw (TraverseException) final;
+    PExpression postVisit(const Cos &expr, PExpression &arg) throw (TraverseException) final;
+    PExpression postVisit(const Tan &expr, PExpression &arg) throw (TraverseException) final;
+    PExpression postVisit(const Ctan &expr, PExpression &arg) throw (TraverseException) final;
+    PExpression postVisit(const Ln &expr, PExpression &arg) throw (TraverseException) final;
+    PExpression postVisit(const Exp &expr, PExpression &arg) throw (TraverseException) final;
+
 public:
     Differentiator(string var);
-
-    void visit(const PConstConstant expr) throw (TraverseException) final;
-    void visit(const PConstVariable expr) throw (TraverseException) final;
-    void visit(const PConstSum expr) throw (TraverseException) final;
-    void visit(const PConstSub expr) throw (TraverseException) final;
-    void visit(const PConstMult expr) throw (TraverseException) final;
-    void visit(const PConstDiv expr) throw (TraverseException) final;
-    void visit(const PConstPow expr) throw (TraverseException) final;
-    void visit(const PConstSin expr) throw (TraverseException) final;
-    void visit(const PConstCos expr) throw (TraverseException) final;
-    void visit(const PConstTan expr) throw (TraverseException) final;
-    void visit(const PConstCtan expr) throw (TraverseException) final;
-    void visit(const PConstLn expr) throw (TraverseException) final;
-    void visit(const PConstExp expr) throw (TraverseException) final;
-
-    void setLastVisitResult(const PExpression result);
-    PExpression getLastVisitResult() const;
 };
 
 
-PExpression differentiate(PExpression expr, string var) throw(TraverseException);
+/**
+ * Differentiate the expression.
+ *
+ * The created nodes are charged to the ResourceBudget of the calling thread,
+ * if it has one (see BudgetScope).
+ *
+ * @param expr The expression.
+ * @param var The variable.
+ * @param pool If given, subtrees of large expressions are differentiated in
+ * parallel (see traverseParallel()), the result is the same.
+ * @param grainSize Expressions of fewer nodes are differentiated by one thread.
+ * @return The derivative.
+ */
+PExpression differentiate(PExpression expr, string var, ThreadPool *pool = nullptr, size_t grainSize = defaultGrainSize) throw(TraverseException);
+
+/**
+ * Like differentiate(), errors are returned as Failure::Traverse instead of 
+ * thrown, an exhausted ResourceBudget as Failure::Budget.
+ */
+Expected<PExpression> tryDifferentiate(PExpression expr, string var, ThreadPool *pool = nullptr, size_t grainSize = defaultGrainSize);
+
+/**
+ * Differentiate the flat expression by the same rules as Differentiator, in 
+ * one pass over its nodes.
+ *
+ * The derivative shares the subexpressions of the original expression.
+ *
+ * @param expr The expression.
+ * @param var The variable.
+ * @return The derivative.
+ */
+FlatExpression differentiate(const FlatExpression &expr, const string &var) throw(TraverseException);
+
 #endif /* SRC_DIFFERENTIATOR_H_ */
@@ -0,0 +1,288 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file EGraph.cpp
+ *
+ * Implementation of the EGraph data structure.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#include "EGraph.h"
+
+#include <limits>
+#include <algorithm>
+#include <functional>
+#include <utility>
+
+#include <ExpressionFactory.h>
+#include "ExceptionThrower.h"
+
+bool ENode::operator==(const ENode &other) const {
+    return this->type == other.type &&
+            this->value == other.value &&
+            this->symbol == other.symbol &&
+            this->args == other.args;
+}
+
+size_t ENodeHash::operator()(const ENode &node) const {
+    size_t h = std::hash<int>()(node.type);
+    h = h * 31 + std::hash<double>()(node.value);
+    h = h * 31 + node.symbol;
+    for (EClassId arg : node.args) {
+        h = h * 31 + arg;
+    }
+    return h;
+}
+
+EGraph::EGraph() : nodeCount(0) {
+}
+
+ENode EGraph::canonicalize(ENode node) const {
+    for (EClassId &arg : node.args) {
+        arg = this->find(arg);
+    }
+    return node;
+}
+
+EClassId EGraph::add(const PExpression expr) throw (TraverseException) {
+    if (expr == nullptr) {
+        THROW(TraverseException, "Expression is not consistent.", to_string(expr));
+    }
+
+    // post-order without recursion, the classes of added arguments are kept in results
+    std::vector<std::pair<const Expression *, bool>> pending = {{expr.get(), false}};
+    std::vector<EClassId> results;
+    while (!pending.empty()) {
+        const Expression *current = pending.back().first;
+        bool argumentsAdded = pending.back().second;
+        pending.pop_back();
+
+        const Expression *args[2];
+        unsigned int argCount = argumentsOf(*current, args);
+        if (!argumentsAdded) {
+            if (!current->isComplete()) {
+                THROW(TraverseException, "Expression is not consistent.", to_string(expr));
+            }
+            pending.push_back({current, true});
+            for (unsigned int i = argCount; i > 0; i--) {
+                pending.push_back({args[i - 1], false});
+            }
+            continue;
+        }
+
+        ENode node;
+        node.type = current->getType();
+        node.value = 0.0;
+        node.symbol = SymbolTable::none;
+        if (node.type == EConstant) {
+            node.value = static_cast<const Constant &> (*current).value;
+        } else if (node.type == EVariable) {
+            node.symbol = static_cast<const Variable &> (*current).symbol;
+        }
+        node.args.assign(results.end() - argCount, results.end());
+        results.resize(results.size() - argCount);
+        results.push_back(this->add(node));
+    }
+    return results.back();
+}
+
+EClassId EGraph::add(ENode node) {
+    node = this->canonicalize(node);
+
+    auto found = this->memo.find(node);
+    if (found != this->memo.end()) {
+        return this->find(found->second);
+    }
+
+    EClassId id = static_cast<EClassId> (this->parents.size());
+    this->parents.push_back(id);
+    this->classes.push_back({node});
+    this->memo.emplace(node, id);
+    this->nodeCount++;
+    return id;
+}
+
+EClassId EGraph::find(EClassId id) const {
+    while (this->parents[id] != id) {
+        id = this->parents[id];
+    }
+    return id;
+}
+
+bool EGraph::merge(EClassId a, EClassId b) {
+    a = this->find(a);
+    b = this->find(b);
+    if (a == b) {
+        return false;
+    }
+
+    // keep the smaller id as a root to make the result independent of hash ordering
+    if (b < a) {
+        std::swap(a, b);
+    }
+    this->parents[b] = a;
+    std::vector<ENode> &target = this->classes[a];
+    target.insert(target.end(), this->classes[b].begin(), this->classes[b].end());
+    this->classes[b].clear();
+    return true;
+}
+
+void EGraph::rebuild() {
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        this->memo.clear();
+        this->nodeCount = 0;
+
+        for (EClassId id = 0; id < this->classes.size(); id++) {
+            if (this->find(id) != id) {
+                continue;
+            }
+
+            std::vector<ENode> canonical;
+            for (const ENode &node : this->classes[id]) {
+                ENode canonicalNode = this->canonicalize(node);
+                if (std::find(canonical.begin(), canonical.end(), canonicalNode) == canonical.end()) {
+                    canonical.push_back(canonicalNode);
+                }
+            }
+            this->classes[id] = canonical;
+            this->nodeCount += canonical.size();
+        }
+
+        // congruence closure: equal nodes in different classes make these classes equal
+        std::vector<std::pair<EClassId, EClassId>> congruent;
+        for (EClassId id = 0; id < this->classes.size(); id++) {
+            for (const ENode &node : this->classes[id]) {
+                auto inserted = this->memo.emplace(node, id);
+                if (!inserted.second) {
+                    congruent.push_back({inserted.first->second, id});
+                }
+            }
+        }
+        for (auto &pair : congruent) {
+            changed = this->merge(pair.first, pair.second) || changed;
+        }
+    }
+}
+
+size_t EGraph::size() const {
+    return this->nodeCount;
+}
+
+std::vector<EClassId> EGraph::classIds() const {
+    std::vector<EClassId> ids;
+    for (EClassId id = 0; id < this->classes.size(); id++) {
+        if (this->find(id) == id) {
+            ids.push_back(id);
+        }
+    }
+    return ids;
+}
+
+const std::vector<ENode> &EGraph::nodes(EClassId id) const {
+    return this->classes[this->find(id)];
+}
+
+std::vector<PExpression> EGraph::extractAll() const {
+    const size_t infinity = std::numeric_limits<size_t>::max();
+    std::vector<size_t> costs(this->classes.size(), infinity);
+    std::vector<const ENode *> choices(this->classes.size(), nullptr);
+
+    // the cost of the node is the size of the tree: 1 + sum of costs of arguments.
+    // Iterate until the costs are stable; the number of iterations is bounded
+    // by the depth of the cheapest trees.
+    bool changed = true;
+    while (changed) {
+        changed = false;
+        for (EClassId id = 0; id < this->classes.size(); id++) {
+            for (const ENode &node : this->classes[id]) {
+                size_t cost = 1;
+                for (EClassId arg : node.args) {
+                    size_t argCost = costs[this->find(arg)];
+                    if (argCost == infinity) {
+                        cost = infinity;
+                        break;
+                    }
+                    cost += argCost;
+                }
+                if (cost < costs[id]) {
+                    costs[id] = cost;
+                    choices[id] = &node;
+                    changed = true;
+                }
+            }
+        }
+    }
+
+    // build trees in post-order without recursion, the best trees of the arguments 
+    // are shared between parents
+    std::vector<PExpression> trees(this->classes.size());
+    std::vector<std::pair<EClassId, bool>> pending;
+    for (EClassId root : this->classIds()) {
+        pending.push_back({root, false});
+        while (!pending.empty()) {
+            EClassId id = pending.back().first;
+            bool argumentsBuilt = pending.back().second;
+            pending.pop_back();
+            if (trees[id] != nullptr || choices[id] == nullptr) {
+                continue;
+            }
+
+            if (!argumentsBuilt) {
+                pending.push_back({id, true});
+                for (EClassId arg : choices[id]->args) {
+                    pending.push_back({this->find(arg), false});
+                }
+                continue;
+            }
+
+            std::vector<PExpression> args;
+            for (EClassId arg : choices[id]->args) {
+                args.push_back(trees[this->find(arg)]);
+            }
+            trees[id] = createExpression(*choices[id], args);
+        }
+    }
+    return trees;
+}
+
+PExpression EGraph::extract(EClassId id) const {
+    return this->extractAll()[this->find(id)];
+}
+
+PExpression createExpression(const ENode &node, const std::vector<PExpression> &args) {
+    switch (node.type) {
+        case EConstant:
+            return createConstant(node.value);
+        case EVariable:
+            return createVariable(node.symbol);
+        case ESum:
+            return createSum(args[0], args[1]);
+        case ESub:
+            return createSub(args[0], args[1]);
+        case EMult:
+            return createMult(args[0], args[1]);
+        case EDiv:
+            return createDiv(args[0], args[1]);
+        case EPow:
+            return createPow(args[0], args[1]);
+        case ESin:
+            return createSin(args[0]);
+        case ECos:
+            return createCos(args[0]);
+        case ETan:
+            return createTan(args[0]);
+        case ECtan:
+            return createCtan(args[0]);
+        case ELn:
+            return createLn(args[0]);
+        case EExp:
+            return createExp(args[0]);
+    }
+    return nullptr;
+}
@@ -0,0 +1,147 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file EGraph.h
+ *
+ * Definition of the EGraph data structure.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#ifndef EGRAPH_H
+#define EGRAPH_H
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include <Expression.h>
+#include <SymbolTable.h>
+
+/**
+ * Identifier of the class of equivalent expressions in the EGraph.
+ */
+typedef unsigned int EClassId;
+
+/**
+ * The node of the EGraph.
+ *
+ * Represents one operation (or a terminal) whose arguments are not concrete
+ * expressions but classes of equivalent expressions.
+ */
+struct ENode {
+    ExpressionType type;
+    double value; ///< Value of the constant (only for EConstant).
+    SymbolId symbol; ///< Name of the variable (only for EVariable).
+    std::vector<EClassId> args; ///< Classes of arguments (1 for functions, 2 for operations).
+
+    bool operator==(const ENode &other) const;
+};
+
+/**
+ * Hash function for ENode's, used by hash consing of the EGraph.
+ */
+struct ENodeHash {
+    size_t operator()(const ENode &node) const;
+};
+
+/**
+ * The EGraph (equality graph) is a compact representation of a set of
+ * equivalent expressions.
+ *
+ * Nodes are grouped into classes, all nodes of the same class represent
+ * equal expressions. Arguments of nodes refer to classes, therefore a graph with
+ * N nodes can represent exponentially many different trees. Classes are merged
+ * by rewrite rules (see optimizeEGraph()), the smallest tree can be extracted afterwards.
+ */
+class EGraph {
+private:
+    std::vector<EClassId> parents; // union-find
+    std::vector<std::vector<ENode>> classes; // nodes, only for canonical ids
+    std::unordered_map<ENode, EClassId, ENodeHash> memo; // hash consing
+    size_t nodeCount;
+
+    ENode canonicalize(ENode node) const;
+
+public:
+    EGraph();
+
+    /**
+     * Add the expression tree to the graph.
+     *
+     * @param expr Complete expression.
+     * @return Id of the class representing expr.
+     */
+    EClassId add(const PExpression expr) throw (TraverseException);
+
+    /**
+     * Add a single node to the graph. If equal node already exists its class is returned.
+     *
+     * @param node Node with arguments referring to existing classes.
+     * @return Id of the class containing the node.
+     */
+    EClassId add(ENode node);
+
+    /**
+     * Get canonical id of the class.
+     */
+    EClassId find(EClassId id) const;
+
+    /**
+     * Declare two classes to be equal.
+     *
+     * The graph invariants are restored only after rebuild().
+     *
+     * @return true if classes were different before.
+     */
+    bool merge(EClassId a, EClassId b);
+
+    /**
+     * Restore the congruence invariant: nodes with equal operations and equal
+     * argument classes must belong to the same class.
+     */
+    void rebuild();
+
+    /**
+     * @return Total number of nodes in the graph.
+     */
+    size_t size() const;
+
+    /**
+     * @return Canonical ids of all classes.
+     */
+    std::vector<EClassId> classIds() const;
+
+    /**
+     * @return Nodes of the class.
+     */
+    const std::vector<ENode> &nodes(EClassId id) const;
+
+    /**
+     * Extract the smallest (by number of nodes) tree for every class.
+     *
+     * @return Vector indexed by canonical class id. Entries of non-canonical
+     * ids are nullptr.
+     */
+    std::vector<PExpression> extractAll() const;
+
+    /**
+     * Extract the smallest tree of the class.
+     */
+    PExpression extract(EClassId id) const;
+};
+
+/**
+ * Create the expression for the node using given expressions as arguments.
+ *
+ * @param node Node to be converted.
+ * @param args Expressions for arguments of the node (same order as node.args).
+ * @return New instance of Expression.
+ */
+PExpression createExpression(const ENode &node, const std::vector<PExpression> &args);
+
+#endif /* EGRAPH_H */
+
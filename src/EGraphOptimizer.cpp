@@ -0,0 +1,205 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file EGraphOptimizer.cpp
+ *
+ * Implementation of the simplification by equality saturation.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#include "EGraphOptimizer.h"
+
+#include <vector>
+#include <algorithm>
+
+#include <ExpressionFactory.h>
+#include <ResourceBudget.h>
+
+#include "EGraph.h"
+#include "Optimizer.h"
+#include "ExceptionThrower.h"
+#include "RuleTable.tpp"
+#include "LnOfExpRule.h"
+
+/**
+ * Evaluate the function of a constant.
+ * 
+ * The evaluation (including the checks of domains) is delegated to the Optimizer,
+ * it is cheap for a constant argument.
+ * 
+ * @param T Type of the function expression (Sin, Cos etc).
+ */
+template <typename T>
+void evaluateFunction(PExpression expr, std::vector<PExpression> &equivalents) throw (TraverseException) {
+    if (!isTypeOf<Constant>(SPointerCast<T>(expr)->arg)) {
+        return;
+    }
+    Optimizer optimizer;
+    expr->traverse(optimizer);
+    equivalents.push_back(optimizer.getLastVisitResult());
+}
+
+/**
+ * Find expressions equivalent to the given one by means of OptimizationRule's.
+ *
+ * Div and Sub are rewritten the same way as Optimizer does it: as multiplication
+ * with inverted denominator and summation with negated subtrahend.
+ *
+ * @param expr The expression; its arguments are already simplified forms of argument classes.
+ * @param equivalents [out] Found equivalent expressions.
+ */
+void findEquivalents(PExpression expr, std::vector<PExpression> &equivalents) throw (TraverseException) {
+    switch (expr->getType()) {
+        case ESum:
+            SummationRules::applyAll(SPointerCast<Sum>(expr), equivalents);
+            break;
+        case ESub:
+        {
+            PSub sub = SPointerCast<Sub>(expr);
+            equivalents.push_back(createSum(sub->lArg, negateExpression(sub->rArg)));
+            break;
+        }
+        case EMult:
+            MultiplicationRules::applyAll(SPointerCast<Mult>(expr), equivalents);
+            break;
+        case EDiv:
+        {
+            PDiv div = SPointerCast<Div>(expr);
+            equivalents.push_back(createMult(div->lArg, invertDenominator(div->rArg)));
+            break;
+        }
+        case EPow:
+            ExponentiationRules::applyAll(SPointerCast<Pow>(expr), equivalents);
+            break;
+        case ELn:
+            RuleTable<PLn, LnOfExpRule>::applyAll(SPointerCast<Ln>(expr), equivalents);
+            evaluateFunction<Ln>(expr, equivalents);
+            break;
+        case ESin:
+            evaluateFunction<Sin>(expr, equivalents);
+            break;
+        case ECos:
+            evaluateFunction<Cos>(expr, equivalents);
+            break;
+        case ETan:
+            evaluateFunction<Tan>(expr, equivalents);
+            break;
+        case ECtan:
+            evaluateFunction<Ctan>(expr, equivalents);
+            break;
+        case EExp:
+            evaluateFunction<Exp>(expr, equivalents);
+            break;
+        case EConstant:
+        case EVariable:
+            break;
+    }
+}
+
+/**
+ * Get alternative forms of the class: each node of the class is built with the
+ * smallest trees of its arguments.
+ */
+std::vector<PExpression> alternatives(const EGraph &graph, EClassId id, const std::vector<PExpression> &best, unsigned int limit) {
+    std::vector<PExpression> forms;
+    for (const ENode &node : graph.nodes(id)) {
+        if (forms.size() >= limit) {
+            break;
+        }
+
+        std::vector<PExpression> args;
+        for (EClassId arg : node.args) {
+            args.push_back(best[graph.find(arg)]);
+        }
+        if (std::find(args.begin(), args.end(), nullptr) != args.end()) {
+            // the node is in a cycle, there is no finite tree for it (yet)
+            continue;
+        }
+        forms.push_back(createExpression(node, args));
+    }
+    return forms;
+}
+
+PExpression optimizeEGraph(PExpression expr, const EGraphLimits &limits) throw (TraverseException) {
+    if (expr == nullptr) {
+        THROW(TraverseException, "Not possible to optimize the NULL expressions.", "N.A.");
+    }
+
+    EGraph graph;
+    EClassId root = graph.add(expr);
+    // the greedy result is a candidate of the extraction, hence the result is not
+    // larger than the one of optimize() even if a limit stops the saturation early
+    graph.merge(root, graph.add(optimize(expr)));
+    graph.rebuild();
+
+    for (unsigned int iteration = 0; iteration < limits.maxIterations && graph.size() < limits.maxNodes; iteration++) {
+        chargePass();
+        std::vector<PExpression> best = graph.extractAll();
+
+        // collect the rewrites first, the graph must not be changed while it is matched
+        std::vector<std::pair<EClassId, PExpression>> found;
+        std::vector<std::pair<EClassId, ENode>> commuted;
+        for (EClassId id : graph.classIds()) {
+            for (const ENode &node : graph.nodes(id)) {
+                if (node.type == ESum || node.type == EMult) {
+                    ENode swapped = node;
+                    std::swap(swapped.args[0], swapped.args[1]);
+                    commuted.push_back({id, swapped});
+                }
+
+                if (node.args.empty()) {
+                    continue;
+                }
+
+                // instantiate the node with alternative forms of arguments
+                std::vector<std::vector<PExpression>> forms;
+                for (EClassId arg : node.args) {
+                    forms.push_back(alternatives(graph, arg, best, limits.maxAlternatives));
+                }
+
+                std::vector<PExpression> equivalents;
+                if (node.args.size() == 1) {
+                    for (const PExpression &arg : forms[0]) {
+                        findEquivalents(createExpression(node, {arg}), equivalents);
+                    }
+                } else {
+                    for (const PExpression &lArg : forms[0]) {
+                        for (const PExpression &rArg : forms[1]) {
+                            findEquivalents(createExpression(node, {lArg, rArg}), equivalents);
+                        }
+                    }
+                }
+
+                for (const PExpression &equivalent : equivalents) {
+                    found.push_back({id, equivalent});
+                }
+            }
+        }
+
+        bool changed = false;
+        for (auto &rewritten : commuted) {
+            if (graph.size() >= limits.maxNodes) {
+                break;
+            }
+            changed = graph.merge(rewritten.first, graph.add(rewritten.second)) || changed;
+        }
+        for (auto &rewritten : found) {
+            if (graph.size() >= limits.maxNodes) {
+                break;
+            }
+            changed = graph.merge(rewritten.first, graph.add(rewritten.second)) || changed;
+        }
+        graph.rebuild();
+
+        if (!changed || graph.size() >= limits.maxNodes) {
+            // saturated or out of budget
+            break;
+        }
+    }
+
+    return graph.extract(root);
+}
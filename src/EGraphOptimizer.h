@@ -0,0 +1,49 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file EGraphOptimizer.h
+ *
+ * Definition of the simplification by equality saturation.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#ifndef EGRAPHOPTIMIZER_H
+#define EGRAPHOPTIMIZER_H
+
+#include <Expression.h>
+#include <TraverseException.h>
+
+/**
+ * Limits for the equality saturation. They bound the memory consumption and the
+ * execution time, the best result found so far is extracted once a limit is reached.
+ */
+struct EGraphLimits {
+    size_t maxNodes = 2000; ///< Maximal number of nodes in the EGraph.
+    unsigned int maxIterations = 10; ///< Maximal number of rewriting iterations.
+    unsigned int maxAlternatives = 4; ///< Maximal number of alternative forms of each argument considered by rules.
+};
+
+/**
+ * Simplify the given expression by equality saturation.
+ *
+ * Alternative to optimize(). The greedy Optimizer applies the first matching rule
+ * and keeps only its result, while here all OptimizationRule's are applied as
+ * rewrite rules to an EGraph which preserves every equivalent form found so far.
+ * The graph is seeded with the result of optimize(). Finally the smallest (by 
+ * number of nodes) expression is extracted, so it is never larger than the greedy one.
+ *
+ * Every iteration counts as a pass of the ResourceBudget of the calling thread,
+ * if it has one.
+ *
+ * @param expr Expression to be simplified.
+ * @param limits Limits for the size of EGraph and number of iterations.
+ * @return New instance of the simplified expression.
+ */
+PExpression optimizeEGraph(PExpression expr, const EGraphLimits &limits = EGraphLimits()) throw (TraverseException);
+
+#endif /* EGRAPHOPTIMIZER_H */
+
@@ -15,9 +15,8 @@
 #define	EXCEPTIONTHROWER_H
 
 
-// @TODO delete this, will be given as a compiler flag
-#define DEBUG
-
+// DEBUG is defined by the build (option DEBUG_EXCEPTIONS), without it the 
+// messages are built without the function, the file and the line
 #ifdef DEBUG
 	#define THROW(ex, msg, ctx) throw ex(msg, string(ctx) + "\n Function: " + __func__ + "; \n File: " + __FILE__ + "(" + to_string(__LINE__) + ")")
 #else
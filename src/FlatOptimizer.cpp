@@ -0,0 +1,194 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file FlatOptimizer.cpp
+ *
+ * Implementation of the simplification of flat expressions.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#include "FlatOptimizer.h"
+
+#include <cmath>
+#include <vector>
+#include <unordered_map>
+
+#include "Doubles.h"
+#include "ExceptionThrower.h"
+
+namespace {
+
+typedef FlatExpression::Index Index;
+
+/**
+ * Builds the simplified expression, every distinct node is added once.
+ */
+class FlatBuilder {
+private:
+    typedef FlatExpression::NodeKey NodeKey;
+
+    std::unordered_map<NodeKey, Index, FlatExpression::NodeKeyHash> nodes;
+    std::unordered_map<double, Index> constants;
+    std::unordered_map<SymbolId, Index> variables;
+
+public:
+    FlatExpression result;
+
+    bool isConstant(Index node) const {
+        return this->result.type(node) == EConstant;
+    }
+
+    bool isConstant(Index node, double value) const {
+        return this->isConstant(node) && equal(this->result.value(node), value);
+    }
+
+    Index constant(double value) {
+        auto found = this->constants.find(value);
+        if (found != this->constants.end()) {
+            return found->second;
+        }
+        return this->constants[value] = this->result.addConstant(value);
+    }
+
+    Index variable(SymbolId symbol) {
+        auto found = this->variables.find(symbol);
+        if (found != this->variables.end()) {
+            return found->second;
+        }
+        return this->variables[symbol] = this->result.addVariable(symbol);
+    }
+
+    Index node(ExpressionType type, Index lArg, Index rArg = FlatExpression::none) throw (TraverseException) {
+        NodeKey key = {type, lArg, rArg};
+        auto found = this->nodes.find(key);
+        if (found != this->nodes.end()) {
+            return found->second;
+        }
+        return this->nodes[key] = this->result.addNode(type, lArg, rArg);
+    }
+};
+
+/**
+ * Value of the operation (function) of constants, NaN if the type is unknown.
+ */
+double evaluate(ExpressionType type, double l, double r) {
+    switch (type) {
+        case ESum: return l + r;
+        case ESub: return l - r;
+        case EMult: return l * r;
+        case EDiv: return l / r;
+        case EPow: return std::pow(l, r);
+        case ESin: return std::sin(l);
+        case ECos: return std::cos(l);
+        case ETan: return std::tan(l);
+        case ECtan: return 1.0 / std::tan(l);
+        case ELn: return std::log(l);
+        case EExp: return std::exp(l);
+        default: return NAN;
+    }
+}
+
+/**
+ * Apply the local rules to the node with simplified arguments a and b.
+ */
+Index simplify(FlatBuilder &builder, ExpressionType type, Index a, Index b) throw (TraverseException) {
+    bool isFunction = (b == FlatExpression::none);
+    if (builder.isConstant(a) && (isFunction || builder.isConstant(b))) {
+        double value = evaluate(type, builder.result.value(a), isFunction ? 0.0 : builder.result.value(b));
+        if (std::isfinite(value)) {
+            return builder.constant(value);
+        }
+    }
+
+    switch (type) {
+        case ESum:
+            if (builder.isConstant(a, 0.0)) {
+                return b;
+            }
+            if (builder.isConstant(b, 0.0)) {
+                return a;
+            }
+            if (a == b) {
+                return builder.node(EMult, builder.constant(2.0), a);
+            }
+            break;
+        case ESub:
+            if (builder.isConstant(b, 0.0)) {
+                return a;
+            }
+            if (a == b) {
+                return builder.constant(0.0);
+            }
+            break;
+        case EMult:
+            if (builder.isConstant(a, 0.0) || builder.isConstant(b, 0.0)) {
+                return builder.constant(0.0);
+            }
+            if (builder.isConstant(a, 1.0)) {
+                return b;
+            }
+            if (builder.isConstant(b, 1.0)) {
+                return a;
+            }
+            if (a == b) {
+                return builder.node(EPow, a, builder.constant(2.0));
+            }
+            break;
+        case EDiv:
+            if (builder.isConstant(b, 1.0)) {
+                return a;
+            }
+            if (builder.isConstant(a, 0.0)) {
+                return builder.constant(0.0);
+            }
+            if (a == b) {
+                return builder.constant(1.0);
+            }
+            break;
+        case EPow:
+            if (builder.isConstant(b, 0.0)) {
+                return builder.constant(1.0);
+            }
+            if (builder.isConstant(b, 1.0)) {
+                return a;
+            }
+            break;
+        case ELn:
+            if (builder.result.type(a) == EExp) {
+                return builder.result.lArg(a);
+            }
+            break;
+        default:
+            break;
+    }
+    return builder.node(type, a, b);
+}
+
+}
+
+FlatExpression optimize(const FlatExpression &expr) throw (TraverseException) {
+    if (expr.size() == 0) {
+        THROW(TraverseException, "Not possible to optimize the empty expression.", "N.A.");
+    }
+
+    FlatBuilder builder;
+    std::vector<Index> simplified(expr.size());
+    for (Index node = 0; node < expr.size(); node++) {
+        switch (expr.type(node)) {
+            case EConstant:
+                simplified[node] = builder.constant(expr.value(node));
+                break;
+            case EVariable:
+                simplified[node] = builder.variable(expr.symbol(node));
+                break;
+            default:
+                Index rArg = expr.rArg(node) == FlatExpression::none ? FlatExpression::none : simplified[expr.rArg(node)];
+                simplified[node] = simplify(builder, expr.type(node), simplified[expr.lArg(node)], rArg);
+        }
+    }
+    return builder.result.compact(simplified[expr.root()]);
+}
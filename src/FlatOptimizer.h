@@ -0,0 +1,38 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file FlatOptimizer.h
+ *
+ * Definition of the simplification of flat expressions.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#ifndef FLATOPTIMIZER_H
+#define FLATOPTIMIZER_H
+
+#include <FlatExpression.h>
+#include <TraverseException.h>
+
+/**
+ * Simplify the flat expression in one pass over its nodes.
+ *
+ * Identical subexpressions are merged into one node (hash-consing), then
+ * the local rules are applied to every node with already simplified arguments:
+ * - evaluation of operations and functions of constants (if the result is finite);
+ * - neutral and absorbing elements: x+0, x-0, x*1, x*0, x/1, 0/x, x^1, x^0;
+ * - identical arguments: x+x = 2*x, x-x = 0, x*x = x^2, x/x = 1;
+ * - ln(exp(x)) = x.
+ *
+ * This is a subset of the rules of optimize(), which works on the Expression
+ * tree and can still be applied to the result (see FlatExpression::toExpression()).
+ *
+ * @param expr The expression.
+ * @return The simplified expression without unreachable nodes.
+ */
+FlatExpression optimize(const FlatExpression &expr) throw (TraverseException);
+
+#endif /* FLATOPTIMIZER_H */
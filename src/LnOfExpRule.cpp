@@ -18,6 +18,14 @@
 LnOfExpRule::LnOfExpRule(PLn _expression) : OptimizationRule(_expression) {
 }
 
+const char *LnOfExpRule::name() {
+    return "LnOfExpRule";
+}
+
+bool LnOfExpRule::mayApply(const PLn &expr) {
+    return expr->arg->getType() == EExp;
+}
+
 bool LnOfExpRule::apply() throw (TraverseException){
     if(isTypeOf<Exp>(this->expression->arg)){
         this->optimizedExpression=SPointerCast<Exp>(this->expression->arg)->arg;
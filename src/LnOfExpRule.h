@@ -26,6 +26,9 @@ class LnOfExpRule : public OptimizationRule<PLn> {
 public:
     LnOfExpRule(PLn _expression);
     bool apply() throw(TraverseException) final;
+
+    static const char *name();
+    static bool mayApply(const PLn &expr);
 };
 
 #endif /* LNOFEXPRULE_H */
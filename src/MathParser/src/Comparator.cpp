@@ -10,144 +10,155 @@
  * @since 09.10.2017
  */
 
-#include <cmath>
-#include <limits>
-#include <algorithm>
+#include <vector>
 #include "Comparator.h"
+#include "StructuralEquality.h"
 #include "ExceptionThrower.h"
 
 Comparator::Comparator(PExpression expr) : exprBeingCompared(expr), result(false) {
 }
 
-template<typename T, typename PT>
-void Comparator::typeAware(PT expr, std::function<bool (PT, PT)> f)  throw (TraverseException) {
+/**
+ * @return true if no node of the tree misses an argument.
+ */
+bool isTreeComplete(const Expression &expr){
+    std::vector<const Expression *> pending = {&expr};
+    while(!pending.empty()){
+        const Expression *node = pending.back();
+        pending.pop_back();
+        if(node == nullptr){
+            return false;
+        }
+        
+        const Expression *args[2];
+        unsigned int argCount = argumentsOf(*node, args);
+        pending.insert(pending.end(), args, args + argCount);
+    }
+    return true;
+}
+
+void Comparator::compare(const PConstExpression &expr) throw (TraverseException) {
     this->result=false;
     if(expr == nullptr){
         THROW(TraverseException, "Left-hand expression is NULL", "N.A.");
     }
+    this->compare(*expr);
+}
+
+void Comparator::compare(const Expression &expr) throw (TraverseException) {
+    this->result=false;
     if(exprBeingCompared == nullptr){
         THROW(TraverseException, "Right-hand expression is NULL", "N.A.");
     }
     
-    if(isTypeOf<T>(this->exprBeingCompared)) {
-        PT typedExprBeingComp=SPointerCast<T>(this->exprBeingCompared);
-        this->result = f(expr, typedExprBeingComp); // лямбды лямбдочки
+    this->result = structurallyEqual(expr, *this->exprBeingCompared);
+    if(!this->result && (!isTreeComplete(expr) || !isTreeComplete(*this->exprBeingCompared))){
+        THROW(TraverseException, "Expression is incomplete", "N.A.");
     }
 }
 
-void Comparator::visit(const PConstConstant expr) throw (TraverseException) {
-    typeAware<Constant, PConstConstant>(expr, [this] (PConstConstant expr, PConstConstant typedExprBeingComp) -> bool {
-        double a=expr->value;
-        double b=typedExprBeingComp->value;
-        double eps = 0.00000001;
-        double max = std::max( { std::fabs(a), std::fabs(b), 1.0 } );
-        return std::fabs(a - b) <= max * eps;
-    });
+void Comparator::visit(const PConstConstant &expr) throw (TraverseException) {
+    this->compare(expr);
 }
 
-void Comparator::visit(const PConstVariable expr) throw (TraverseException) {
-    typeAware<Variable, PConstVariable>(expr, [this] (PConstVariable expr, PConstVariable typedExprBeingComp) -> bool {
-       return typedExprBeingComp->name == expr->name; 
-    });
+void Comparator::visit(const PConstVariable &expr) throw (TraverseException) {
+    this->compare(expr);
 }
 
-void Comparator::visit(const PConstSum expr) throw (TraverseException) {
-    typeAware<Sum, PConstSum>(expr, [this] (PConstSum expr, PConstSum typedExprBeingComp) -> bool {
-        Comparator cmpL(typedExprBeingComp->lArg);
-        Comparator cmpR(typedExprBeingComp->rArg);
-        
-        expr->lArg->traverse(cmpL);
-        bool ll=cmpL.areEqual();
-        expr->lArg->traverse(cmpR);
-        bool rl=cmpR.areEqual();
-        
-        expr->rArg->traverse(cmpL);
-        bool lr=cmpL.areEqual();
-        expr->rArg->traverse(cmpR);
-        bool rr=cmpR.areEqual();
-        
-        return (ll && rr) || (lr && rl);
-    });
+void Comparator::visit(const PConstSum &expr) throw (TraverseException) {
+    this->compare(expr);
 }
-void Comparator::visit(const PConstSub expr) throw (TraverseException) {
-    typeAware<Sub, PConstSub>(expr, [this] (PConstSub expr, PConstSub typedExprBeingComp) -> bool {
-        Comparator cmpL(typedExprBeingComp->lArg);
-        Comparator cmpR(typedExprBeingComp->rArg);
-        
-        expr->lArg->traverse(cmpL);
-        expr->rArg->traverse(cmpR);
-        
-        return cmpL.areEqual() && cmpR.areEqual();
-    });
+
+void Comparator::visit(const PConstSub &expr) throw (TraverseException) {
+    this->compare(expr);
 }
-void Comparator::visit(const PConstMult expr) throw (TraverseException) {
-    typeAware<Mult, PConstMult>(expr, [this] (PConstMult expr, PConstMult typedExprBeingComp) -> bool {
-        Comparator cmpL(typedExprBeingComp->lArg);
-        Comparator cmpR(typedExprBeingComp->rArg);
-        
-        expr->lArg->traverse(cmpL);
-        bool ll=cmpL.areEqual();
-        expr->lArg->traverse(cmpR);
-        bool rl=cmpR.areEqual();
-        
-        expr->rArg->traverse(cmpL);
-        bool lr=cmpL.areEqual();
-        expr->rArg->traverse(cmpR);
-        bool rr=cmpR.areEqual();
-        
-        return (ll && rr) || (lr && rl); 
-    });
+
+void Comparator::visit(const PConstMult &expr) throw (TraverseException) {
+    this->compare(expr);
 }
-void Comparator::visit(const PConstDiv expr) throw (TraverseException) {
-    typeAware<Div, PConstDiv>(expr, [this] (PConstDiv expr, PConstDiv typedExprBeingComp) -> bool {
-        Comparator cmpL(typedExprBeingComp->lArg);
-        Comparator cmpR(typedExprBeingComp->rArg);
-        
-        expr->lArg->traverse(cmpL);
-        expr->rArg->traverse(cmpR);
-        
-        return cmpL.areEqual() && cmpR.areEqual();
-    });
+
+void Comparator::visit(const PConstDiv &expr) throw (TraverseException) {
+    this->compare(expr);
 }
-void Comparator::visit(const PConstPow expr) throw (TraverseException) {
-    typeAware<Pow, PConstPow>(expr, [this] (PConstPow expr, PConstPow typedExprBeingComp) -> bool {
-        Comparator cmpL(typedExprBeingComp->lArg);
-        Comparator cmpR(typedExprBeingComp->rArg);
-        
-        expr->lArg->traverse(cmpL);
-        expr->rArg->traverse(cmpR);
-        
-        return cmpL.areEqual() && cmpR.areEqual();
-    });
+
+void Comparator::visit(const PConstPow &expr) throw (TraverseException) {
+    this->compare(expr);
 }
 
-template<typename T, typename PT>
-void Comparator::visitFunction(PT expr) throw (TraverseException) {
-    typeAware<T, PT>(expr, [this] (PT expr, PT typedExprBeingComp) -> bool {
-        Comparator cmp(typedExprBeingComp->arg);
-        expr->arg->traverse(cmp);
-        return cmp.areEqual();
-    });
+void Comparator::visit(const PConstSin &expr) throw (TraverseException) {
+    this->compare(expr);
 }
 
-void Comparator::visit(const PConstSin expr) throw (TraverseException) {
-    visitFunction<Sin, PConstSin>(expr);
+void Comparator::visit(const PConstCos &expr) throw (TraverseException) {
+    this->compare(expr);
 }
 
-void Comparator::visit(const PConstCos expr) throw (TraverseException) {
-    visitFunction<Cos, PConstCos>(expr);
+void Comparator::visit(const PConstTan &expr) throw (TraverseException) {
+    this->compare(expr);
 }
-void Comparator::visit(const PConstTan expr) throw (TraverseException) {
-    visitFunction<Tan, PConstTan>(expr);
+
+void Comparator::visit(const PConstCtan &expr) throw (TraverseException) {
+    this->compare(expr);
 }
-void Comparator::visit(const PConstCtan expr) throw (TraverseException) {
-    visitFunction<Ctan, PConstCtan>(expr);
+
+void Comparator::visit(const PConstLn &expr) throw (TraverseException) {
+    this->compare(expr);
 }
-void Comparator::visit(const PConstLn expr) throw (TraverseException) {
-    visitFunction<Ln, PConstLn>(expr);
+
+void Comparator::visit(const PConstExp &expr) throw (TraverseException) {
+    this->compare(expr);
+}
+
+void Comparator::visit(const Constant &expr) throw (TraverseException) {
+    this->compare(expr);
+}
+
+void Comparator::visit(const Variable &expr) throw (TraverseException) {
+    this->compare(expr);
+}
+
+void Comparator::visit(const Sum &expr) throw (TraverseException) {
+    this->compare(expr);
+}
+
+void Comparator::visit(const Sub &expr) throw (TraverseException) {
+    this->compare(expr);
+}
+
+void Comparator::visit(const Div &expr) throw (TraverseException) {
+    this->compare(expr);
+}
+
+void Comparator::visit(const Mult &expr) throw (TraverseException) {
+    this->compare(expr);
 }
-void Comparator::visit(const PConstExp expr) throw (TraverseException) {
-    visitFunction<Exp, PConstExp>(expr);
+
+void Comparator::visit(const Pow &expr) throw (TraverseException) {
+    this->compare(expr);
+}
+
+void Comparator::visit(const Sin &expr) throw (TraverseException) {
+    this->compare(expr);
+}
+
+void Comparator::visit(const Cos &expr) throw (TraverseException) {
+    this->compare(expr);
+}
+
+void Comparator::visit(const Tan &expr) throw (TraverseException) {
+    this->compare(expr);
+}
+
+void Comparator::visit(const Ctan &expr) throw (TraverseException) {
+    this->compare(expr);
+}
+
+void Comparator::visit(const Ln &expr) throw (TraverseException) {
+    this->compare(expr);
+}
+
+void Comparator::visit(const Exp &expr) throw (TraverseException) {
+    this->compare(expr);
 }
 
 bool Comparator::areEqual() {
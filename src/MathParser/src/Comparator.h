@@ -15,54 +15,64 @@
 #define COMPARATOR_H
 
 #include "Visitor.h"
+#include "ReferenceVisitor.h"
 
 /**
  * The Comparator class is used to traverse the syntax tree and compare it with 
  * the other one. Comparison considers only equalty of expressions. For instance:
  * sin(x) == sin(x), but sin(x) != sin(z).
+ * 
+ * The comparison itself is done by structurallyEqual() without recursion, the
+ * Comparator is kept as a Visitor for existing callers. Unlike structurallyEqual()
+ * it throws TraverseException if expressions are different and one of them is 
+ * incomplete. Expressions can be passed by traverse() or, without reference 
+ * counting, by accept().
  */
-class Comparator : public Visitor{
+class Comparator : public Visitor, public ReferenceVisitor {
 private:
     PExpression exprBeingCompared;
     bool result; // true if expressions are equal
     
     /**
-     * Wrapper function to perform taype aware checks, like type casts for 
-     * generic expression types, null checks and so on.
-     * 
-     * @param expr Basic Expression to compare.
-     * @param f Custom lambda function to perform type related handling of expr. \n
-     *          Has two arguments: expr - see above, typedExprBeingComp - the typed expression being compared with expr.
+     * Compare the visited expression with exprBeingCompared by structurallyEqual().
      */
-    template<typename T, typename PT>
-    void typeAware(PT expr, std::function<bool (PT expr, PT)> f) throw (TraverseException);
-    
-    /**
-     * Generalization of comparison for Expression's of function types (sin, cos, ln etc)
-     */
-    template<typename T, typename PT>
-    void visitFunction(PT expr) throw (TraverseException);
+    void compare(const PConstExpression &expr) throw (TraverseException);
+    void compare(const Expression &expr) throw (TraverseException);
 public:
     /**
      * @param expr Expression to compare with
      */
     Comparator(PExpression exprBeingCompared);
     
-    void visit(const PConstConstant expr) throw (TraverseException) final;
+    void visit(const PConstConstant &expr) throw (TraverseException) final;
+
+    void visit(const PConstVariable &expr) throw (TraverseException) final;
 
-    void visit(const PConstVariable expr) throw (TraverseException) final;
+    void visit(const PConstSum &expr) throw (TraverseException) final;
+    void visit(const PConstSub &expr) throw (TraverseException) final;
+    void visit(const PConstDiv &expr) throw (TraverseException) final;
+    void visit(const PConstMult &expr) throw (TraverseException) final;
+    void visit(const PConstPow &expr) throw (TraverseException) final;
+    void visit(const PConstSin &expr) throw (TraverseException) final;
+    void visit(const PConstCos &expr) throw (TraverseException) final;
+    void visit(const PConstTan &expr) throw (TraverseException) final;
+    void visit(const PConstCtan &expr) throw (TraverseException) final;
+    void visit(const PConstLn &expr) throw (TraverseException) final;
+    void visit(const PConstExp &expr) throw (TraverseException) final;
 
-    void visit(const PConstSum expr) throw (TraverseException) final;
-    void visit(const PConstSub expr) throw (TraverseException) final;
-    void visit(const PConstDiv expr) throw (TraverseException) final;
-    void visit(const PConstMult expr) throw (TraverseException) final;
-    void visit(const PConstPow expr) throw (TraverseException) final;
-    void visit(const PConstSin expr) throw (TraverseException) final;
-    void visit(const PConstCos expr) throw (TraverseException) final;
-    void visit(const PConstTan expr) throw (TraverseException) final;
-    void visit(const PConstCtan expr) throw (TraverseException) final;
-    void visit(const PConstLn expr) throw (TraverseException) final;
-    void visit(const PConstExp expr) throw (TraverseException) final;
+    void visit(const Constant &expr) throw (TraverseException) final;
+    void visit(const Variable &expr) throw (TraverseException) final;
+    void visit(const Sum &expr) throw (TraverseException) final;
+    void visit(const Sub &expr) throw (TraverseException) final;
+    void visit(const Div &expr) throw (TraverseException) final;
+    void visit(const Mult &expr) throw (TraverseException) final;
+    void visit(const Pow &expr) throw (TraverseException) final;
+    void visit(const Sin &expr) throw (TraverseException) final;
+    void visit(const Cos &expr) throw (TraverseException) final;
+    void visit(const Tan &expr) throw (TraverseException) final;
+    void visit(const Ctan &expr) throw (TraverseException) final;
+    void visit(const Ln &expr) throw (TraverseException) final;
+    void visit(const Exp &expr) throw (TraverseException) final;
     
     bool areEqual();
 };
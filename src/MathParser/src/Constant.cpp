@@ -11,6 +11,7 @@
 
 #include "Constant.h"
 #include "Visitor.h"
+#include "ReferenceVisitor.h"
 
 Constant::Constant() : Expression(EConstant), value(0.0) {
 }
@@ -22,6 +23,10 @@ void Constant::traverse(Visitor &visitor) const throw (TraverseException) {
     visitor.visit(shared_from_this());
 }
 
+void Constant::accept(ReferenceVisitor &visitor) const throw (TraverseException) {
+    visitor.visit(*this);
+}
+
 bool Constant::isComplete() const {
     return true;
 }
\ No newline at end of file
@@ -27,6 +27,7 @@ public:
     Constant(double value);
 
     void traverse(Visitor &) const throw (TraverseException) final;
+    void accept(ReferenceVisitor &) const throw (TraverseException) final;
     bool isComplete() const final;
     
     template <class ExpressionClass>
@@ -13,10 +13,15 @@
 
 #include "Cos.h"
 #include "Visitor.h"
+#include "ReferenceVisitor.h"
 
 Cos::Cos() : Expression(ECos) {
 }
 
+Cos::~Cos() {
+    releaseArgument(this->arg);
+}
+
 bool Cos::isComplete() const {
     return (this->arg!=nullptr);
 }
@@ -24,3 +29,7 @@ bool Cos::isComplete() const {
 void Cos::traverse(Visitor& visitor) const throw(TraverseException) {
     visitor.visit(shared_from_this());
 }
+
+void Cos::accept(ReferenceVisitor &visitor) const throw (TraverseException) {
+    visitor.visit(*this);
+}
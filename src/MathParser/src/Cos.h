@@ -24,9 +24,11 @@ public:
     SPointer<Expression> arg;
     
     Cos();
+    ~Cos();
     
     bool isComplete() const final;
     void traverse(Visitor&) const throw(TraverseException) final;
+    void accept(ReferenceVisitor &) const throw (TraverseException) final;
 };
 
 // shortcuts for pointers
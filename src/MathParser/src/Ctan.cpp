@@ -13,15 +13,24 @@
 
 #include "Ctan.h"
 #include "Visitor.h"
+#include "ReferenceVisitor.h"
 #include "TraverseException.h"
 
 Ctan::Ctan() : Expression(ECtan) {
 }
 
+Ctan::~Ctan() {
+    releaseArgument(this->arg);
+}
+
 bool Ctan::isComplete() const {
     return (this->arg!=nullptr);
 }
 
 void Ctan::traverse(Visitor& visitor) const throw(TraverseException) {
     visitor.visit(shared_from_this());
-}
\ No newline at end of file
+}
+
+void Ctan::accept(ReferenceVisitor &visitor) const throw (TraverseException) {
+    visitor.visit(*this);
+}
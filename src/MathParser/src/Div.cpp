@@ -13,14 +13,24 @@
 
 #include "Div.h"
 #include "Visitor.h"
+#include "ReferenceVisitor.h"
 #include "TraverseException.h"
 
 Div::Div() : Expression(EDiv) {}
 
+Div::~Div() {
+    releaseArgument(this->lArg);
+    releaseArgument(this->rArg);
+}
+
 void Div::traverse(Visitor &visitor) const throw(TraverseException) {
 	visitor.visit(shared_from_this());
 }
 
+void Div::accept(ReferenceVisitor &visitor) const throw (TraverseException) {
+	visitor.visit(*this);
+}
+
 bool Div::isComplete() const{
 	return (this->lArg!=nullptr && this->rArg!=nullptr);
 }
\ No newline at end of file
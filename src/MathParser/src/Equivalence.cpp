@@ -0,0 +1,86 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file Equivalence.cpp
+ *
+ * Implementation of the probabilistic equivalence check of expressions.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#include <cmath>
+#include <algorithm>
+
+#include "Equivalence.h"
+#include "Evaluator.h"
+#include "StructuralEquality.h"
+
+namespace {
+
+/**
+ * The splitmix64 generator, turns any 64 bit number into a well mixed one.
+ */
+unsigned long long mix(unsigned long long v) {
+    v += 0x9E3779B97F4A7C15ULL;
+    v = (v ^ (v >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    v = (v ^ (v >> 27)) * 0x94D049BB133111EBULL;
+    return v ^ (v >> 31);
+}
+
+/**
+ * FNV-1a hash of the name, unlike std::hash it is the same on every platform.
+ */
+unsigned long long nameHash(const std::string &name) {
+    unsigned long long hash = 0xCBF29CE484222325ULL;
+    for (char c : name) {
+        hash = (hash ^ static_cast<unsigned char> (c)) * 0x100000001B3ULL;
+    }
+    return hash;
+}
+
+/**
+ * Pseudo-random values of variables in one point.
+ */
+class RandomPoint : public VariableValues {
+private:
+    const EquivalenceOptions &options;
+    unsigned long long pointSeed;
+
+public:
+    RandomPoint(const EquivalenceOptions &options, unsigned int point) : options(options), pointSeed(mix(options.seed + point)) {
+    }
+
+    double valueOf(const std::string &name) const final {
+        // 53 random bits give a uniform double in [0, 1)
+        double uniform = (mix(this->pointSeed ^ nameHash(name)) >> 11) * (1.0 / 9007199254740992.0);
+        return this->options.lowerBound + uniform * (this->options.upperBound - this->options.lowerBound);
+    }
+};
+
+}
+
+bool probablyEquivalent(const Expression &exprL, const Expression &exprR, const EquivalenceOptions &options) throw (TraverseException) {
+    unsigned int conclusivePoints = 0;
+    for (unsigned int point = 0; point < options.points; point++) {
+        RandomPoint values(options, point);
+        double a = evaluate(exprL, values);
+        double b = evaluate(exprR, values);
+        if (!std::isfinite(a) || !std::isfinite(b)) {
+            continue;
+        }
+
+        double max = std::max({std::fabs(a), std::fabs(b), 1.0});
+        if (std::fabs(a - b) > max * options.tolerance) {
+            return false;
+        }
+        conclusivePoints++;
+    }
+
+    if (conclusivePoints == 0) {
+        return structurallyEqual(exprL, exprR);
+    }
+    return true;
+}
@@ -0,0 +1,63 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file Equivalence.h
+ *
+ * Definition of the probabilistic equivalence check of expressions.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#ifndef EQUIVALENCE_H
+#define EQUIVALENCE_H
+
+#include "Expression.h"
+
+/**
+ * Parameters of probablyEquivalent().
+ */
+struct EquivalenceOptions {
+    unsigned int points = 5; ///< Number of random points.
+    unsigned long long seed = 0x5EED; ///< The same seed gives the same points.
+    double lowerBound = 0.1; ///< Values of variables are taken from [lowerBound, upperBound).
+    double upperBound = 2.0;
+    double tolerance = 1e-6; ///< Relative tolerance of the comparison of values.
+};
+
+/**
+ * Check whether two expressions represent the same function by evaluating both 
+ * of them in random points.
+ *
+ * In every point each variable gets a pseudo-random value, which depends only 
+ * on the seed, the number of the point and the name of the variable. Values are
+ * compared with the relative tolerance, points where one of the expressions is 
+ * not finite are ignored. If no point was conclusive, the result is the one of 
+ * structurallyEqual().
+ *
+ * Error probability:
+ * - The answer false is certain, up to rounding errors bigger than the tolerance
+ *   (e.g. cancellation of huge terms).
+ * - The answer true is wrong only if the different functions agree within the 
+ *   tolerance in all k conclusive points. If they agree on a fraction p of the 
+ *   sampled domain, this happens with probability p^k. For expressions built 
+ *   of the supported operations the functions are analytic, so different 
+ *   functions agree only on a set of measure zero and p is limited by the 
+ *   tolerance band around their intersections.
+ *
+ * Contrary to equals(), algebraically equal expressions are recognized, e.g. 
+ * 2*(x+1) and 2*x+2.
+ *
+ * @param exprL First expression (left-hand).
+ * @param exprR Second expression (right-hand).
+ * @param options Parameters of the check.
+ *
+ * @return true if expressions are probably equivalent, false if they are different.
+ * @throw TraverseException if one of expressions is incomplete.
+ */
+bool probablyEquivalent(const Expression &exprL, const Expression &exprR, 
+        const EquivalenceOptions &options = EquivalenceOptions()) throw (TraverseException);
+
+#endif /* EQUIVALENCE_H */
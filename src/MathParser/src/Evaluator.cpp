@@ -0,0 +1,139 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file Evaluator.cpp
+ *
+ * Implementation of the numeric evaluation of expressions.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#include <cmath>
+
+#include "Evaluator.h"
+#include "PostOrderVisitor.h"
+#include "ExceptionThrower.h"
+
+namespace {
+
+double ctan(double v) {
+    return 1.0 / std::tan(v);
+}
+
+/**
+ * Calculates values of all nodes of the tree bottom-up.
+ */
+class Evaluator : public PostOrderVisitor<double> {
+private:
+    const VariableValues &values;
+
+    void checkComplete(const Expression &expr) throw (TraverseException) {
+        if (!expr.isComplete()) {
+            THROW(TraverseException, "Expression is incomplete", "N.A.");
+        }
+    }
+
+protected:
+    double postVisit(const Constant &expr) throw (TraverseException) final {
+        return expr.value;
+    }
+    
+    double postVisit(const Variable &expr) throw (TraverseException) final {
+        return this->values.valueOfSymbol(expr.symbol, expr.name);
+    }
+    
+    double postVisit(const Sum &expr, double &lArg, double &rArg) throw (TraverseException) final {
+        this->checkComplete(expr);
+        return lArg + rArg;
+    }
+    
+    double postVisit(const Sub &expr, double &lArg, double &rArg) throw (TraverseException) final {
+        this->checkComplete(expr);
+        return lArg - rArg;
+    }
+    
+    double postVisit(const Div &expr, double &lArg, double &rArg) throw (TraverseException) final {
+        this->checkComplete(expr);
+        return lArg / rArg;
+    }
+    
+    double postVisit(const Mult &expr, double &lArg, double &rArg) throw (TraverseException) final {
+        this->checkComplete(expr);
+        return lArg * rArg;
+    }
+    
+    double postVisit(const Pow &expr, double &lArg, double &rArg) throw (TraverseException) final {
+        this->checkComplete(expr);
+        return std::pow(lArg, rArg);
+    }
+    
+    double postVisit(const Sin &expr, double &arg) throw (TraverseException) final {
+        this->checkComplete(expr);
+        return std::sin(arg);
+    }
+    
+    double postVisit(const Cos &expr, double &arg) throw (TraverseException) final {
+        this->checkComplete(expr);
+        return std::cos(arg);
+    }
+    
+    double postVisit(const Tan &expr, double &arg) throw (TraverseException) final {
+        this->checkComplete(expr);
+        return std::tan(arg);
+    }
+    
+    double postVisit(const Ctan &expr, double &arg) throw (TraverseException) final {
+        this->checkComplete(expr);
+        return ctan(arg);
+    }
+    
+    double postVisit(const Ln &expr, double &arg) throw (TraverseException) final {
+        this->checkComplete(expr);
+        return std::log(arg);
+    }
+    
+    double postVisit(const Exp &expr, double &arg) throw (TraverseException) final {
+        this->checkComplete(expr);
+        return std::exp(arg);
+    }
+
+public:
+    Evaluator(const VariableValues &values) : values(values) {
+    }
+};
+
+}
+
+void SymbolValues::set(const std::string &name, double value) {
+    SymbolId symbol = SymbolTable::global().intern(name);
+    // a name refused by the full table can not occur in any expression
+    if (symbol != SymbolTable::none) {
+        this->names.emplace_back(symbol);
+        SymbolTable::global().release(symbol);
+        this->set(symbol, value);
+    }
+}
+
+void SymbolValues::set(SymbolId symbol, double value) {
+    if (symbol >= this->values.size()) {
+        this->values.resize(symbol + 1, NAN);
+    }
+    this->values[symbol] = value;
+}
+
+double SymbolValues::valueOf(const std::string &name) const {
+    SymbolId symbol = SymbolTable::global().find(name);
+    return symbol == SymbolTable::none ? NAN : this->valueOfSymbol(symbol, name);
+}
+
+double SymbolValues::valueOfSymbol(SymbolId symbol, const std::string &) const {
+    return symbol < this->values.size() ? this->values[symbol] : NAN;
+}
+
+double evaluate(const Expression &expr, const VariableValues &values) throw (TraverseException) {
+    Evaluator evaluator(values);
+    return evaluator.traversePostOrder(expr);
+}
@@ -0,0 +1,82 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file Evaluator.h
+ *
+ * Definition of the numeric evaluation of expressions.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#ifndef EVALUATOR_H
+#define EVALUATOR_H
+
+#include <string>
+#include <vector>
+#include "Expression.h"
+#include "SymbolTable.h"
+
+/**
+ * Source of values of variables for evaluate().
+ */
+class VariableValues {
+public:
+    virtual ~VariableValues() {
+    }
+
+    /**
+     * @param name Name of the variable.
+     * @return The value of the variable.
+     */
+    virtual double valueOf(const std::string &name) const = 0;
+
+    /**
+     * The value by the identifier of the name, calls valueOf() by default.
+     * 
+     * @param symbol Identifier of the variable in SymbolTable::global().
+     * @param name Name of the variable.
+     * @return The value of the variable.
+     */
+    virtual double valueOfSymbol(SymbolId, const std::string &name) const {
+        return this->valueOf(name);
+    }
+};
+
+/**
+ * Values of variables stored by identifiers of their names, no lookup by name
+ * is done during the evaluation. Variables without values are NaN.
+ */
+class SymbolValues : public VariableValues {
+private:
+    std::vector<double> values;
+    std::vector<SymbolReference> names; // names set by name, they are not evicted meanwhile
+
+public:
+    /**
+     * Set the value, the name is interned if necessary.
+     */
+    void set(const std::string &name, double value);
+    void set(SymbolId symbol, double value);
+
+    double valueOf(const std::string &name) const final;
+    double valueOfSymbol(SymbolId symbol, const std::string &name) const final;
+};
+
+/**
+ * Calculate the value of the expression.
+ *
+ * The result follows the IEEE arithmetic of std::pow, std::log etc: it is NaN 
+ * or infinite if the expression is not defined in the given point.
+ *
+ * @param expr The expression.
+ * @param values Values of variables.
+ *
+ * @return The value of expr.
+ * @throw TraverseException if the expression is incomplete.
+ */
+double evaluate(const Expression &expr, const VariableValues &values) throw (TraverseException);
+
+#endif /* EVALUATOR_H */
@@ -13,11 +13,16 @@
 
 #include "Exp.h"
 #include "Visitor.h"
+#include "ReferenceVisitor.h"
 #include "TraverseException.h"
 
 Exp::Exp() : Expression(EExp) {
 }
 
+Exp::~Exp() {
+    releaseArgument(this->arg);
+}
+
 bool Exp::isComplete() const {
     return (this->arg!=nullptr);
 }
@@ -26,4 +31,8 @@ void Exp::traverse(Visitor& visitor) const throw(TraverseException) {
     visitor.visit(shared_from_this());
 }
 
+void Exp::accept(ReferenceVisitor &visitor) const throw (TraverseException) {
+    visitor.visit(*this);
+}
+
 
@@ -0,0 +1,83 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file Expected.h
+ *
+ * Definition of results which carry either a value or an error.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#ifndef EXPECTED_H
+#define EXPECTED_H
+
+#include <string>
+#include <utility>
+
+/**
+ * Error reported without an exception.
+ */
+struct Failure {
+
+    enum Kind {
+        /** The operation would throw ParsingException. */
+        Parsing,
+        /** The operation would throw TraverseException. */
+        Traverse,
+        /** The operation would throw BudgetExceededException (see ResourceBudget). */
+        Budget
+    };
+
+    Kind kind;
+
+    /** The text of what() of the exception, the debug context may be omitted. */
+    std::string message;
+};
+
+/**
+ * The value of a successful operation or its Failure, for callers which
+ * expect errors often (e.g. inputs typed by users) and do not want to pay
+ * for throwing and catching exceptions.
+ */
+template <typename T>
+class Expected {
+private:
+    bool success;
+    T value;
+    Failure failure;
+
+public:
+
+    Expected(T value) : success(true), value(std::move(value)), failure{Failure::Parsing, ""} {
+    }
+
+    Expected(Failure failure) : success(false), value(), failure(std::move(failure)) {
+    }
+
+    bool hasValue() const {
+        return this->success;
+    }
+
+    explicit operator bool() const {
+        return this->success;
+    }
+
+    /**
+     * @return The value, default constructed if the operation failed.
+     */
+    const T &getValue() const {
+        return this->value;
+    }
+
+    /**
+     * @return The error, not defined if the operation succeeded.
+     */
+    const Failure &getFailure() const {
+        return this->failure;
+    }
+};
+
+#endif /* EXPECTED_H */
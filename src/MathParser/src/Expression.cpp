@@ -13,20 +13,280 @@
 
 #include "Expression.h"
 #include "StringGenerator.h"
-#include "Comparator.h"
+#include "StructuralEquality.h"
+#include "Variable.h"
+#include "Sum.h"
+#include "Sub.h"
+#include "Mult.h"
+#include "Div.h"
+#include "Pow.h"
+#include "Sin.h"
+#include "Cos.h"
+#include "Tan.h"
+#include "Ctan.h"
+#include "Ln.h"
+#include "Exp.h"
 
-Expression::Expression(ExpressionType type) : type(type){
+#include <vector>
+#include <algorithm>
+#include <ostream>
+#include <utility>
+
+Expression::Expression(ExpressionType type) : type(type), hash(0){
+}
+
+ExpressionType Expression::getType() const {
+    return this->type;
+}
+
+/**
+ * Combine the hash value with another one.
+ */
+inline size_t combineHash(size_t seed, size_t value){
+    return seed ^ (value + 0x9e3779b9 + (seed << 6) + (seed >> 2));
+}
+
+/**
+ * Hash of the node computed out of hashes of its arguments, commutative 
+ * operations are hashed symmetrically. It is never 0, which marks nodes 
+ * without a cached hash.
+ */
+size_t nodeHash(const Expression &expr, const size_t *argHashes){
+    size_t typeHash = combineHash(0, expr.getType());
+    size_t hash;
+    switch(expr.getType()){
+        case EConstant:
+            // constants are equal with a certain precision, there is no hash for that
+            hash = typeHash;
+            break;
+        case EVariable:
+            hash = combineHash(typeHash, static_cast<const Variable &>(expr).symbol);
+            break;
+        case ESum:
+        case EMult:
+            hash = combineHash(combineHash(typeHash, argHashes[0] + argHashes[1]), argHashes[0] ^ argHashes[1]);
+            break;
+        case ESub:
+        case EDiv:
+        case EPow:
+            hash = combineHash(combineHash(typeHash, argHashes[0]), argHashes[1]);
+            break;
+        default:
+            hash = combineHash(typeHash, argHashes[0]);
+    }
+    return hash == 0 ? 1 : hash;
+}
+
+size_t Expression::hashTree() const {
+    // post-order traversal with an explicit stack, every node gets the hash 
+    // and whether it can be cached (the subtree is complete)
+    struct Frame {
+        const Expression *expr;
+        bool isExpanded;
+    };
+    std::vector<Frame> stack = {{this, false}};
+    std::vector<std::pair<size_t, bool>> results;
+    
+    while(!stack.empty()){
+        Frame frame = stack.back();
+        if(frame.expr == nullptr){
+            // the missing argument is hashed as 0
+            stack.pop_back();
+            results.push_back({0, false});
+            continue;
+        }
+        size_t cached = frame.expr->hash.load(std::memory_order_relaxed);
+        if(cached != 0){
+            stack.pop_back();
+            results.push_back({cached, true});
+            continue;
+        }
+        
+        const Expression *args[2];
+        unsigned int argCount = argumentsOf(*frame.expr, args);
+        if(!frame.isExpanded){
+            stack.back().isExpanded = true;
+            for(unsigned int n = argCount; n > 0; n--){
+                stack.push_back({args[n - 1], false});
+            }
+            continue;
+        }
+        
+        stack.pop_back();
+        size_t argHashes[2];
+        bool isCacheable = true;
+        for(unsigned int n = 0; n < argCount; n++){
+            argHashes[n] = results[results.size() - argCount + n].first;
+            isCacheable = isCacheable && results[results.size() - argCount + n].second;
+        }
+        results.resize(results.size() - argCount);
+        
+        size_t hash = nodeHash(*frame.expr, argHashes);
+        if(isCacheable){
+            frame.expr->hash.store(hash, std::memory_order_relaxed);
+        }
+        results.push_back({hash, isCacheable});
+    }
+    return results.back().first;
+}
+
+size_t Expression::getHash() const {
+    // the value is a function of the immutable tree, threads racing here store 
+    // the same one, so the relaxed order is enough
+    size_t cached = this->hash.load(std::memory_order_relaxed);
+    if(cached != 0){
+        return cached;
+    }
+    
+    // nodes are mostly hashed bottom-up, right after their arguments
+    const Expression *args[2];
+    unsigned int argCount = argumentsOf(*this, args);
+    size_t argHashes[2];
+    for(unsigned int n = 0; n < argCount; n++){
+        argHashes[n] = (args[n] == nullptr) ? 0 : args[n]->hash.load(std::memory_order_relaxed);
+        if(argHashes[n] == 0){
+            return this->hashTree();
+        }
+    }
+    
+    cached = nodeHash(*this, argHashes);
+    this->hash.store(cached, std::memory_order_relaxed);
+    return cached;
+}
+
+unsigned int argumentsOf(const Expression &expr, const Expression *args[2]){
+    switch(expr.getType()){
+        case ESum:
+            args[0] = static_cast<const Sum &>(expr).lArg.get();
+            args[1] = static_cast<const Sum &>(expr).rArg.get();
+            return 2;
+        case ESub:
+            args[0] = static_cast<const Sub &>(expr).lArg.get();
+            args[1] = static_cast<const Sub &>(expr).rArg.get();
+            return 2;
+        case EDiv:
+            args[0] = static_cast<const Div &>(expr).lArg.get();
+            args[1] = static_cast<const Div &>(expr).rArg.get();
+            return 2;
+        case EMult:
+            args[0] = static_cast<const Mult &>(expr).lArg.get();
+            args[1] = static_cast<const Mult &>(expr).rArg.get();
+            return 2;
+        case EPow:
+            args[0] = static_cast<const Pow &>(expr).lArg.get();
+            args[1] = static_cast<const Pow &>(expr).rArg.get();
+            return 2;
+        case ESin:
+            args[0] = static_cast<const Sin &>(expr).arg.get();
+            return 1;
+        case ECos:
+            args[0] = static_cast<const Cos &>(expr).arg.get();
+            return 1;
+        case ETan:
+            args[0] = static_cast<const Tan &>(expr).arg.get();
+            return 1;
+        case ECtan:
+            args[0] = static_cast<const Ctan &>(expr).arg.get();
+            return 1;
+        case ELn:
+            args[0] = static_cast<const Ln &>(expr).arg.get();
+            return 1;
+        case EExp:
+            args[0] = static_cast<const Exp &>(expr).arg.get();
+            return 1;
+        default:
+            return 0;
+    }
+}
+
+/**
+ * Move the arguments of the expression to the list.
+ */
+template <typename T>
+inline void moveArgumentsDiadic(Expression &expr, std::vector<PExpression> &pending){
+    T &typed = static_cast<T &>(expr);
+    pending.push_back(std::move(typed.lArg));
+    pending.push_back(std::move(typed.rArg));
+}
+
+template <typename T>
+inline void moveArgumentMonadic(Expression &expr, std::vector<PExpression> &pending){
+    pending.push_back(std::move(static_cast<T &>(expr).arg));
+}
+
+void Expression::releaseArgument(PExpression &arg){
+    const Expression *args[2];
+    if(arg == nullptr || arg.use_count() > 1 || argumentsOf(*arg, args) == 0){
+        // nothing deep is destroyed here
+        arg.reset();
+        return;
+    }
+    
+    // the subtree is dismantled with an explicit stack: arguments of a node are
+    // moved out before the node is destroyed, so destructors do not recurse
+    std::vector<PExpression> pending;
+    pending.push_back(std::move(arg));
+    while(!pending.empty()){
+        PExpression expr = std::move(pending.back());
+        pending.pop_back();
+        if(expr == nullptr || expr.use_count() > 1){
+            continue;
+        }
+        
+        switch(expr->getType()){
+            case ESum: moveArgumentsDiadic<Sum>(*expr, pending); break;
+            case ESub: moveArgumentsDiadic<Sub>(*expr, pending); break;
+            case EDiv: moveArgumentsDiadic<Div>(*expr, pending); break;
+            case EMult: moveArgumentsDiadic<Mult>(*expr, pending); break;
+            case EPow: moveArgumentsDiadic<Pow>(*expr, pending); break;
+            case ESin: moveArgumentMonadic<Sin>(*expr, pending); break;
+            case ECos: moveArgumentMonadic<Cos>(*expr, pending); break;
+            case ETan: moveArgumentMonadic<Tan>(*expr, pending); break;
+            case ECtan: moveArgumentMonadic<Ctan>(*expr, pending); break;
+            case ELn: moveArgumentMonadic<Ln>(*expr, pending); break;
+            case EExp: moveArgumentMonadic<Exp>(*expr, pending); break;
+            default: break;
+        }
+    }
 }
 
 string to_string(const PExpression expr){
+    return to_string(expr, defaultNumberPrecision);
+}
+
+string to_string(const PExpression expr, int precision){
     if(expr==nullptr){
         return "?";
     }
-    StringGenerator stringGenerator;
-    expr->traverse(stringGenerator);
+    StringGenerator stringGenerator(precision);
+    expr->accept(stringGenerator);
     return stringGenerator.getLastVisitResult();
 }
 
+void print(std::ostream &out, const PExpression expr, int precision){
+    if(expr==nullptr){
+        out << "?";
+        return;
+    }
+    StreamOutput output(out);
+    StringGenerator stringGenerator(output, precision);
+    expr->accept(stringGenerator);
+}
+
+size_t print(char *buffer, size_t size, const PExpression expr, int precision){
+    BufferOutput output(buffer, size > 0 ? size - 1 : 0);
+    if(expr==nullptr){
+        output.write("?", 1);
+    }else{
+        StringGenerator stringGenerator(output, precision);
+        expr->accept(stringGenerator);
+    }
+    if(size > 0){
+        buffer[std::min(output.getLength(), size - 1)] = '\0';
+    }
+    return output.getLength();
+}
+
 bool equals(const PExpression exprL, const PExpression exprR) throw (TraverseException){
     if(exprL == nullptr) {
         return false;
@@ -34,8 +294,5 @@ bool equals(const PExpression exprL, const PExpression exprR) throw (TraverseExc
     if(exprR == nullptr) {
         return false;
     }
-    
-    Comparator comparator(exprR);
-    exprL->traverse(comparator);
-    return comparator.areEqual();
+    return structurallyEqual(*exprL, *exprR);
 }
\ No newline at end of file
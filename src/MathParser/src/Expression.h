@@ -14,11 +14,16 @@
 #ifndef SRC_EXPRESSION_H_
 #define SRC_EXPRESSION_H_
 
+#include <atomic>
 #include <string>
+#include <cstddef>
+#include <iosfwd>
 #include "Pointers.h"
+#include "Numbers.h"
 #include "TraverseException.h"
 
 class Visitor;
+class ReferenceVisitor;
 
 /** 
  * @brief Type of expression.
@@ -49,17 +54,66 @@ enum ExpressionType {
     EExp = 12 ///< Expression for exponential function of basis e.
 };
 
-class Expression {
+class Expression : public SPointerTarget {
 private:
     const ExpressionType type;
     
+    // 0 until computed, computed hashes are never 0; one atomic word, since 
+    // shared trees are hashed by several threads at once
+    mutable std::atomic<size_t> hash;
+    
+    size_t hashTree() const;
+    
 protected:
     Expression(ExpressionType type);
+    
+    /**
+     * Release the argument of the expression being destroyed.
+     * 
+     * Subtrees which are not shared are destroyed iteratively, so destruction of 
+     * very deep trees does not overflow the stack. Must be called in destructors
+     * of expressions for each argument.
+     * 
+     * @param arg The argument, it is empty afterwards.
+     */
+    static void releaseArgument(SPointer<Expression> &arg);
 
 public:
     bool virtual isComplete() const = 0;
     void virtual traverse(Visitor &) const throw (TraverseException) = 0;
     
+    /**
+     * Pass the expression to the visitor by reference.
+     * 
+     * Unlike traverse() no pointer to the expression is created, hence no 
+     * reference counting is involved.
+     * 
+     * @param visitor The visitor.
+     */
+    void virtual accept(ReferenceVisitor &visitor) const throw (TraverseException) = 0;
+    
+    /**
+     * @return The concrete type of the Expression.
+     */
+    ExpressionType getType() const;
+    
+    /**
+     * Get the structural hash of the expression.
+     * 
+     * Expressions which are equal according to equals() have equal hashes: 
+     * constants are hashed by type only (they are compared with a precision) and 
+     * hashes of Sum and Mult do not depend on the order of arguments. Therefore 
+     * different hashes mean different expressions. 
+     * 
+     * The hash is computed once and cached in every node of the tree, the complete 
+     * expression must not be modified afterwards. It can be called by several 
+     * threads sharing the tree. Hashes of incomplete expressions
+     * are not cached.
+     * 
+     * @return The hash.
+     */
+    size_t getHash() const;
+    
     template <class ExpressionClass>
     friend bool isTypeOf(SPointer<Expression> exprInstance);
 };
@@ -86,6 +140,15 @@ bool isTypeOf(PExpression exprInstance){
     return (exprInstance->type == dummy.type);
 }
 
+/**
+ * Get the arguments of the expression of any type.
+ * 
+ * @param expr The expression.
+ * @param args [out] The arguments from left to right, missing arguments are nullptr.
+ * @return Number of arguments of the type of expr (0 for constants and variables).
+ */
+unsigned int argumentsOf(const Expression &expr, const Expression *args[2]);
+
 /**
  * Get a string representation of an expression.
  *  
@@ -94,6 +157,38 @@ bool isTypeOf(PExpression exprInstance){
  */
 std::string to_string(const PExpression expr);
 
+/**
+ * Get a string representation of an expression.
+ *  
+ * @param expr The expression.
+ * @param precision Number of significant digits of constants (2 by default).
+ * @return Readable string representing the expr.
+ */
+std::string to_string(const PExpression expr, int precision);
+
+/**
+ * Write the string representation of an expression to the stream in chunks,
+ * the whole text is not built in the memory.
+ * 
+ * @param out The stream.
+ * @param expr The expression.
+ * @param precision Number of significant digits of constants.
+ */
+void print(std::ostream &out, const PExpression expr, int precision = defaultNumberPrecision);
+
+/**
+ * Write the string representation of an expression to the caller's buffer,
+ * like snprintf() does: the text is cut to size-1 characters and terminated
+ * by zero.
+ * 
+ * @param buffer The buffer.
+ * @param size Size of the buffer.
+ * @param expr The expression.
+ * @param precision Number of significant digits of constants.
+ * @return Length of the whole text (without the terminating zero).
+ */
+size_t print(char *buffer, size_t size, const PExpression expr, int precision = defaultNumberPrecision);
+
 /**
  * Check whether the two given expressions are identical.
  * 
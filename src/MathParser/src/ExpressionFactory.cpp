@@ -11,141 +11,170 @@
  * @since 04.09.2017
  */
 
+#include <cctype>
+#include <cmath>
+#include <stdexcept>
+#include <utility>
+
 #include "ExpressionFactory.h"
+#include "Numbers.h"
+#include "ResourceBudget.h"
 
 PVariable createVariable(const std::string name) {
+    chargeNode();
     return MakeSPointer<Variable>(name);
 }
 
+PVariable createVariable(SymbolId symbol) {
+    chargeNode();
+    return MakeSPointer<Variable>(symbol);
+}
+
 PConstant createConstant(const double val) {
+    chargeNode();
     return MakeSPointer<Constant>(val);
 }
 
 PConstant createConstant(const std::string strVal) {
-    std::string normStrVal=strVal;
-    
-    size_t pos=0;
-    do {
-        pos = normStrVal.find_first_of(',', 0);
-        if(pos != std::string::npos){
-            normStrVal = normStrVal.replace(pos, 1, ".");
-        }
-    } while (pos != std::string::npos);
+    const char *begin = strVal.data();
+    const char *end = begin + strVal.size();
+    while(begin != end && std::isspace(static_cast<unsigned char>(*begin))){
+        begin++;
+    }
     
-    return MakeSPointer<Constant>(std::stod(normStrVal));
+    double value;
+    if(parseNumber(begin, end, value) == begin){
+        throw std::invalid_argument("Not a number: " + strVal);
+    }
+    if(std::isinf(value)){
+        throw std::out_of_range("The number is out of range: " + strVal);
+    }
+    chargeNode();
+    return MakeSPointer<Constant>(value);
 }
 
 PSum createSum() {
+    chargeNode();
     return MakeSPointer<Sum>();
 }
 
 PSum createSum(PExpression lArg, PExpression rArg) {
     PSum sum = createSum();
-    sum->lArg = lArg;
-    sum->rArg = rArg;
+    sum->lArg = std::move(lArg);
+    sum->rArg = std::move(rArg);
     return sum;
 }
 
 PSub createSub() {
+    chargeNode();
     return MakeSPointer<Sub>();
 }
 
 PSub createSub(PExpression lArg, PExpression rArg) {
     PSub sub = createSub();
-    sub->lArg = lArg;
-    sub->rArg = rArg;
+    sub->lArg = std::move(lArg);
+    sub->rArg = std::move(rArg);
     return sub;
 }
 
 PMult createMult() {
+    chargeNode();
     return MakeSPointer<Mult>();
 }
 
 PMult createMult(PExpression lArg, PExpression rArg) {
     PMult mult = createMult();
-    mult->lArg = lArg;
-    mult->rArg = rArg;
+    mult->lArg = std::move(lArg);
+    mult->rArg = std::move(rArg);
     return mult;
 }
 
 PDiv createDiv() {
+    chargeNode();
     return MakeSPointer<Div>();
 }
 
 PDiv createDiv(PExpression lArg, PExpression rArg) {
     PDiv div = createDiv();
-    div->lArg = lArg;
-    div->rArg = rArg;
+    div->lArg = std::move(lArg);
+    div->rArg = std::move(rArg);
     return div;
 }
 
 PPow createPow() {
+    chargeNode();
     return MakeSPointer<Pow>();
 }
 
 PPow createPow(PExpression lArg, PExpression rArg) {
     PPow pow = createPow();
-    pow->lArg = lArg;
-    pow->rArg = rArg;
+    pow->lArg = std::move(lArg);
+    pow->rArg = std::move(rArg);
     return pow;
 }
 
 PLn createLn() {
+    chargeNode();
     return MakeSPointer<Ln>();
 }
 
 PLn createLn(PExpression arg) {
     PLn ln = createLn();
-    ln->arg = arg;
+    ln->arg = std::move(arg);
     return ln;
 }
 
 PExp createExp() {
+    chargeNode();
     return MakeSPointer<Exp>();
 }
 
 PExp createExp(PExpression arg) {
     PExp exp = createExp();
-    exp->arg = arg;
+    exp->arg = std::move(arg);
     return exp;
 }
 
 PCos createCos() {
+    chargeNode();
     return MakeSPointer<Cos>();
 }
 
 PCos createCos(PExpression arg) {
     PCos cos = createCos();
-    cos->arg = arg;
+    cos->arg = std::move(arg);
     return cos;
 }
 
 PSin createSin() {
+    chargeNode();
     return MakeSPointer<Sin>();
 }
 
 PSin createSin(PExpression arg) {
     PSin sin = createSin();
-    sin->arg = arg;
+    sin->arg = std::move(arg);
     return sin;
 }
 
 PTan createTan() {
+    chargeNode();
     return MakeSPointer<Tan>();
 }
 
 PTan createTan(PExpression arg) {
     PTan tan = createTan();
-    tan->arg = arg;
+    tan->arg = std::move(arg);
     return tan;
 }
 
 PCtan createCtan() {
+    chargeNode();
     return MakeSPointer<Ctan>();
 }
 
 PCtan createCtan(PExpression arg) {
     PCtan ctan = createCtan();
-    ctan->arg = arg;
+    ctan->arg = std::move(arg);
     return ctan;
 }
\ No newline at end of file
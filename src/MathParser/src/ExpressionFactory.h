@@ -30,10 +30,18 @@
 #include "Ln.h"
 #include "Exp.h"
 
+// Every created element is charged to the ResourceBudget of the calling thread
+// (if it has one), the functions throw BudgetExceededException when it is exhausted.
+
 PVariable createVariable(const std::string name);
+/**
+ * Create Variable of the name which is already interned in SymbolTable::global().
+ */
+PVariable createVariable(SymbolId symbol);
 PConstant createConstant(const double val);
 /**
- * Create Constant from the string representation of nummeric value.
+ * Create Constant from the string representation of nummeric value (see 
+ * parseNumber()), the rest of the string after the number is ignored.
  * 
  * Can throw the invalid_argument or out_of_range.
  */
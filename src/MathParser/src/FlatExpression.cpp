@@ -0,0 +1,494 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file FlatExpression.cpp
+ *
+ * Implementation of FlatExpression.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#include "FlatExpression.h"
+
+#include <ostream>
+#include <sstream>
+#include <unordered_map>
+
+#include "PostOrderVisitor.h"
+#include "ExpressionFactory.h"
+#include "ExceptionThrower.h"
+
+namespace {
+
+bool isFunction(ExpressionType type) {
+    switch (type) {
+        case ESin:
+        case ECos:
+        case ETan:
+        case ECtan:
+        case ELn:
+        case EExp:
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool isOperation(ExpressionType type) {
+    return type != EConstant && type != EVariable && !isFunction(type);
+}
+
+const char *symbolOf(ExpressionType type) {
+    switch (type) {
+        case ESum: return "+";
+        case ESub: return "-";
+        case EMult: return "*";
+        case EDiv: return "/";
+        case EPow: return "^";
+        case ESin: return "sin";
+        case ECos: return "cos";
+        case ETan: return "tan";
+        case ECtan: return "ctan";
+        case ELn: return "ln";
+        case EExp: return "exp";
+        default: return "";
+    }
+}
+
+/**
+ * Appends nodes of the tree bottom-up, results are indices of nodes.
+ */
+class Flattener : public PostOrderVisitor<FlatExpression::Index> {
+private:
+    typedef FlatExpression::Index Index;
+
+    FlatExpression &flat;
+
+    // merging of identical subexpressions, see flattenShared()
+    const bool merge;
+    std::unordered_map<const Expression *, Index> visited;
+    std::unordered_map<FlatExpression::NodeKey, Index, FlatExpression::NodeKeyHash> nodes;
+    std::unordered_map<double, Index> constants;
+    std::unordered_map<SymbolId, Index> variables;
+
+    Index remember(const Expression &expr, Index index) {
+        if (this->merge) {
+            this->visited[&expr] = index;
+        }
+        return index;
+    }
+
+    Index node(const Expression &expr, ExpressionType type, Index lArg, Index rArg = FlatExpression::none) throw (TraverseException) {
+        if (!expr.isComplete()) {
+            THROW(TraverseException, "Incomplete expression can not be flattened", "N.A.");
+        }
+        if (!this->merge) {
+            return this->flat.addNode(type, lArg, rArg);
+        }
+
+        FlatExpression::NodeKey key = {type, lArg, rArg};
+        auto found = this->nodes.find(key);
+        if (found != this->nodes.end()) {
+            return this->remember(expr, found->second);
+        }
+        return this->remember(expr, this->nodes[key] = this->flat.addNode(type, lArg, rArg));
+    }
+
+protected:
+    Index postVisit(const Constant &expr) throw (TraverseException) final {
+        if (!this->merge) {
+            return this->flat.addConstant(expr.value);
+        }
+        auto found = this->constants.find(expr.value);
+        if (found != this->constants.end()) {
+            return found->second;
+        }
+        return this->constants[expr.value] = this->flat.addConstant(expr.value);
+    }
+
+    Index postVisit(const Variable &expr) throw (TraverseException) final {
+        if (!this->merge) {
+            return this->flat.addVariable(expr.symbol);
+        }
+        auto found = this->variables.find(expr.symbol);
+        if (found != this->variables.end()) {
+            return found->second;
+        }
+        return this->variables[expr.symbol] = this->flat.addVariable(expr.symbol);
+    }
+
+    Index postVisit(const Sum &expr, Index &lArg, Index &rArg) throw (TraverseException) final {
+        return this->node(expr, ESum, lArg, rArg);
+    }
+
+    Index postVisit(const Sub &expr, Index &lArg, Index &rArg) throw (TraverseException) final {
+        return this->node(expr, ESub, lArg, rArg);
+    }
+
+    Index postVisit(const Div &expr, Index &lArg, Index &rArg) throw (TraverseException) final {
+        return this->node(expr, EDiv, lArg, rArg);
+    }
+
+    Index postVisit(const Mult &expr, Index &lArg, Index &rArg) throw (TraverseException) final {
+        return this->node(expr, EMult, lArg, rArg);
+    }
+
+    Index postVisit(const Pow &expr, Index &lArg, Index &rArg) throw (TraverseException) final {
+        return this->node(expr, EPow, lArg, rArg);
+    }
+
+    Index postVisit(const Sin &expr, Index &arg) throw (TraverseException) final {
+        return this->node(expr, ESin, arg);
+    }
+
+    Index postVisit(const Cos &expr, Index &arg) throw (TraverseException) final {
+        return this->node(expr, ECos, arg);
+    }
+
+    Index postVisit(const Tan &expr, Index &arg) throw (TraverseException) final {
+        return this->node(expr, ETan, arg);
+    }
+
+    Index postVisit(const Ctan &expr, Index &arg) throw (TraverseException) final {
+        return this->node(expr, ECtan, arg);
+    }
+
+    Index postVisit(const Ln &expr, Index &arg) throw (TraverseException) final {
+        return this->node(expr, ELn, arg);
+    }
+
+    Index postVisit(const Exp &expr, Index &arg) throw (TraverseException) final {
+        return this->node(expr, EExp, arg);
+    }
+
+public:
+    Flattener(FlatExpression &flat, bool merge = false) : flat(flat), merge(merge) {
+        if (merge) {
+            // visited nodes are not traversed again
+            this->setPrecomputedResults(&this->visited);
+        }
+    }
+};
+
+PExpression createNode(ExpressionType type, const PExpression &lArg, const PExpression &rArg) {
+    switch (type) {
+        case ESum: return createSum(lArg, rArg);
+        case ESub: return createSub(lArg, rArg);
+        case EMult: return createMult(lArg, rArg);
+        case EDiv: return createDiv(lArg, rArg);
+        case EPow: return createPow(lArg, rArg);
+        case ESin: return createSin(lArg);
+        case ECos: return createCos(lArg);
+        case ETan: return createTan(lArg);
+        case ECtan: return createCtan(lArg);
+        case ELn: return createLn(lArg);
+        case EExp: return createExp(lArg);
+        default: return nullptr;
+    }
+}
+
+}
+
+const FlatExpression::Index FlatExpression::none;
+
+void FlatExpression::checkArgument(Index arg) const throw (TraverseException) {
+    if (arg >= this->types.size()) {
+        THROW(TraverseException, "Argument of the node must be added before the node", "Index: " + std::to_string(arg));
+    }
+}
+
+FlatExpression::Index FlatExpression::addConstant(double value) {
+    this->types.push_back(EConstant);
+    this->lArgs.push_back(this->constants.size());
+    this->rArgs.push_back(none);
+    this->constants.push_back(value);
+    return this->types.size() - 1;
+}
+
+FlatExpression::Index FlatExpression::addVariable(const std::string &name) throw (TraverseException) {
+    SymbolId symbol = SymbolTable::global().intern(name);
+    if (symbol == SymbolTable::none) {
+        THROW(TraverseException, "Too many names of variables.", name);
+    }
+    Index node = this->addVariable(symbol);
+    SymbolTable::global().release(symbol);
+    return node;
+}
+
+FlatExpression::Index FlatExpression::addVariable(SymbolId symbol) {
+    this->symbols.emplace_back(symbol);
+    this->types.push_back(EVariable);
+    this->lArgs.push_back(symbol);
+    this->rArgs.push_back(none);
+    return this->types.size() - 1;
+}
+
+FlatExpression::Index FlatExpression::addNode(ExpressionType type, Index lArg, Index rArg) throw (TraverseException) {
+    if (type == EConstant || type == EVariable) {
+        THROW(TraverseException, "Leaves are added by addConstant() and addVariable()", "N.A.");
+    }
+    this->checkArgument(lArg);
+    if (isFunction(type)) {
+        rArg = none;
+    } else {
+        this->checkArgument(rArg);
+    }
+
+    this->types.push_back(type);
+    this->lArgs.push_back(lArg);
+    this->rArgs.push_back(rArg);
+    return this->types.size() - 1;
+}
+
+void FlatExpression::reserve(size_t size) {
+    this->types.reserve(size);
+    this->lArgs.reserve(size);
+    this->rArgs.reserve(size);
+}
+
+size_t FlatExpression::size() const {
+    return this->types.size();
+}
+
+FlatExpression::Index FlatExpression::root() const {
+    return this->types.empty() ? none : this->types.size() - 1;
+}
+
+ExpressionType FlatExpression::type(Index node) const {
+    return static_cast<ExpressionType> (this->types[node]);
+}
+
+FlatExpression::Index FlatExpression::lArg(Index node) const {
+    return this->lArgs[node];
+}
+
+FlatExpression::Index FlatExpression::rArg(Index node) const {
+    return this->rArgs[node];
+}
+
+double FlatExpression::value(Index node) const {
+    return this->constants[this->lArgs[node]];
+}
+
+SymbolId FlatExpression::symbol(Index node) const {
+    return this->lArgs[node];
+}
+
+const std::string &FlatExpression::name(Index node) const {
+    return SymbolTable::global().nameOf(this->lArgs[node]);
+}
+
+FlatExpression FlatExpression::compact(Index newRoot) const {
+    FlatExpression result;
+    if (newRoot >= this->size()) {
+        return result;
+    }
+
+    // arguments precede nodes, so one backward pass marks everything reachable
+    std::vector<Index> newIndex(newRoot + 1, none);
+    newIndex[newRoot] = 0;
+    for (Index node = newRoot + 1; node-- > 0;) {
+        if (newIndex[node] == none || this->type(node) == EConstant || this->type(node) == EVariable) {
+            continue;
+        }
+        newIndex[this->lArgs[node]] = 0;
+        if (this->rArgs[node] != none) {
+            newIndex[this->rArgs[node]] = 0;
+        }
+    }
+
+    for (Index node = 0; node <= newRoot; node++) {
+        if (newIndex[node] == none) {
+            continue;
+        }
+        switch (this->type(node)) {
+            case EConstant:
+                newIndex[node] = result.addConstant(this->value(node));
+                break;
+            case EVariable:
+                newIndex[node] = result.addVariable(this->symbol(node));
+                break;
+            default:
+                Index rArg = this->rArgs[node] == none ? none : newIndex[this->rArgs[node]];
+                newIndex[node] = result.addNode(this->type(node), newIndex[this->lArgs[node]], rArg);
+        }
+    }
+    return result;
+}
+
+PExpression FlatExpression::toExpression() const {
+    std::vector<PExpression> nodes(this->size());
+    for (Index node = 0; node < this->size(); node++) {
+        switch (this->type(node)) {
+            case EConstant:
+                nodes[node] = createConstant(this->value(node));
+                break;
+            case EVariable:
+                nodes[node] = createVariable(this->symbol(node));
+                break;
+            default:
+                nodes[node] = createNode(this->type(node), nodes[this->lArgs[node]],
+                        this->rArgs[node] == none ? nullptr : nodes[this->rArgs[node]]);
+        }
+    }
+    return nodes.empty() ? nullptr : nodes.back();
+}
+
+size_t FlatExpression::memoryUsage() const {
+    return this->types.capacity() * sizeof (std::uint8_t)
+            + (this->lArgs.capacity() + this->rArgs.capacity()) * sizeof (Index)
+            + this->constants.capacity() * sizeof (double);
+}
+
+FlatExpression flatten(const Expression &expr) throw (TraverseException) {
+    FlatExpression flat;
+    Flattener flattener(flat);
+    flattener.traversePostOrder(expr);
+    return flat;
+}
+
+
+FlatExpression flattenShared(const Expression &expr) throw (TraverseException) {
+    FlatExpression flat;
+    Flattener flattener(flat, true);
+    flattener.traversePostOrder(expr);
+    return flat;
+}
+
+namespace {
+
+typedef FlatExpression::Index Index;
+
+/**
+ * Append the text of the node in the same format as StringGenerator, written 
+ * top-down by an explicit stack.
+ *
+ * @param bindings Numbers of temporaries, nodes with non-zero number other
+ * than the given one are printed as names. Empty if there are no temporaries.
+ */
+void appendText(const FlatExpression &expr, Index root, const std::vector<Index> &bindings, int precision, std::string &output) {
+    auto isBound = [&](Index node) {
+        return node != root && !bindings.empty() && bindings[node] != 0;
+    };
+
+    struct Frame {
+        Index node;
+        unsigned int nextArg;
+    };
+    std::vector<Frame> stack = {{root, 0}};
+    while (!stack.empty()) {
+        Frame &frame = stack.back();
+        ExpressionType type = expr.type(frame.node);
+        if (isBound(frame.node)) {
+            output += "t";
+            output += std::to_string(bindings[frame.node]);
+            stack.pop_back();
+            continue;
+        }
+        if (type == EConstant) {
+            char buffer[maxNumberLength];
+            output.append(buffer, formatNumber(expr.value(frame.node), precision, buffer));
+            stack.pop_back();
+            continue;
+        }
+        if (type == EVariable) {
+            output += expr.name(frame.node);
+            stack.pop_back();
+            continue;
+        }
+
+        Index args[2] = {expr.lArg(frame.node), expr.rArg(frame.node)};
+        unsigned int argCount = isFunction(type) ? 1 : 2;
+        if (frame.nextArg > 0) {
+            // returned from the argument
+            unsigned int index = frame.nextArg - 1;
+            if (argCount == 1 || (isOperation(expr.type(args[index])) && !isBound(args[index]))) {
+                output += ")";
+            }
+            if (argCount == 2 && index == 0) {
+                output += symbolOf(type);
+            }
+        }
+        if (frame.nextArg == argCount) {
+            stack.pop_back();
+            continue;
+        }
+
+        Index arg = args[frame.nextArg];
+        if (argCount == 1) {
+            output += symbolOf(type);
+            output += "(";
+        } else if (isOperation(expr.type(arg)) && !isBound(arg)) {
+            output += "(";
+        }
+        frame.nextArg++;
+        stack.push_back({arg, 0});
+    }
+}
+
+}
+
+std::string to_string(const FlatExpression &expr, int precision) {
+    if (expr.size() == 0) {
+        return "?";
+    }
+
+    std::string output;
+    appendText(expr, expr.root(), {}, precision, output);
+    return output;
+}
+
+void printLet(std::ostream &out, const FlatExpression &expr, int precision) {
+    if (expr.size() == 0) {
+        out << "?";
+        return;
+    }
+
+    // uses of the nodes reachable from the root, arguments precede nodes
+    Index root = expr.root();
+    std::vector<Index> uses(root + 1, 0);
+    uses[root] = 1;
+    for (Index node = root + 1; node-- > 0;) {
+        ExpressionType type = expr.type(node);
+        if (uses[node] == 0 || type == EConstant || type == EVariable) {
+            continue;
+        }
+        uses[expr.lArg(node)]++;
+        if (expr.rArg(node) != FlatExpression::none) {
+            uses[expr.rArg(node)]++;
+        }
+    }
+
+    std::vector<Index> bindings(root + 1, 0);
+    Index count = 0;
+    std::string output;
+    for (Index node = 0; node < root; node++) {
+        ExpressionType type = expr.type(node);
+        if (uses[node] < 2 || type == EConstant || type == EVariable) {
+            continue;
+        }
+        bindings[node] = ++count;
+        output += "t";
+        output += std::to_string(count);
+        output += " = ";
+        appendText(expr, node, bindings, precision, output);
+        output += "; ";
+        out << output;
+        output.clear();
+    }
+
+    if (count > 0) {
+        output += "result = ";
+    }
+    appendText(expr, root, bindings, precision, output);
+    out << output;
+}
+
+std::string to_let_string(const FlatExpression &expr, int precision) {
+    std::ostringstream out;
+    printLet(out, expr, precision);
+    return out.str();
+}
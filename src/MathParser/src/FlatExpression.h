@@ -0,0 +1,231 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file FlatExpression.h
+ *
+ * Definition of FlatExpression, the contiguous representation of expressions.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#ifndef FLATEXPRESSION_H
+#define FLATEXPRESSION_H
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+#include "Expression.h"
+#include "SymbolTable.h"
+#include "Numbers.h"
+#include "TraverseException.h"
+
+/**
+ * Expression tree stored as a struct of arrays.
+ *
+ * Every node is an index into three parallel arrays: the type of the node and
+ * two 32-bit indices of arguments (the second one is unused by functions).
+ * Constant refers to the constant pool by the first index instead, Variable
+ * holds its identifier in SymbolTable::global(). A node takes 9 bytes, compared to 50-80 bytes
+ * of a heap-allocated Expression.
+ *
+ * Arguments are always appended before the node itself, so the nodes are in
+ * post-order and the last one is the root. Bottom-up algorithms (like
+ * differentiation) therefore are plain loops over the arrays. A node can
+ * be the argument of several nodes, i.e. common subexpressions are shared.
+ *
+ * Only complete expressions can be represented.
+ */
+class FlatExpression {
+public:
+    typedef std::uint32_t Index;
+
+    /**
+     * Value of the unused argument index of functions and leaves.
+     */
+    static const Index none = UINT32_MAX;
+
+    /**
+     * Type and arguments of an operation or a function, nodes with equal keys
+     * are identical subexpressions if their arguments are merged already.
+     */
+    struct NodeKey {
+        ExpressionType type;
+        Index lArg;
+        Index rArg;
+
+        bool operator==(const NodeKey &other) const {
+            return this->type == other.type && this->lArg == other.lArg && this->rArg == other.rArg;
+        }
+    };
+
+    struct NodeKeyHash {
+        size_t operator()(const NodeKey &key) const {
+            return (static_cast<size_t> (key.type) * 1000003u + key.lArg) * 1000003u + key.rArg;
+        }
+    };
+
+private:
+    std::vector<std::uint8_t> types; // ExpressionType
+    std::vector<Index> lArgs; // left or the only argument, position in the pool for leaves
+    std::vector<Index> rArgs;
+    std::vector<double> constants;
+    std::vector<SymbolReference> symbols; // names of the Variable's, they are not evicted meanwhile
+
+    void checkArgument(Index arg) const throw (TraverseException);
+
+public:
+    /**
+     * Append a Constant.
+     *
+     * @return Index of the node.
+     */
+    Index addConstant(double value);
+
+    /**
+     * Append a Variable, the name is interned in SymbolTable::global().
+     *
+     * @return Index of the node.
+     * @throws TraverseException if the SymbolTable is full.
+     */
+    Index addVariable(const std::string &name) throw (TraverseException);
+
+    /**
+     * Append a Variable of the interned name.
+     *
+     * @return Index of the node.
+     */
+    Index addVariable(SymbolId symbol);
+
+    /**
+     * Append an operation or a function.
+     *
+     * @param type Type of the node, neither EConstant nor EVariable.
+     * @param lArg Index of the left (or the only) argument.
+     * @param rArg Index of the right argument, none for functions.
+     * @return Index of the node.
+     * @throw TraverseException if the arguments do not precede the node.
+     */
+    Index addNode(ExpressionType type, Index lArg, Index rArg = none) throw (TraverseException);
+
+    /**
+     * Allocate the memory for the given number of nodes.
+     */
+    void reserve(size_t size);
+
+    /**
+     * @return Number of nodes.
+     */
+    size_t size() const;
+
+    /**
+     * @return Index of the root (the last node).
+     */
+    Index root() const;
+
+    ExpressionType type(Index node) const;
+
+    /**
+     * @return Index of the left (or the only) argument.
+     */
+    Index lArg(Index node) const;
+
+    /**
+     * @return Index of the right argument.
+     */
+    Index rArg(Index node) const;
+
+    /**
+     * @return Value of the Constant.
+     */
+    double value(Index node) const;
+
+    /**
+     * @return Identifier of the name of the Variable.
+     */
+    SymbolId symbol(Index node) const;
+
+    /**
+     * @return Name of the Variable.
+     */
+    const std::string &name(Index node) const;
+
+    /**
+     * Copy the nodes reachable from the given one, in the same order. The given
+     * node becomes the root.
+     *
+     * @param newRoot Root of the result.
+     * @return The expression without unreachable nodes.
+     */
+    FlatExpression compact(Index newRoot) const;
+
+    /**
+     * Build the Expression tree, shared nodes give shared subtrees.
+     *
+     * @return Root of the tree, nullptr for the empty expression.
+     */
+    PExpression toExpression() const;
+
+    /**
+     * @return Number of bytes allocated by the expression.
+     */
+    size_t memoryUsage() const;
+};
+
+/**
+ * Convert the tree to the flat representation, without recursion.
+ *
+ * @param expr Root of the tree.
+ * @return The flat expression.
+ * @throw TraverseException if the tree is incomplete.
+ */
+FlatExpression flatten(const Expression &expr) throw (TraverseException);
+
+/**
+ * Convert the tree to the flat representation where every distinct 
+ * subexpression is one node.
+ *
+ * Subtrees shared by several nodes of the tree are traversed once, so the time
+ * is linear in the number of distinct objects even if the printed tree is 
+ * exponentially larger. Identical subtrees (different objects) are merged.
+ *
+ * @param expr Root of the tree.
+ * @return The flat expression without duplicate nodes.
+ * @throw TraverseException if the tree is incomplete.
+ */
+FlatExpression flattenShared(const Expression &expr) throw (TraverseException);
+
+/**
+ * The text of the flat expression, the same as to_string() of the tree.
+ * 
+ * @param expr The expression.
+ * @param precision Number of significant digits of constants.
+ */
+std::string to_string(const FlatExpression &expr, int precision = defaultNumberPrecision);
+
+/**
+ * Print the expression with let-bindings: operations and functions used more 
+ * than once are printed once as temporaries t1, t2, ... and referred by name,
+ * e.g. "t1 = x^2; t2 = cos(t1); result = t2*t2". The expression without such
+ * nodes is printed as by to_string(). 
+ *
+ * The output is linear in the number of nodes, apply to the result of 
+ * flattenShared() to bind identical subtrees as well. Every binding is written
+ * to the stream as soon as it is generated.
+ *
+ * @param out The output stream.
+ * @param expr The expression.
+ * @param precision Number of significant digits of constants.
+ */
+void printLet(std::ostream &out, const FlatExpression &expr, int precision = defaultNumberPrecision);
+
+/**
+ * The text of printLet().
+ */
+std::string to_let_string(const FlatExpression &expr, int precision = defaultNumberPrecision);
+
+#endif /* FLATEXPRESSION_H */
@@ -0,0 +1,192 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file IntrusivePointer.h
+ *
+ * Smart pointer with the reference counter stored in the object.
+ *
+ * Counting is not atomic, so pointers to the same object must not be copied
+ * or destroyed by several threads at once. In return copying a pointer is a
+ * plain increment, there is no control block and no separate allocation.
+ * Pointer to "this" is created directly from the object.
+ *
+ * @author  agor
+ * @since 18.10.2026
+ */
+
+#ifndef INTRUSIVEPOINTER_H
+#define INTRUSIVEPOINTER_H
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+/**
+ * Base of objects managed by IntrusivePointer.
+ */
+class IntrusiveTarget {
+private:
+    mutable unsigned long referenceCount;
+
+    template <typename T> friend class IntrusivePointer;
+
+protected:
+    IntrusiveTarget() : referenceCount(0) {
+    }
+
+    // a copy is a new object, it is not referenced yet
+    IntrusiveTarget(const IntrusiveTarget &) : referenceCount(0) {
+    }
+
+    IntrusiveTarget &operator=(const IntrusiveTarget &) {
+        return *this;
+    }
+
+public:
+    virtual ~IntrusiveTarget() {
+    }
+};
+
+template <typename T>
+class IntrusivePointer {
+private:
+    T *object;
+
+    template <typename U> friend class IntrusivePointer;
+
+    void acquire() const {
+        if (this->object != nullptr) {
+            static_cast<const IntrusiveTarget *> (this->object)->referenceCount++;
+        }
+    }
+
+    void release() {
+        if (this->object != nullptr && --static_cast<const IntrusiveTarget *> (this->object)->referenceCount == 0) {
+            delete static_cast<const IntrusiveTarget *> (this->object);
+        }
+        this->object = nullptr;
+    }
+
+    template <typename U>
+    using EnableIfConvertible = typename std::enable_if<std::is_convertible<U *, T *>::value>::type;
+
+public:
+    typedef T element_type;
+
+    IntrusivePointer() : object(nullptr) {
+    }
+
+    IntrusivePointer(std::nullptr_t) : object(nullptr) {
+    }
+
+    /**
+     * Take the object, it may be already referenced by other pointers.
+     */
+    explicit IntrusivePointer(T *object) : object(object) {
+        this->acquire();
+    }
+
+    IntrusivePointer(const IntrusivePointer &other) : object(other.object) {
+        this->acquire();
+    }
+
+    IntrusivePointer(IntrusivePointer &&other) noexcept : object(other.object) {
+        other.object = nullptr;
+    }
+
+    template <typename U, typename = EnableIfConvertible<U>>
+    IntrusivePointer(const IntrusivePointer<U> &other) : object(other.object) {
+        this->acquire();
+    }
+
+    template <typename U, typename = EnableIfConvertible<U>>
+    IntrusivePointer(IntrusivePointer<U> &&other) noexcept : object(other.object) {
+        other.object = nullptr;
+    }
+
+    ~IntrusivePointer() {
+        this->release();
+    }
+
+    IntrusivePointer &operator=(IntrusivePointer other) noexcept {
+        this->swap(other);
+        return *this;
+    }
+
+    void swap(IntrusivePointer &other) noexcept {
+        std::swap(this->object, other.object);
+    }
+
+    void reset() {
+        this->release();
+    }
+
+    T *get() const {
+        return this->object;
+    }
+
+    T &operator*() const {
+        return *this->object;
+    }
+
+    T *operator->() const {
+        return this->object;
+    }
+
+    explicit operator bool() const {
+        return this->object != nullptr;
+    }
+
+    long use_count() const {
+        return this->object == nullptr ? 0 : static_cast<const IntrusiveTarget *> (this->object)->referenceCount;
+    }
+};
+
+template <typename T, typename U>
+inline bool operator==(const IntrusivePointer<T> &a, const IntrusivePointer<U> &b) {
+    return a.get() == b.get();
+}
+
+template <typename T, typename U>
+inline bool operator!=(const IntrusivePointer<T> &a, const IntrusivePointer<U> &b) {
+    return a.get() != b.get();
+}
+
+template <typename T>
+inline bool operator==(const IntrusivePointer<T> &a, std::nullptr_t) {
+    return a.get() == nullptr;
+}
+
+template <typename T>
+inline bool operator==(std::nullptr_t, const IntrusivePointer<T> &a) {
+    return a.get() == nullptr;
+}
+
+template <typename T>
+inline bool operator!=(const IntrusivePointer<T> &a, std::nullptr_t) {
+    return a.get() != nullptr;
+}
+
+template <typename T>
+inline bool operator!=(std::nullptr_t, const IntrusivePointer<T> &a) {
+    return a.get() != nullptr;
+}
+
+/**
+ * Counterpart of std::enable_shared_from_this, the counter is already in the object.
+ */
+template <typename T>
+class EnableIntrusiveFromThis {
+public:
+    IntrusivePointer<T> shared_from_this() {
+        return IntrusivePointer<T>(static_cast<T *> (this));
+    }
+
+    IntrusivePointer<const T> shared_from_this() const {
+        return IntrusivePointer<const T>(static_cast<const T *> (this));
+    }
+};
+
+#endif /* INTRUSIVEPOINTER_H */
@@ -13,11 +13,16 @@
 
 #include "Ln.h"
 #include "Visitor.h"
+#include "ReferenceVisitor.h"
 #include "TraverseException.h"
 
 Ln::Ln() : Expression(ELn) {
 }
 
+Ln::~Ln() {
+    releaseArgument(this->arg);
+}
+
 bool Ln::isComplete() const {
     return (this->arg!=nullptr);
 }
@@ -26,4 +31,8 @@ void Ln::traverse(Visitor& visitor) const throw(TraverseException) {
     visitor.visit(shared_from_this());
 }
 
+void Ln::accept(ReferenceVisitor &visitor) const throw (TraverseException) {
+    visitor.visit(*this);
+}
+
 
@@ -0,0 +1,119 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file LruCache.h
+ *
+ * Definition of the bounded cache which evicts the least recently used entry.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#ifndef LRUCACHE_H
+#define LRUCACHE_H
+
+#include <cstddef>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+/**
+ * Counters of lookups in a cache.
+ */
+struct CacheStatistics {
+    size_t hits = 0;
+    size_t misses = 0;
+    size_t evictions = 0;
+
+    /**
+     * @return Share of lookups which found the entry, 0 if there were none.
+     */
+    double hitRate() const {
+        size_t lookups = this->hits + this->misses;
+        return lookups == 0 ? 0.0 : static_cast<double> (this->hits) / lookups;
+    }
+};
+
+/**
+ * Map of at most capacity entries, adding to the full cache evicts the entry
+ * which has not been found or added for the longest time.
+ *
+ * Lookups and updates take constant time. The cache is not thread-safe.
+ */
+template <typename K, typename V, typename H = std::hash<K>>
+class LruCache {
+private:
+    typedef std::list<std::pair<K, V>> Entries;
+
+    const size_t capacity;
+    Entries entries; // the most recently used first
+    std::unordered_map<K, typename Entries::iterator, H> index;
+    CacheStatistics statistics;
+
+public:
+
+    explicit LruCache(size_t capacity) : capacity(capacity) {
+    }
+
+    /**
+     * Find the value and mark it as the most recently used.
+     *
+     * @return The value, nullptr if the key is not in the cache. The pointer
+     * is valid until the entry is evicted.
+     */
+    const V *find(const K &key) {
+        auto found = this->index.find(key);
+        if (found == this->index.end()) {
+            this->statistics.misses++;
+            return nullptr;
+        }
+        this->statistics.hits++;
+        this->entries.splice(this->entries.begin(), this->entries, found->second);
+        return &found->second->second;
+    }
+
+    /**
+     * Add the entry or replace the value of the key, the entry becomes the
+     * most recently used.
+     */
+    void put(const K &key, V value) {
+        if (this->capacity == 0) {
+            return;
+        }
+        auto found = this->index.find(key);
+        if (found != this->index.end()) {
+            found->second->second = std::move(value);
+            this->entries.splice(this->entries.begin(), this->entries, found->second);
+            return;
+        }
+        if (this->entries.size() == this->capacity) {
+            this->index.erase(this->entries.back().first);
+            this->entries.pop_back();
+            this->statistics.evictions++;
+        }
+        this->entries.emplace_front(key, std::move(value));
+        this->index.emplace(key, this->entries.begin());
+    }
+
+    void clear() {
+        this->entries.clear();
+        this->index.clear();
+    }
+
+    size_t size() const {
+        return this->entries.size();
+    }
+
+    size_t getCapacity() const {
+        return this->capacity;
+    }
+
+    const CacheStatistics &getStatistics() const {
+        return this->statistics;
+    }
+};
+
+#endif /* LRUCACHE_H */
@@ -13,15 +13,25 @@
 
 #include "Mult.h"
 #include "Visitor.h"
+#include "ReferenceVisitor.h"
 #include "TraverseException.h"
 
 Mult::Mult() : Expression(EMult) {
 }
 
+Mult::~Mult() {
+    releaseArgument(this->lArg);
+    releaseArgument(this->rArg);
+}
+
 void Mult::traverse(Visitor &visitor) const throw (TraverseException) {
     visitor.visit(shared_from_this());
 }
 
+void Mult::accept(ReferenceVisitor &visitor) const throw (TraverseException) {
+    visitor.visit(*this);
+}
+
 bool Mult::isComplete() const {
     return (this->lArg != nullptr && this->rArg != nullptr);
 }
\ No newline at end of file
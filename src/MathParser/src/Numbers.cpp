@@ -0,0 +1,175 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file Numbers.cpp
+ *
+ * Implementation of the conversion of numbers.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#include "Numbers.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <clocale>
+#include <string>
+
+namespace {
+
+const double exactPowersOf10[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+};
+
+const int maxExactPower = 22;
+const std::uint64_t maxExactMantissa = 1ull << 53;
+
+bool isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+/**
+ * Conversion of numbers, which are not exactly representable by the mantissa 
+ * and a power of 10. It is rare enough to allow the allocation.
+ */
+double parseByStrtod(const char *begin, const char *end) {
+    // strtod() expects the decimal point of the current C locale
+    std::string text;
+    for (const char *c = begin; c != end; c++) {
+        if (*c == '.' || *c == ',') {
+            text += std::localeconv()->decimal_point;
+        } else {
+            text += *c;
+        }
+    }
+    return std::strtod(text.c_str(), nullptr);
+}
+
+}
+
+const char *parseNumber(const char *begin, const char *end, double &value) {
+    const char *pos = begin;
+    bool negative = false;
+    if (pos != end && (*pos == '+' || *pos == '-')) {
+        negative = (*pos == '-');
+        pos++;
+    }
+
+    std::uint64_t mantissa = 0;
+    int significantDigits = 0;
+    int exponent = 0; // decimal exponent of the mantissa
+    int digits = 0;
+    bool separator = false;
+    for (; pos != end; pos++) {
+        if (isDigit(*pos)) {
+            digits++;
+            if (mantissa == 0 && *pos == '0') {
+                // leading zeros are not significant
+            } else if (significantDigits < 19) {
+                mantissa = mantissa * 10 + (*pos - '0');
+                significantDigits++;
+            } else {
+                // the rest of digits do not fit, the number is not exact anyway
+                significantDigits++;
+                exponent++;
+            }
+            if (separator) {
+                exponent--;
+            }
+        } else if ((*pos == '.' || *pos == ',') && !separator) {
+            separator = true;
+        } else {
+            break;
+        }
+    }
+    if (digits == 0) {
+        return begin;
+    }
+
+    if (pos != end && (*pos == 'e' || *pos == 'E')) {
+        const char *exponentPos = pos + 1;
+        bool negativeExponent = false;
+        if (exponentPos != end && (*exponentPos == '+' || *exponentPos == '-')) {
+            negativeExponent = (*exponentPos == '-');
+            exponentPos++;
+        }
+        if (exponentPos != end && isDigit(*exponentPos)) {
+            int explicitExponent = 0;
+            for (; exponentPos != end && isDigit(*exponentPos); exponentPos++) {
+                if (explicitExponent < 100000) {
+                    explicitExponent = explicitExponent * 10 + (*exponentPos - '0');
+                }
+            }
+            exponent += negativeExponent ? -explicitExponent : explicitExponent;
+            pos = exponentPos;
+        }
+    }
+
+    if (mantissa == 0) {
+        value = negative ? -0.0 : 0.0;
+    } else if (significantDigits <= 19 && mantissa <= maxExactMantissa 
+            && exponent >= -maxExactPower && exponent <= maxExactPower) {
+        // both the mantissa and the power are exact, so is the result (Clinger's fast path)
+        value = static_cast<double> (mantissa);
+        value = exponent < 0 ? value / exactPowersOf10[-exponent] : value * exactPowersOf10[exponent];
+        value = negative ? -value : value;
+    } else {
+        value = parseByStrtod(begin, pos);
+    }
+    return pos;
+}
+
+char *formatNumber(double value, int precision, char *buffer) {
+    if (precision < 1) {
+        precision = 1;
+    } else if (precision > maxNumberPrecision) {
+        precision = maxNumberPrecision;
+    }
+
+    double magnitude = std::fabs(value);
+    if (magnitude < exactPowersOf10[precision] && magnitude == std::floor(magnitude)) {
+        // integers are written as they are, this is the usual case
+        char digits[maxNumberLength];
+        char *digit = digits + maxNumberLength;
+        std::uint64_t integer = static_cast<std::uint64_t> (magnitude);
+        do {
+            *--digit = static_cast<char> ('0' + integer % 10);
+            integer /= 10;
+        } while (integer != 0);
+
+        char *out = buffer;
+        if (std::signbit(value)) {
+            *out++ = '-';
+        }
+        size_t length = digits + maxNumberLength - digit;
+        std::memcpy(out, digit, length);
+        return out + length;
+    }
+
+    int length = std::snprintf(buffer, maxNumberLength, "%.*g", precision, value);
+    if (length < 0) {
+        return buffer;
+    }
+    char *end = buffer + length;
+
+    // printf uses the decimal point of the C locale, which can be changed by setlocale()
+    const char *point = std::localeconv()->decimal_point;
+    size_t pointLength = std::strlen(point);
+    if (pointLength > 0 && !(pointLength == 1 && point[0] == '.')) {
+        char *found = std::search(buffer, end, point, point + pointLength);
+        if (found != end) {
+            *found = '.';
+            std::memmove(found + 1, found + pointLength, end - found - pointLength);
+            end -= pointLength - 1;
+        }
+    }
+    return end;
+}
@@ -0,0 +1,66 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file Numbers.h
+ *
+ * Conversion of numbers from and to the text without streams.
+ *
+ * Both directions do not depend on the locale and do not allocate memory 
+ * in the common case, like std::from_chars() and std::to_chars() of C++17.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#ifndef NUMBERS_H
+#define NUMBERS_H
+
+#include <cstddef>
+
+/**
+ * Size of the buffer for formatNumber().
+ */
+const size_t maxNumberLength = 32;
+
+/**
+ * Number of significant digits of constants in the text of expressions.
+ */
+const int defaultNumberPrecision = 2;
+
+/**
+ * Maximal number of significant digits of formatNumber(), more do not make 
+ * sense for double.
+ */
+const int maxNumberPrecision = 17;
+
+/**
+ * Parse the decimal number [+-]digits[.digits][(e|E)[+-]digits], the decimal
+ * separator can be either '.' or ','.
+ *
+ * Numbers of up to 15 significant digits (and the decimal exponent up to 22)
+ * are converted exactly by integer arithmetic, longer ones by strtod().
+ *
+ * @param begin Beginning of the text.
+ * @param end End of the text.
+ * @param value [out] The number, it is infinite if the number is out of range.
+ * @return Position after the number, begin if there is no number.
+ */
+const char *parseNumber(const char *begin, const char *end, double &value);
+
+/**
+ * Write the number with the given number of significant digits, the same way 
+ * as printf("%.*g") in the classic locale (and std::ostream with default 
+ * floatfield) does.
+ *
+ * @param value The number.
+ * @param precision Number of significant digits, it is limited by 
+ * 1 and maxNumberPrecision.
+ * @param buffer [out] The text without terminating zero, at least
+ * maxNumberLength characters.
+ * @return Position after the text in the buffer.
+ */
+char *formatNumber(double value, int precision, char *buffer);
+
+#endif /* NUMBERS_H */
@@ -0,0 +1,72 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file ParseCache.cpp
+ *
+ * Implementation of the cache of parsed expressions.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#include "ParseCache.h"
+
+#include "Parser.h"
+
+const size_t ParseCache::defaultCapacity;
+
+ParseCache::ParseCache(size_t capacity) : cache(capacity) {
+}
+
+PExpression ParseCache::parse(const std::string &strExpr) throw (ParsingException) {
+    std::string key = normalize(strExpr);
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        const PExpression *found = this->cache.find(key);
+        if (found != nullptr) {
+            return *found;
+        }
+    }
+
+    // other threads are not blocked while parsing
+    PExpression expr = ::parse(key);
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->cache.put(key, expr);
+    return expr;
+}
+
+Expected<PExpression> ParseCache::tryParse(const std::string &strExpr) {
+    std::string key = normalize(strExpr);
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        const PExpression *found = this->cache.find(key);
+        if (found != nullptr) {
+            return *found;
+        }
+    }
+
+    Expected<PExpression> expr = ::tryParse(key);
+    if (expr) {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->cache.put(key, expr.getValue());
+    }
+    return expr;
+}
+
+CacheStatistics ParseCache::getStatistics() {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->cache.getStatistics();
+}
+
+std::string ParseCache::normalize(const std::string &strExpr) {
+    std::string result;
+    result.reserve(strExpr.size());
+    for (char c : strExpr) {
+        if (c != ' ' && c != '\t') {
+            result += c;
+        }
+    }
+    return result;
+}
@@ -0,0 +1,69 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file ParseCache.h
+ *
+ * Definition of the cache of parsed expressions.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#ifndef PARSECACHE_H
+#define PARSECACHE_H
+
+#include <mutex>
+#include <string>
+
+#include "Expected.h"
+#include "Expression.h"
+#include "LruCache.h"
+#include "ParsingException.h"
+
+/**
+ * Bounded cache in front of parse(), the key is the text without spaces and
+ * tabs (they are skipped by the parser anyway).
+ *
+ * Repeated texts are not tokenized and parsed again, all callers get the same
+ * tree, which must not be modified. Texts which can not be parsed are not
+ * cached. The cache is thread-safe, but with the non-atomic reference counting
+ * (see isSPointerThreadSafe) trees must not be passed between threads.
+ */
+class ParseCache {
+private:
+    std::mutex mutex;
+    LruCache<std::string, PExpression> cache;
+
+public:
+    static const size_t defaultCapacity = 1024;
+
+    explicit ParseCache(size_t capacity = defaultCapacity);
+
+    /**
+     * Parse the expression string or take the tree of the same text from the
+     * cache.
+     *
+     * @param strExpr input string.
+     * @return Root of the shared Expression tree.
+     */
+    PExpression parse(const std::string &strExpr) throw (ParsingException);
+
+    /**
+     * Like parse(), errors are returned instead of thrown (see ::tryParse()).
+     */
+    Expected<PExpression> tryParse(const std::string &strExpr);
+
+    /**
+     * @return Counters of hits, misses and evictions since the creation.
+     */
+    CacheStatistics getStatistics();
+
+    /**
+     * @return The text without spaces and tabs.
+     */
+    static std::string normalize(const std::string &strExpr);
+};
+
+#endif /* PARSECACHE_H */
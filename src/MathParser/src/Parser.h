@@ -16,8 +16,15 @@
 
 #include <string>
 #include "ParsingException.h"
+#include "Expected.h"
 #include "Expression.h"
 
+/**
+ * Maximal number of nested parentheses (including the ones of functions),
+ * deeper expressions are rejected by parse(), tryParse() and checkSyntax().
+ */
+const unsigned int maxNestingDepth = 1000;
+
 /**
  * Parse the expression string.
  *
@@ -26,6 +33,41 @@
  */
 PExpression parse(const std::string &strExpr) throw (ParsingException);
 
+/**
+ * Parse the expression string, errors are returned instead of thrown.
+ *
+ * Invalid characters, numbers and brackets, missing operands and arguments, too deep nesting
+ * and expressions which can not be reduced are detected without exceptions, so
+ * rejecting malformed input is about as cheap as parsing it. The message is the one of ParsingException
+ * without the debug context.
+ *
+ * @param strExpr input string.
+ * @return Root of the Expression tree or the Failure::Parsing.
+ */
+Expected<PExpression> tryParse(const std::string &strExpr);
+
+/**
+ * Result of checkSyntax().
+ */
+struct SyntaxCheck {
+    bool isValid;
+    /** Offset of the first error in the string. */
+    size_t position;
+    /** The message of ParsingException without the context, nullptr if valid. */
+    const char *reason;
+};
+
+/**
+ * Check whether parse() accepts the string, without building the tree.
+ *
+ * The tokens are reduced by the same grammar as in parse(), on shapes of
+ * expressions instead of allocated nodes, which is several times faster.
+ *
+ * @param strExpr input string.
+ * @return The first error of parse(), if any.
+ */
+SyntaxCheck checkSyntax(const std::string &strExpr);
+
 
 #endif /* PARSER_H */
 
@@ -10,6 +10,8 @@
  * @since 25.03.2016
  * @Author: agor
  */
+#include <cmath>
+
 #include "ExceptionThrower.h"
 #include "Parser.h"
 #include "ParserImpl.h"
@@ -18,6 +20,7 @@
 #include "Token.h"
 #include "Constant.h"
 #include "Variable.h"
+#include "SymbolTable.h"
 #include "Sum.h"
 #include "Sub.h"
 #include "Div.h"
@@ -42,6 +45,7 @@
 #include "RuleFunction.h"
 #include "RuleNoSignMult.h"
 #include "ExpressionFactory.h"
+#include "Numbers.h"
 
 #include "ParserStack.h"
 
@@ -84,7 +88,7 @@ ParserImpl::ParserImpl() {
     this->grammar[n++] = make_unique<RuleSubRV>();
 }
 
-bool ParserImpl::isAlpha(char c) const {
+bool ParserImpl::isAlpha(char c) {
     // assuming ASCII
 
     if (c >= 'a' && c <= 'z') {
@@ -98,7 +102,7 @@ bool ParserImpl::isAlpha(char c) const {
     return false;
 }
 
-bool ParserImpl::isNumeric(char c) const {
+bool ParserImpl::isNumeric(char c) {
     // assuming ASCII
 
     if ((c >= '0' && c <= '9') || c == '.' || c == ',') {
@@ -108,19 +112,19 @@ bool ParserImpl::isNumeric(char c) const {
     return false;
 }
 
-bool ParserImpl::isGroupBracket(char c) const {
+bool ParserImpl::isGroupBracket(char c) {
     return (c == '(' || c == ')');
 }
 
-bool ParserImpl::isArithOperation(char c) const {
+bool ParserImpl::isArithOperation(char c) {
     return (c == '+' || c == '-' || c == '*' || c == '/' || c == '\\' || c == '^');
 }
 
-bool ParserImpl::isWhitespace(char c) const {
+bool ParserImpl::isWhitespace(char c) {
     return (c == ' ' || c == '\t');
 }
 
-list<Token> ParserImpl::getTokens(const string &strExpr) const {
+list<Token> ParserImpl::getTokens(const string &strExpr, ParsingError &error) const {
     list<Token> tokens;
 
     /**
@@ -152,7 +156,8 @@ list<Token> ParserImpl::getTokens(const string &strExpr) const {
             // ignore
             continue;
         } else {
-            THROW(ParsingException, "Unknown character.", "'" + to_string(c) + "'");
+            error.set("Unknown character.", "'" + to_string(c) + "'");
+            return tokens;
         }
 
         if (tokenType != tokenTypeOfSymbol || tokenType == TGroupBracket) {
@@ -180,13 +185,16 @@ list<Token> ParserImpl::getTokens(const string &strExpr) const {
     return tokens;
 }
 
-bool ParserImpl::doReduce(ParserStack &stack, const Token &lookAheadToken) const {
+bool ParserImpl::doReduce(ParserStack &stack, const Token &lookAheadToken, ParsingError &error) const {
     // go through the list of rules and check if it is applicable to the provided stack
     for (auto &rule : this->grammar) {
         // try to apply the rule to reduce the stack
-        if (rule->apply(stack, lookAheadToken)) {
+        if (rule->apply(stack, lookAheadToken, error)) {
             return true;
         }
+        if (error.isSet) {
+            return false;
+        }
     }
 
     return false;
@@ -229,49 +237,56 @@ PExpression ParserImpl::createFunction(const string opSymbol) const throw (Parsi
     return createExp();
 }
 
-list<Token>::const_iterator ParserImpl::findEndOfParentheses(list<Token>::const_iterator start, list<Token>::const_iterator end) const throw (ParsingException) {
+list<Token>::const_iterator ParserImpl::findEndOfParentheses(list<Token>::const_iterator start, list<Token>::const_iterator end, ParsingError &error) const {
     int openingBrackets = 1; // we already have so far one oppening bracket
     int closingBrackets = 0; // ...and it is not yet closed
-    string trace = "";
 
-    while (start != end) {
-        trace += start->value;
-
-        if (start->type != TGroupBracket) {
-            ++start;
+    for (list<Token>::const_iterator current = start; current != end; ++current) {
+        if (current->type != TGroupBracket) {
             continue;
         }
 
-        if (start->value == "(") {
+        if (current->value == "(") {
             openingBrackets++;
         }
 
-        if (start->value == ")") {
+        if (current->value == ")") {
             closingBrackets++;
         }
 
         if (openingBrackets == closingBrackets) {
             // fount it
-            return start;
+            return current;
         }
-
-        ++start;
     }
 
     // ops, brackets are not closed
-    THROW(ParsingException, "No closing bracket has been found.", trace);
+    // the trace is collected only now, since every nested bracket scans the rest of the tokens
+    string trace = "";
+    for (; start != end; ++start) {
+        trace += start->value;
+    }
+    error.set("No closing bracket has been found.", trace);
+    return end;
 }
 
-list<Token>::const_iterator ParserImpl::shiftToStack(list<Token>::const_iterator current, list<Token>::const_iterator end, ParserStack &stack) const throw (ParsingException) {
+list<Token>::const_iterator ParserImpl::shiftToStack(list<Token>::const_iterator current, list<Token>::const_iterator end, ParserStack &stack, unsigned int depth, ParsingError &error) const {
     Token token = *current;
 
     PExpression stackExpression;
     if (TNumeric == token.type) {
-        try {
-            stackExpression = createConstant(token.value);
-        } catch (std::exception &ex) {
-            THROW(ParsingException, string("Not a number token. (") + ex.what() + ")", token.value);
+        const char *first = token.value.data();
+        const char *last = first + token.value.size();
+        double value;
+        if (parseNumber(first, last, value) != last) {
+            error.set("Not a number token.", token.value);
+            return end;
         }
+        if (std::isinf(value)) {
+            error.set("Not a number token. (The number is out of range)", token.value);
+            return end;
+        }
+        stackExpression = createConstant(value);
     } else if (TOperation == token.type) {
         stackExpression = createOperation(token.value);
     } else if (TAlphaNumeric == token.type) {
@@ -280,20 +295,39 @@ list<Token>::const_iterator ParserImpl::shiftToStack(list<Token>::const_iterator
             stackExpression = createFunction(token.value);
         } else {
             // assuming it is a variable
-            stackExpression = createVariable(token.value);
+            SymbolId symbol = SymbolTable::global().intern(token.value);
+            if (symbol == SymbolTable::none) {
+                error.set("Too many names of variables.", token.value);
+                return end;
+            }
+            stackExpression = createVariable(symbol);
+            SymbolTable::global().release(symbol);
         }
     } else if (TGroupBracket == token.type) {
         // it must be an opening bracket
         if (current->value == ")") {
-            THROW(ParsingException, "Unexpected closing bracket ')'.", "N.A.");
+            error.set("Unexpected closing bracket ')'.", "N.A.");
+            return end;
+        }
+        // the parentheses are parsed recursively, bound the depth of the call stack
+        if (depth >= maxNestingDepth) {
+            error.set("The expression is nested too deeply.", "More than " + to_string(maxNestingDepth) + " levels of parentheses.");
+            return end;
         }
         ParserStack subStack;
         ++current; // this one is bracket - take the next one
         if (current == end) {
-            THROW(ParsingException, "Unexpect end of the expression.", "No closing bracket at the end of the string.");
+            error.set("Unexpect end of the expression.", "No closing bracket at the end of the string.");
+            return end;
+        }
+        list<Token>::const_iterator endParentheses = findEndOfParentheses(current, end, error);
+        if (error.isSet) {
+            return end;
+        }
+        this->doParseTokens(current, endParentheses, subStack, depth + 1, error);
+        if (error.isSet) {
+            return end;
         }
-        list<Token>::const_iterator endParentheses = findEndOfParentheses(current, end);
-        this->doParseTokens(current, endParentheses, subStack);
         stackExpression = subStack.front();
         current = endParentheses;
     }
@@ -316,21 +350,27 @@ Token ParserImpl::getLookAheadToken(list<Token>::const_iterator current, list<To
     return Token("eof", TNoToken);
 }
 
-void ParserImpl::doParseTokens(list<Token>::const_iterator start, list<Token>::const_iterator end, ParserStack &stack) const throw (ParsingException) {
+void ParserImpl::doParseTokens(list<Token>::const_iterator start, list<Token>::const_iterator end, ParserStack &stack, unsigned int depth, ParsingError &error) const {
     // opened question: can this function to be called recursively
 
     // LR parsing => shift-reduce method (bottom-up)
     // the method is chosen since it considers only forward scanning of tokens 
 
     while (start != end) {
-        start = shiftToStack(start, end, stack);
+        start = shiftToStack(start, end, stack, depth, error);
+        if (error.isSet) {
+            return;
+        }
 
         Token lookAheadToken = getLookAheadToken(start, end);
 
         // reduce the stack untill no other posibility to reduce is available
-        while (this->doReduce(stack, lookAheadToken)) {
+        while (this->doReduce(stack, lookAheadToken, error)) {
             // ???
         }
+        if (error.isSet) {
+            return;
+        }
     }
 
     // at the end we should have only one element in the stack that means
@@ -340,21 +380,52 @@ void ParserImpl::doParseTokens(list<Token>::const_iterator start, list<Token>::c
         // then probably grammar is not complete
         // or the syntax of the provided expression is incorrect
 
-        THROW(ParsingException, "The specified expression is ambiguous. Not able to completely reduce syntax tree.", to_string(stack));
+        error.set("The specified expression is ambiguous. Not able to completely reduce syntax tree.", to_string(stack));
+    } else if (!stack.front()->isComplete()) {
+        // e.g. "x+" or "sin", the tree would be rejected by the differentiator and optimizer
+        error.set("The expression is incomplete. An operand or argument is missing.", to_string(stack));
     }
 }
 
-PExpression ParserImpl::parseTokens(const list<Token> &tokens) const {
+PExpression ParserImpl::parseTokens(const list<Token> &tokens, ParsingError &error) const {
     ParserStack stack;
-    this->doParseTokens(tokens.begin(), tokens.end(), stack);
-    return stack.front();
+    this->doParseTokens(tokens.begin(), tokens.end(), stack, 0, error);
+    return error.isSet ? nullptr : stack.front();
+}
+
+PExpression ParserImpl::doParse(const string &strExpr, ParsingError &error) const {
+    list<Token> tokens = this->getTokens(strExpr, error);
+    if (error.isSet) {
+        return nullptr;
+    }
+    return this->parseTokens(tokens, error);
 }
 
 const PExpression ParserImpl::parse(const string &strExpr) const throw (ParsingException) {
-    return this->parseTokens(this->getTokens(strExpr));
+    ParsingError error;
+    PExpression expr = this->doParse(strExpr, error);
+    if (error.isSet) {
+        THROW(ParsingException, error.message, error.context);
+    }
+    return expr;
+}
+
+Expected<PExpression> ParserImpl::tryParse(const string &strExpr) const {
+    ParsingError error;
+    PExpression expr = this->doParse(strExpr, error);
+    if (!error.isSet) {
+        return expr;
+    }
+    // the same text as of ParsingException, without the debug context
+    return Failure{Failure::Parsing, error.message + " Context: " + error.context};
 }
 
 PExpression parse(const std::string &strExpr) throw (ParsingException) {
     ParserImpl parserImpl;
     return parserImpl.parse(strExpr);
+}
+
+Expected<PExpression> tryParse(const std::string &strExpr) {
+    ParserImpl parserImpl;
+    return parserImpl.tryParse(strExpr);
 }
\ No newline at end of file
@@ -19,6 +19,7 @@
 #include <string>
 
 #include "ParsingException.h"
+#include "Expected.h"
 #include "Expression.h"
 
 class ParserStack;
@@ -36,36 +37,6 @@ class ParserImpl {
 private:
     array<unique_ptr<Rule>, 17> grammar;
 
-    /**
-     * @brief Determine whether the symbol is an alphabetic character.
-     * @return True/False
-     */
-    bool isAlpha(char c) const;
-
-    /**
-     * @brief Determine whether the symbol is a number.
-     * @return True/False
-     */
-    bool isNumeric(char c) const;
-
-    /**
-     * @brief Determine whether the symbol is a grouping/functional brackets '(' ')'.
-     * @return True/False
-     */
-    bool isGroupBracket(char c) const;
-
-    /**
-     * @brief Determine whether the symbol is a arithmetic operation.
-     * @return True/False
-     */
-    bool isArithOperation(char c) const;
-
-    /**
-     * @brief Determine whether the symbol is a whitespace character.
-     * @return True/False
-     */
-    bool isWhitespace(char c) const;
-    
     /**
      * Search for the closing bracket in the list of Tokens 
      * 
@@ -74,9 +45,11 @@ private:
      * @param [in]	start Iterator for starting token - next token after the opening bracket.
      * @param [in]	end Iterator for last available token in the list.
      * 
-     * @return const_iterator pointing to the corresponding closing bracket.
+     * @param [out]	error Set if the bracket is not closed.
+     * 
+     * @return const_iterator pointing to the corresponding closing bracket, end if there is none.
      */
-    list<Token>::const_iterator findEndOfParentheses(list<Token>::const_iterator start, list<Token>::const_iterator end) const throw (ParsingException);
+    list<Token>::const_iterator findEndOfParentheses(list<Token>::const_iterator start, list<Token>::const_iterator end, ParsingError &error) const;
 
     /**
      * Parse some part of the tokens.
@@ -84,18 +57,21 @@ private:
      * @param [in]	start Iterator for starting token
      * @param [in]	end Iterator for last token.
      * @param [in/out]	Stack of parsed non-terminals.
+     * @param [in]	depth Number of the enclosing parentheses.
+     * @param [out]	error Set if the tokens can not be parsed.
      */
-    void doParseTokens(list<Token>::const_iterator start, list<Token>::const_iterator end, ParserStack &stack) const throw (ParsingException);
+    void doParseTokens(list<Token>::const_iterator start, list<Token>::const_iterator end, ParserStack &stack, unsigned int depth, ParsingError &error) const;
 
     /**
      * Reduce the currant stack of non terminals.
      * 
      * @param [in/out]	Stack of parsed non-terminals.
+     * @param [out]	error Set if a rule finds the stack malformed.
      * 
      * @return true		If the stack was reduced.
      * @return false	If the stack was not reduced.
      */
-    bool doReduce(ParserStack &stack, const Token &lookAheadToken) const;
+    bool doReduce(ParserStack &stack, const Token &lookAheadToken, ParsingError &error) const;
 
     Token getLookAheadToken(list<Token>::const_iterator current, list<Token>::const_iterator end) const;
 
@@ -109,10 +85,12 @@ private:
      * @param [in] current Current (staerting) position in the list of tokens.
      * @param [in] end The end position in the list of tokent.
      * @param [out] stack The stack of parser to be extended,.
+     * @param [in] depth Number of the enclosing parentheses.
+     * @param [out] error Set if the token is not valid.
      * 
      * @return New iterator position in the list of tokens.
      */
-    list<Token>::const_iterator shiftToStack(list<Token>::const_iterator current, list<Token>::const_iterator end, ParserStack &stack) const throw (ParsingException);
+    list<Token>::const_iterator shiftToStack(list<Token>::const_iterator current, list<Token>::const_iterator end, ParserStack &stack, unsigned int depth, ParsingError &error) const;
 
     /**
      * @brief Split the input string into tokens.
@@ -120,22 +98,61 @@ private:
      * For instance: a+b*c => 'a', '+', 'b', '*', 'c'.
      * 
      * @param strExpr
+     * @param [out] error Set if the string contains an unknown character.
      * 
      * @return The list of Tokens
      */
-    list<Token> getTokens(const string &strExpr) const;
+    list<Token> getTokens(const string &strExpr, ParsingError &error) const;
 
     /**
      * @brief Analyze grammatically the list of tokens and build syntax tree.
      * @param tokenList The list of tokens.
-     * @return Expression tree.
+     * @param [out] error Set if the tokens can not be parsed.
+     * @return Expression tree, nullptr on error.
      */
-    PExpression parseTokens(const list<Token> &tokens) const;
+    PExpression parseTokens(const list<Token> &tokens, ParsingError &error) const;
+
+    /**
+     * Parse the string, the errors are reported without exceptions.
+     */
+    PExpression doParse(const string &strExpr, ParsingError &error) const;
     
 public:
     ParserImpl();
 
+    /**
+     * @brief Determine whether the symbol is an alphabetic character.
+     * @return True/False
+     */
+    static bool isAlpha(char c);
+
+    /**
+     * @brief Determine whether the symbol is a number.
+     * @return True/False
+     */
+    static bool isNumeric(char c);
+
+    /**
+     * @brief Determine whether the symbol is a grouping/functional brackets '(' ')'.
+     * @return True/False
+     */
+    static bool isGroupBracket(char c);
+
+    /**
+     * @brief Determine whether the symbol is a arithmetic operation.
+     * @return True/False
+     */
+    static bool isArithOperation(char c);
+
+    /**
+     * @brief Determine whether the symbol is a whitespace character.
+     * @return True/False
+     */
+    static bool isWhitespace(char c);
+
     const PExpression parse(const string &strExpr) const throw (ParsingException);
+
+    Expected<PExpression> tryParse(const string &strExpr) const;
 };
 
 #endif /* PARSERIMPL_H */
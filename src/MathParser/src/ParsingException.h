@@ -28,5 +28,22 @@ public:
 	virtual const char* what() const noexcept;
 };
 
+/**
+ * The first error of parsing: the message and the context of ParsingException.
+ */
+struct ParsingError {
+	bool isSet = false;
+	string message;
+	string context;
+
+	void set(const string &message, const string &context) {
+		if (!this->isSet) {
+			this->isSet = true;
+			this->message = message;
+			this->context = context;
+		}
+	}
+};
+
 #endif	/* PARSINGEXCEPTION_H */
 
@@ -19,6 +19,48 @@
 #define POINTERS_H
 
 #include <memory>
+#include <utility>
+
+#ifdef USE_INTRUSIVE_SPOINTER
+
+#include "IntrusivePointer.h"
+
+/**
+ *  Wrapper for pointers (aka smart pointer).
+ * 
+ * The intrusive backend: reference counter is not atomic, it is stored in the 
+ * object (see IntrusivePointer.h). Intended for single-threaded pipelines.
+ */
+template <typename T>
+using SPointer = IntrusivePointer<T>;
+
+/**
+ * Wrapper to allow "this" pointers.
+ */
+template <typename T>
+using EnableSPointerFromThis = EnableIntrusiveFromThis<T>;
+
+/**
+ * Base of objects which are pointed by SPointer.
+ */
+typedef IntrusiveTarget SPointerTarget;
+
+/**
+ * Whether pointers to the same object can be copied by several threads at once.
+ */
+constexpr bool isSPointerThreadSafe = false;
+
+template <typename T, typename T1>
+inline SPointer<T> SPointerCast(const SPointer<T1> &p){
+    return SPointer<T>(dynamic_cast<T *>(p.get()));
+}
+
+template <typename T, typename... _Args >
+inline SPointer<T> MakeSPointer(_Args&&... _args){
+    return SPointer<T>(new T(std::forward<_Args>(_args)...));
+}
+
+#else
 
 /**
  *  Wrapper for pointers (aka smart pointer).
@@ -34,6 +76,17 @@ using SPointer = std::shared_ptr<T>;
 template <typename T>
 using EnableSPointerFromThis = std:: enable_shared_from_this<T>;
 
+/**
+ * Base of objects which are pointed by SPointer, nothing is required by std::shared_ptr.
+ */
+class SPointerTarget {
+};
+
+/**
+ * Whether pointers to the same object can be copied by several threads at once.
+ */
+constexpr bool isSPointerThreadSafe = true;
+
 /**
  * Casting from one Spointer type to an other.
  * 
@@ -47,20 +100,23 @@ using EnableSPointerFromThis = std:: enable_shared_from_this<T>;
  * @return The casted pointer to the object.
  */
 template <typename T, typename T1>
-inline  SPointer<T> SPointerCast(const SPointer<T1> p){
+inline  SPointer<T> SPointerCast(const SPointer<T1> &p){
     return std::dynamic_pointer_cast<T>(p);
 }
 
 /**
+ * Create the object and the pointer to it, arguments are forwarded to the constructor.
  * 
- * @param _args
+ * @param _args Arguments of the constructor of T.
  * 
- * @return 
+ * @return Pointer to the new object.
  */
 template <typename T, typename... _Args >
 inline  SPointer<T> MakeSPointer(_Args&&... _args){
-    return (std::make_shared<T>(_args...));
+    return (std::make_shared<T>(std::forward<_Args>(_args)...));
 }
 
+#endif /* USE_INTRUSIVE_SPOINTER */
+
 #endif /* POINTERS_H */
 
@@ -0,0 +1,160 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file PostOrderVisitor.h
+ *
+ * Definition of PostOrderVisitor.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#ifndef POSTORDERVISITOR_H
+#define POSTORDERVISITOR_H
+
+#include <vector>
+#include <unordered_map>
+#include "Visitor.h"
+#include "ReferenceVisitor.h"
+
+/**
+ * Base class for visitors which calculate a result for every node of the syntax
+ * tree out of the results of its arguments.
+ *
+ * Unlike the plain Visitor, which recurses once per level of the tree, the tree
+ * is traversed here with an explicit stack of nodes and a buffer of results of
+ * arguments, both are located in the heap. Therefore arbitrarily deep trees can 
+ * be processed within a fixed budget of the native stack.
+ *
+ * Subclasses implement postVisit() for every type of Expression. Results of
+ * arguments are passed by reference and may be moved away. Visitors which
+ * produce their output in order (like StringGenerator) can also override 
+ * beforeArgument() and afterArgument(). A missing argument
+ * of an incomplete expression gets the default value R(), it is up to postVisit()
+ * to check the expression with isComplete().
+ *
+ * The methods visit() of Visitor and ReferenceVisitor are implemented here: each
+ * of them traverses the whole subtree, the result is available by 
+ * getLastVisitResult(). Nodes are visited by reference, pointers to them are
+ * neither created nor copied.
+ * 
+ * It is a templated class (see .tpp for the implementation).
+ *
+ * @param R Type of the result of a node.
+ */
+template <typename R>
+class PostOrderVisitor : public Visitor, public ReferenceVisitor {
+private:
+
+    struct Frame {
+        const Expression *expr; ///< nullptr for a missing argument
+        unsigned int nextArg; ///< index of the next argument to be traversed
+    };
+
+    R result;
+
+    std::vector<Frame> stack; // kept between traversals to reuse the memory
+    std::vector<R> results;
+
+    const std::unordered_map<const Expression *, R> *precomputed = nullptr;
+
+    /**
+     * Call postVisit() for the node of the given type.
+     */
+    R dispatch(const Expression &expr, R *args) throw (TraverseException);
+
+protected:
+    virtual R postVisit(const Constant &expr) throw (TraverseException) = 0;
+    virtual R postVisit(const Variable &expr) throw (TraverseException) = 0;
+    virtual R postVisit(const Sum &expr, R &lArg, R &rArg) throw (TraverseException) = 0;
+    virtual R postVisit(const Sub &expr, R &lArg, R &rArg) throw (TraverseException) = 0;
+    virtual R postVisit(const Div &expr, R &lArg, R &rArg) throw (TraverseException) = 0;
+    virtual R postVisit(const Mult &expr, R &lArg, R &rArg) throw (TraverseException) = 0;
+    virtual R postVisit(const Pow &expr, R &lArg, R &rArg) throw (TraverseException) = 0;
+    virtual R postVisit(const Sin &expr, R &arg) throw (TraverseException) = 0;
+    virtual R postVisit(const Cos &expr, R &arg) throw (TraverseException) = 0;
+    virtual R postVisit(const Tan &expr, R &arg) throw (TraverseException) = 0;
+    virtual R postVisit(const Ctan &expr, R &arg) throw (TraverseException) = 0;
+    virtual R postVisit(const Ln &expr, R &arg) throw (TraverseException) = 0;
+    virtual R postVisit(const Exp &expr, R &arg) throw (TraverseException) = 0;
+
+    /**
+     * Called before the argument of the expression is traversed, does nothing
+     * by default.
+     *
+     * @param expr The expression.
+     * @param index Index of the argument (0 - left or the only one, 1 - right).
+     */
+    virtual void beforeArgument(const Expression &expr, unsigned int index) throw (TraverseException);
+
+    /**
+     * Called after the argument of the expression has been traversed, does 
+     * nothing by default.
+     *
+     * @param expr The expression.
+     * @param index Index of the argument (0 - left or the only one, 1 - right).
+     */
+    virtual void afterArgument(const Expression &expr, unsigned int index) throw (TraverseException);
+
+public:
+    virtual ~PostOrderVisitor() {
+    }
+
+    /**
+     * Traverse the tree without recursion.
+     *
+     * Can be called from postVisit() to process another tree, the traversal
+     * in progress is not affected.
+     *
+     * @param expr Root of the tree.
+     * @return Result of postVisit() for the root.
+     */
+    R traversePostOrder(const Expression &expr) throw (TraverseException);
+
+    void visit(const PConstConstant &expr) throw (TraverseException) final;
+    void visit(const PConstVariable &expr) throw (TraverseException) final;
+    void visit(const PConstSum &expr) throw (TraverseException) final;
+    void visit(const PConstSub &expr) throw (TraverseException) final;
+    void visit(const PConstDiv &expr) throw (TraverseException) final;
+    void visit(const PConstMult &expr) throw (TraverseException) final;
+    void visit(const PConstPow &expr) throw (TraverseException) final;
+    void visit(const PConstSin &expr) throw (TraverseException) final;
+    void visit(const PConstCos &expr) throw (TraverseException) final;
+    void visit(const PConstTan &expr) throw (TraverseException) final;
+    void visit(const PConstCtan &expr) throw (TraverseException) final;
+    void visit(const PConstLn &expr) throw (TraverseException) final;
+    void visit(const PConstExp &expr) throw (TraverseException) final;
+
+    void visit(const Constant &expr) throw (TraverseException) final;
+    void visit(const Variable &expr) throw (TraverseException) final;
+    void visit(const Sum &expr) throw (TraverseException) final;
+    void visit(const Sub &expr) throw (TraverseException) final;
+    void visit(const Div &expr) throw (TraverseException) final;
+    void visit(const Mult &expr) throw (TraverseException) final;
+    void visit(const Pow &expr) throw (TraverseException) final;
+    void visit(const Sin &expr) throw (TraverseException) final;
+    void visit(const Cos &expr) throw (TraverseException) final;
+    void visit(const Tan &expr) throw (TraverseException) final;
+    void visit(const Ctan &expr) throw (TraverseException) final;
+    void visit(const Ln &expr) throw (TraverseException) final;
+    void visit(const Exp &expr) throw (TraverseException) final;
+
+    /**
+     * Use results calculated beforehand (e.g. by other threads) for the given 
+     * subtrees instead of traversing them.
+     *
+     * @param precomputed Results of subtrees, nullptr to traverse everything.
+     * The map must live until traversals are finished.
+     */
+    void setPrecomputedResults(const std::unordered_map<const Expression *, R> *precomputed);
+
+    void setLastVisitResult(const R &result);
+    R getLastVisitResult() const;
+};
+
+// include the implementation of the template.
+#include "PostOrderVisitor.tpp"
+
+#endif /* POSTORDERVISITOR_H */
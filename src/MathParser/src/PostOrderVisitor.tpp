@@ -0,0 +1,262 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file PostOrderVisitor.tpp
+ *
+ * @brief Implementation of PostOrderVisitor.
+ *
+ * @since 18.10.2026
+ * @author agor
+ */
+
+#include <utility>
+#include "ExceptionThrower.h"
+
+template <typename R>
+R PostOrderVisitor<R>::dispatch(const Expression &expr, R *args) throw (TraverseException) {
+    switch (expr.getType()) {
+        case EConstant:
+            return this->postVisit(static_cast<const Constant &> (expr));
+        case EVariable:
+            return this->postVisit(static_cast<const Variable &> (expr));
+        case ESum:
+            return this->postVisit(static_cast<const Sum &> (expr), args[0], args[1]);
+        case ESub:
+            return this->postVisit(static_cast<const Sub &> (expr), args[0], args[1]);
+        case EDiv:
+            return this->postVisit(static_cast<const Div &> (expr), args[0], args[1]);
+        case EMult:
+            return this->postVisit(static_cast<const Mult &> (expr), args[0], args[1]);
+        case EPow:
+            return this->postVisit(static_cast<const Pow &> (expr), args[0], args[1]);
+        case ESin:
+            return this->postVisit(static_cast<const Sin &> (expr), args[0]);
+        case ECos:
+            return this->postVisit(static_cast<const Cos &> (expr), args[0]);
+        case ETan:
+            return this->postVisit(static_cast<const Tan &> (expr), args[0]);
+        case ECtan:
+            return this->postVisit(static_cast<const Ctan &> (expr), args[0]);
+        case ELn:
+            return this->postVisit(static_cast<const Ln &> (expr), args[0]);
+        case EExp:
+            return this->postVisit(static_cast<const Exp &> (expr), args[0]);
+    }
+    THROW(TraverseException, "Unknown type of expression", "N.A.");
+}
+
+template <typename R>
+R PostOrderVisitor<R>::traversePostOrder(const Expression &expr) throw (TraverseException) {
+    // nested traversals (from postVisit()) continue above the frames of the 
+    // traversal in progress
+    const size_t stackBottom = this->stack.size();
+    const size_t resultsBottom = this->results.size();
+
+    try {
+        this->stack.push_back({&expr, 0});
+        while (this->stack.size() > stackBottom) {
+            // copy, hooks may start a nested traversal which reallocates the stack
+            Frame frame = this->stack.back();
+            if (frame.expr == nullptr) {
+                this->stack.pop_back();
+                this->results.push_back(R());
+                continue;
+            }
+
+            if (frame.nextArg == 0 && this->precomputed != nullptr) {
+                auto found = this->precomputed->find(frame.expr);
+                if (found != this->precomputed->end()) {
+                    this->stack.pop_back();
+                    this->results.push_back(found->second);
+                    continue;
+                }
+            }
+
+            const Expression &node = *frame.expr;
+            const Expression * args[2];
+            unsigned int argCount = argumentsOf(node, args);
+            if (frame.nextArg > 0) {
+                // returned from the previous argument
+                this->afterArgument(node, frame.nextArg - 1);
+            }
+            if (frame.nextArg < argCount) {
+                this->stack.back().nextArg++;
+                this->beforeArgument(node, frame.nextArg);
+                this->stack.push_back({args[frame.nextArg], 0});
+                continue;
+            }
+
+            this->stack.pop_back();
+            // postVisit() may start a nested traversal, which reallocates the buffer
+            R argResults[2];
+            for (unsigned int n = 0; n < argCount; n++) {
+                argResults[n] = std::move(this->results[this->results.size() - argCount + n]);
+            }
+            this->results.resize(this->results.size() - argCount);
+            this->results.push_back(this->dispatch(node, argResults));
+        }
+    } catch (...) {
+        this->stack.resize(stackBottom);
+        this->results.resize(resultsBottom);
+        throw;
+    }
+
+    R rootResult = std::move(this->results.back());
+    this->results.pop_back();
+    return rootResult;
+}
+
+template <typename R>
+void PostOrderVisitor<R>::beforeArgument(const Expression &, unsigned int) throw (TraverseException) {
+}
+
+template <typename R>
+void PostOrderVisitor<R>::afterArgument(const Expression &, unsigned int) throw (TraverseException) {
+}
+
+template <typename R>
+void PostOrderVisitor<R>::visit(const PConstConstant &expr) throw (TraverseException) {
+    this->setLastVisitResult(this->traversePostOrder(*expr));
+}
+
+template <typename R>
+void PostOrderVisitor<R>::visit(const PConstVariable &expr) throw (TraverseException) {
+    this->setLastVisitResult(this->traversePostOrder(*expr));
+}
+
+template <typename R>
+void PostOrderVisitor<R>::visit(const PConstSum &expr) throw (TraverseException) {
+    this->setLastVisitResult(this->traversePostOrder(*expr));
+}
+
+template <typename R>
+void PostOrderVisitor<R>::visit(const PConstSub &expr) throw (TraverseException) {
+    this->setLastVisitResult(this->traversePostOrder(*expr));
+}
+
+template <typename R>
+void PostOrderVisitor<R>::visit(const PConstDiv &expr) throw (TraverseException) {
+    this->setLastVisitResult(this->traversePostOrder(*expr));
+}
+
+template <typename R>
+void PostOrderVisitor<R>::visit(const PConstMult &expr) throw (TraverseException) {
+    this->setLastVisitResult(this->traversePostOrder(*expr));
+}
+
+template <typename R>
+void PostOrderVisitor<R>::visit(const PConstPow &expr) throw (TraverseException) {
+    this->setLastVisitResult(this->traversePostOrder(*expr));
+}
+
+template <typename R>
+void PostOrderVisitor<R>::visit(const PConstSin &expr) throw (TraverseException) {
+    this->setLastVisitResult(this->traversePostOrder(*expr));
+}
+
+template <typename R>
+void PostOrderVisitor<R>::visit(const PConstCos &expr) throw (TraverseException) {
+    this->setLastVisitResult(this->traversePostOrder(*expr));
+}
+
+template <typename R>
+void PostOrderVisitor<R>::visit(const PConstTan &expr) throw (TraverseException) {
+    this->setLastVisitResult(this->traversePostOrder(*expr));
+}
+
+template <typename R>
+void PostOrderVisitor<R>::visit(const PConstCtan &expr) throw (TraverseException) {
+    this->setLastVisitResult(this->traversePostOrder(*expr));
+}
+
+template <typename R>
+void PostOrderVisitor<R>::visit(const PConstLn &expr) throw (TraverseException) {
+    this->setLastVisitResult(this->traversePostOrder(*expr));
+}
+
+template <typename R>
+void PostOrderVisitor<R>::visit(const PConstExp &expr) throw (TraverseException) {
+    this->setLastVisitResult(this->traversePostOrder(*expr));
+}
+
+template <typename R>
+void PostOrderVisitor<R>::visit(const Constant &expr) throw (TraverseException) {
+    this->setLastVisitResult(this->traversePostOrder(expr));
+}
+
+template <typename R>
+void PostOrderVisitor<R>::visit(const Variable &expr) throw (TraverseException) {
+    this->setLastVisitResult(this->traversePostOrder(expr));
+}
+
+template <typename R>
+void PostOrderVisitor<R>::visit(const Sum &expr) throw (TraverseException) {
+    this->setLastVisitResult(this->traversePostOrder(expr));
+}
+
+template <typename R>
+void PostOrderVisitor<R>::visit(const Sub &expr) throw (TraverseException) {
+    this->setLastVisitResult(this->traversePostOrder(expr));
+}
+
+template <typename R>
+void PostOrderVisitor<R>::visit(const Div &expr) throw (TraverseException) {
+    this->setLastVisitResult(this->traversePostOrder(expr));
+}
+
+template <typename R>
+void PostOrderVisitor<R>::visit(const Mult &expr) throw (TraverseException) {
+    this->setLastVisitResult(this->traversePostOrder(expr));
+}
+
+template <typename R>
+void PostOrderVisitor<R>::visit(const Pow &expr) throw (TraverseException) {
+    this->setLastVisitResult(this->traversePostOrder(expr));
+}
+
+template <typename R>
+void PostOrderVisitor<R>::visit(const Sin &expr) throw (TraverseException) {
+    this->setLastVisitResult(this->traversePostOrder(expr));
+}
+
+template <typename R>
+void PostOrderVisitor<R>::visit(const Cos &expr) throw (TraverseException) {
+    this->setLastVisitResult(this->traversePostOrder(expr));
+}
+
+template <typename R>
+void PostOrderVisitor<R>::visit(const Tan &expr) throw (TraverseException) {
+    this->setLastVisitResult(this->traversePostOrder(expr));
+}
+
+template <typename R>
+void PostOrderVisitor<R>::visit(const Ctan &expr) throw (TraverseException) {
+    this->setLastVisitResult(this->traversePostOrder(expr));
+}
+
+template <typename R>
+void PostOrderVisitor<R>::visit(const Ln &expr) throw (TraverseException) {
+    this->setLastVisitResult(this->traversePostOrder(expr));
+}
+
+template <typename R>
+void PostOrderVisitor<R>::visit(const Exp &expr) throw (TraverseException) {
+    this->setLastVisitResult(this->traversePostOrder(expr));
+}
+
+template <typename R>
+void PostOrderVisitor<R>::setPrecomputedResults(const std::unordered_map<const Expression *, R> *precomputed) {
+    this->precomputed = precomputed;
+}
+
+template <typename R>
+void PostOrderVisitor<R>::setLastVisitResult(const R &result) {
+    this->result = result;
+}
+
+template <typename R>
+R PostOrderVisitor<R>::getLastVisitResult() const {
+    return this->result;
+}
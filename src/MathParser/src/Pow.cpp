@@ -13,15 +13,25 @@
 
 #include "Pow.h"
 #include "Visitor.h"
+#include "ReferenceVisitor.h"
 #include "TraverseException.h"
 
 Pow::Pow() : Expression(EPow){
 }
 
+Pow::~Pow() {
+    releaseArgument(this->lArg);
+    releaseArgument(this->rArg);
+}
+
 void Pow::traverse(Visitor &visitor) const throw(TraverseException) {
     visitor.visit(shared_from_this());
 }
 
+void Pow::accept(ReferenceVisitor &visitor) const throw (TraverseException) {
+    visitor.visit(*this);
+}
+
 bool Pow::isComplete() const {
     return (this->lArg != nullptr && this->rArg != nullptr);
 }
@@ -25,9 +25,11 @@ public:
     PExpression rArg;
     
     Pow();
+    ~Pow();
     
     bool isComplete() const final;
     void traverse(Visitor&) const throw(TraverseException) final;
+    void accept(ReferenceVisitor &) const throw (TraverseException) final;
 };
 
 // shortcuts for pointers
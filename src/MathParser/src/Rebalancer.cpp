@@ -0,0 +1,170 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file Rebalancer.cpp
+ *
+ * Implementation of the balanced re-association of sums and products.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#include <vector>
+
+#include "Rebalancer.h"
+#include "PostOrderVisitor.h"
+#include "ExpressionFactory.h"
+
+namespace {
+
+/**
+ * Copies the tree bottom-up. A Sum (Mult) whose parent is a Sum (Mult) is copied
+ * as is, the top node of the chain collects the operands of the copied chain and
+ * rebuilds it.
+ */
+class Rebalancer : public PostOrderVisitor<PExpression> {
+private:
+    const unsigned int minChainLength;
+
+    std::vector<ExpressionType> parents; // types of ancestors of the current node
+    std::vector<PExpression> operands;
+    std::vector<PExpression> pending;
+
+    bool isChainContinued(ExpressionType type) const {
+        return !this->parents.empty() && this->parents.back() == type;
+    }
+
+    /**
+     * Collect operands of the chain from left to right.
+     *
+     * @return false if one of operands is missing.
+     */
+    template <typename T>
+    bool collectOperands(const PExpression &top, ExpressionType type) {
+        this->operands.clear();
+        this->pending.clear();
+        this->pending.push_back(top);
+        while (!this->pending.empty()) {
+            PExpression node = this->pending.back();
+            this->pending.pop_back();
+            if (node == nullptr) {
+                return false;
+            }
+            if (node->getType() != type) {
+                this->operands.push_back(node);
+                continue;
+            }
+            // the right argument first to get the left one from the stack first
+            const T &op = static_cast<const T &>(*node);
+            this->pending.push_back(op.rArg);
+            this->pending.push_back(op.lArg);
+        }
+        return true;
+    }
+
+    /**
+     * Build the balanced tree of operands [begin, end), the depth of the
+     * recursion is logarithmic.
+     */
+    template <typename T>
+    PExpression build(size_t begin, size_t end, SPointer<T> (*create)(PExpression, PExpression)) {
+        if (end - begin == 1) {
+            return this->operands[begin];
+        }
+        size_t middle = begin + (end - begin) / 2;
+        return create(this->build<T>(begin, middle, create), this->build<T>(middle, end, create));
+    }
+
+    template <typename T>
+    PExpression chain(ExpressionType type, PExpression &lArg, PExpression &rArg, SPointer<T> (*create)(PExpression, PExpression)) {
+        PExpression copy = create(lArg, rArg);
+        if (this->isChainContinued(type)) {
+            return copy;
+        }
+
+        // an incomplete chain is kept, otherwise the missing argument would move
+        if (!this->collectOperands<T>(copy, type) || this->operands.size() < this->minChainLength) {
+            return copy;
+        }
+        PExpression balanced = this->build<T>(0, this->operands.size(), create);
+        this->operands.clear();
+        return balanced;
+    }
+
+protected:
+    PExpression postVisit(const Constant &expr) throw (TraverseException) final {
+        return createConstant(expr.value);
+    }
+
+    PExpression postVisit(const Variable &expr) throw (TraverseException) final {
+        return createVariable(expr.symbol);
+    }
+
+    PExpression postVisit(const Sum &, PExpression &lArg, PExpression &rArg) throw (TraverseException) final {
+        return this->chain<Sum>(ESum, lArg, rArg, createSum);
+    }
+
+    PExpression postVisit(const Sub &, PExpression &lArg, PExpression &rArg) throw (TraverseException) final {
+        return createSub(lArg, rArg);
+    }
+
+    PExpression postVisit(const Div &, PExpression &lArg, PExpression &rArg) throw (TraverseException) final {
+        return createDiv(lArg, rArg);
+    }
+
+    PExpression postVisit(const Mult &, PExpression &lArg, PExpression &rArg) throw (TraverseException) final {
+        return this->chain<Mult>(EMult, lArg, rArg, createMult);
+    }
+
+    PExpression postVisit(const Pow &, PExpression &lArg, PExpression &rArg) throw (TraverseException) final {
+        return createPow(lArg, rArg);
+    }
+
+    PExpression postVisit(const Sin &, PExpression &arg) throw (TraverseException) final {
+        return createSin(arg);
+    }
+
+    PExpression postVisit(const Cos &, PExpression &arg) throw (TraverseException) final {
+        return createCos(arg);
+    }
+
+    PExpression postVisit(const Tan &, PExpression &arg) throw (TraverseException) final {
+        return createTan(arg);
+    }
+
+    PExpression postVisit(const Ctan &, PExpression &arg) throw (TraverseException) final {
+        return createCtan(arg);
+    }
+
+    PExpression postVisit(const Ln &, PExpression &arg) throw (TraverseException) final {
+        return createLn(arg);
+    }
+
+    PExpression postVisit(const Exp &, PExpression &arg) throw (TraverseException) final {
+        return createExp(arg);
+    }
+
+    void beforeArgument(const Expression &expr, unsigned int) throw (TraverseException) final {
+        this->parents.push_back(expr.getType());
+    }
+
+    void afterArgument(const Expression &, unsigned int) throw (TraverseException) final {
+        this->parents.pop_back();
+    }
+
+public:
+    Rebalancer(unsigned int minChainLength) : minChainLength(minChainLength) {
+    }
+};
+
+}
+
+PExpression rebalance(const PExpression expr, unsigned int minChainLength) throw (TraverseException) {
+    if (expr == nullptr) {
+        return expr;
+    }
+    Rebalancer rebalancer(minChainLength);
+    return rebalancer.traversePostOrder(*expr);
+}
@@ -0,0 +1,46 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file Rebalancer.h
+ *
+ * Definition of the balanced re-association of sums and products.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#ifndef REBALANCER_H
+#define REBALANCER_H
+
+#include "Expression.h"
+
+/**
+ * Chains with fewer operands are left as they are by rebalance().
+ */
+const unsigned int defaultMinChainLength = 16;
+
+/**
+ * Re-associate chains of sums and products to trees of logarithmic depth.
+ *
+ * The parser builds a + b + c + d as ((a + b) + c) + d, so a sum of n terms is
+ * a tree of depth n. Here every maximal chain of Sum (or Mult) nodes is collected
+ * and rebuilt as a balanced tree (a + b) + (c + d). The operands keep their
+ * order from left to right, therefore the result is the same expression up
+ * to the associativity of + and *. Chains shorter than minChainLength
+ * and incomplete chains are kept in their original shape.
+ *
+ * Sub and Div are not associative and break chains, as well as functions: a
+ * chain inside sin() is balanced separately.
+ *
+ * The tree is traversed without recursion, the original tree is not modified.
+ *
+ * @param expr Root of the tree.
+ * @param minChainLength Minimal number of operands of a chain to be rebalanced.
+ *
+ * @return Root of the rebalanced tree.
+ */
+PExpression rebalance(const PExpression expr, unsigned int minChainLength = defaultMinChainLength) throw (TraverseException);
+
+#endif /* REBALANCER_H */
@@ -0,0 +1,69 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file ReferenceVisitor.cpp
+ *
+ * Implementation of VisitorAdapter.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#include "ReferenceVisitor.h"
+
+VisitorAdapter::VisitorAdapter(Visitor &visitor) : visitor(visitor) {
+}
+
+void VisitorAdapter::visit(const Constant &expr) throw (TraverseException) {
+    this->visitor.visit(expr.shared_from_this());
+}
+
+void VisitorAdapter::visit(const Variable &expr) throw (TraverseException) {
+    this->visitor.visit(expr.shared_from_this());
+}
+
+void VisitorAdapter::visit(const Sum &expr) throw (TraverseException) {
+    this->visitor.visit(expr.shared_from_this());
+}
+
+void VisitorAdapter::visit(const Sub &expr) throw (TraverseException) {
+    this->visitor.visit(expr.shared_from_this());
+}
+
+void VisitorAdapter::visit(const Div &expr) throw (TraverseException) {
+    this->visitor.visit(expr.shared_from_this());
+}
+
+void VisitorAdapter::visit(const Mult &expr) throw (TraverseException) {
+    this->visitor.visit(expr.shared_from_this());
+}
+
+void VisitorAdapter::visit(const Pow &expr) throw (TraverseException) {
+    this->visitor.visit(expr.shared_from_this());
+}
+
+void VisitorAdapter::visit(const Sin &expr) throw (TraverseException) {
+    this->visitor.visit(expr.shared_from_this());
+}
+
+void VisitorAdapter::visit(const Cos &expr) throw (TraverseException) {
+    this->visitor.visit(expr.shared_from_this());
+}
+
+void VisitorAdapter::visit(const Tan &expr) throw (TraverseException) {
+    this->visitor.visit(expr.shared_from_this());
+}
+
+void VisitorAdapter::visit(const Ctan &expr) throw (TraverseException) {
+    this->visitor.visit(expr.shared_from_this());
+}
+
+void VisitorAdapter::visit(const Ln &expr) throw (TraverseException) {
+    this->visitor.visit(expr.shared_from_this());
+}
+
+void VisitorAdapter::visit(const Exp &expr) throw (TraverseException) {
+    this->visitor.visit(expr.shared_from_this());
+}
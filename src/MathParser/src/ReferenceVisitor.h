@@ -0,0 +1,75 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/** 
+ * @file   ReferenceVisitor.h
+ * 
+ * @brief Visitor interface which receives expressions by reference.
+ *
+ * @since 18.10.2026
+ * @author agor
+ */
+
+#ifndef REFERENCEVISITOR_H
+#define REFERENCEVISITOR_H
+
+#include "Visitor.h"
+
+/**
+ * Interface for visitors of the syntax tree which do not need pointers to 
+ * visited expressions (see Expression::accept()).
+ * 
+ * Visitor gets a new SPointer for every visited expression, created by 
+ * shared_from_this(). Here the expression is passed as it is, so no reference 
+ * counter is touched.
+ */
+class ReferenceVisitor {
+public:
+    virtual ~ReferenceVisitor() {
+    }
+
+    virtual void visit(const Constant &expr) throw (TraverseException) = 0;
+    virtual void visit(const Variable &expr) throw (TraverseException) = 0;
+    virtual void visit(const Sum &expr) throw (TraverseException) = 0;
+    virtual void visit(const Sub &expr) throw (TraverseException) = 0;
+    virtual void visit(const Div &expr) throw (TraverseException) = 0;
+    virtual void visit(const Mult &expr) throw (TraverseException) = 0;
+    virtual void visit(const Pow &expr) throw (TraverseException) = 0;
+    virtual void visit(const Sin &expr) throw (TraverseException) = 0;
+    virtual void visit(const Cos &expr) throw (TraverseException) = 0;
+    virtual void visit(const Tan &expr) throw (TraverseException) = 0;
+    virtual void visit(const Ctan &expr) throw (TraverseException) = 0;
+    virtual void visit(const Ln &expr) throw (TraverseException) = 0;
+    virtual void visit(const Exp &expr) throw (TraverseException) = 0;
+};
+
+/**
+ * Adapter to pass an existing Visitor to Expression::accept().
+ * 
+ * The pointer to the expression is created by shared_from_this(), as it is 
+ * done by Expression::traverse().
+ */
+class VisitorAdapter : public ReferenceVisitor {
+private:
+    Visitor &visitor;
+
+public:
+    VisitorAdapter(Visitor &visitor);
+
+    void visit(const Constant &expr) throw (TraverseException) final;
+    void visit(const Variable &expr) throw (TraverseException) final;
+    void visit(const Sum &expr) throw (TraverseException) final;
+    void visit(const Sub &expr) throw (TraverseException) final;
+    void visit(const Div &expr) throw (TraverseException) final;
+    void visit(const Mult &expr) throw (TraverseException) final;
+    void visit(const Pow &expr) throw (TraverseException) final;
+    void visit(const Sin &expr) throw (TraverseException) final;
+    void visit(const Cos &expr) throw (TraverseException) final;
+    void visit(const Tan &expr) throw (TraverseException) final;
+    void visit(const Ctan &expr) throw (TraverseException) final;
+    void visit(const Ln &expr) throw (TraverseException) final;
+    void visit(const Exp &expr) throw (TraverseException) final;
+};
+
+#endif /* REFERENCEVISITOR_H */
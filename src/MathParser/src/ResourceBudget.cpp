@@ -0,0 +1,81 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file ResourceBudget.cpp
+ *
+ * Implementation of limits of the work spent on one request and its cancellation.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#include "ResourceBudget.h"
+
+#include "ExceptionThrower.h"
+
+namespace {
+
+string reasonMessage(BudgetExceededException::Reason reason) {
+    switch (reason) {
+        case BudgetExceededException::Nodes:
+            return "The request has exceeded the limit of nodes.";
+        case BudgetExceededException::Passes:
+            return "The request has exceeded the limit of optimization passes.";
+        case BudgetExceededException::Time:
+            return "The request has exceeded the time limit.";
+        case BudgetExceededException::Cancelled:
+            return "The request has been cancelled.";
+    }
+    return "The request has exceeded its budget.";
+}
+
+}
+
+BudgetExceededException::BudgetExceededException(Reason reason, string context) : TraverseException(reasonMessage(reason), context), reason(reason) {
+}
+
+thread_local ResourceBudget *ResourceBudget::active = nullptr;
+
+const size_t ResourceBudget::clockInterval;
+
+ResourceBudget::ResourceBudget(const ResourceLimits &limits, const CancellationToken *token) :
+limits(limits),
+token(token),
+deadline(std::chrono::steady_clock::now() + std::chrono::milliseconds(limits.maxMilliseconds)),
+nodes(0),
+passes(0) {
+}
+
+void ResourceBudget::checkDeadline() const throw (BudgetExceededException) {
+    if (this->limits.maxMilliseconds != 0 && std::chrono::steady_clock::now() >= this->deadline) {
+        THROW(BudgetExceededException, BudgetExceededException::Time, "Limit: " + to_string(this->limits.maxMilliseconds) + " ms");
+    }
+}
+
+void ResourceBudget::chargeNodes(size_t count) throw (BudgetExceededException) {
+    size_t total = this->nodes.fetch_add(count, std::memory_order_relaxed) + count;
+    if (this->limits.maxNodes != 0 && total > this->limits.maxNodes) {
+        THROW(BudgetExceededException, BudgetExceededException::Nodes, "Limit: " + to_string(this->limits.maxNodes) + " nodes");
+    }
+    // the clock and the token are polled when the counter crosses a multiple of the interval
+    if ((total - count) / clockInterval != total / clockInterval) {
+        this->check();
+    }
+}
+
+void ResourceBudget::chargePass() throw (BudgetExceededException) {
+    unsigned int total = this->passes.fetch_add(1, std::memory_order_relaxed) + 1;
+    if (this->limits.maxPasses != 0 && total > this->limits.maxPasses) {
+        THROW(BudgetExceededException, BudgetExceededException::Passes, "Limit: " + to_string(this->limits.maxPasses) + " passes");
+    }
+    this->check();
+}
+
+void ResourceBudget::check() const throw (BudgetExceededException) {
+    if (this->token != nullptr && this->token->isCancelled()) {
+        THROW(BudgetExceededException, BudgetExceededException::Cancelled, "N.A.");
+    }
+    this->checkDeadline();
+}
@@ -0,0 +1,216 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file ResourceBudget.h
+ *
+ * Definition of limits of the work spent on one request and its cancellation.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#ifndef RESOURCEBUDGET_H
+#define RESOURCEBUDGET_H
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+#include "TraverseException.h"
+
+/**
+ * Flag which lets another thread (e.g. the one which stops a server) cancel
+ * requests running with a ResourceBudget.
+ */
+class CancellationToken {
+private:
+    std::atomic<bool> cancelled;
+
+public:
+
+    CancellationToken() : cancelled(false) {
+    }
+
+    CancellationToken(const CancellationToken &) = delete;
+    CancellationToken &operator=(const CancellationToken &) = delete;
+
+    void cancel() {
+        this->cancelled.store(true, std::memory_order_relaxed);
+    }
+
+    bool isCancelled() const {
+        return this->cancelled.load(std::memory_order_relaxed);
+    }
+};
+
+/**
+ * Limits of one request, 0 stands for no limit.
+ */
+struct ResourceLimits {
+    size_t maxNodes = 0; ///< Maximal number of nodes created by the factory functions.
+    unsigned int maxPasses = 0; ///< Maximal number of passes of the optimizers.
+    unsigned int maxMilliseconds = 0; ///< Maximal wall time.
+
+    bool isUnlimited() const {
+        return this->maxNodes == 0 && this->maxPasses == 0 && this->maxMilliseconds == 0;
+    }
+};
+
+/**
+ * Thrown by the factory functions, the Differentiator and the optimizers when
+ * the budget of the request is exhausted or the request is cancelled.
+ *
+ * It is a TraverseException, so it passes the exception specifications of
+ * visitors and rules. Callers which care catch it first.
+ */
+class BudgetExceededException : public TraverseException {
+public:
+
+    enum Reason {
+        Nodes,
+        Passes,
+        Time,
+        Cancelled
+    };
+
+private:
+    Reason reason;
+
+public:
+    BudgetExceededException(Reason reason, string context);
+
+    Reason getReason() const {
+        return this->reason;
+    }
+};
+
+/**
+ * Counter of the work spent on one request, checked cooperatively: the
+ * factory functions charge every created node, the optimizers every pass, and
+ * long loops call check(). The first charge which exceeds a limit throws
+ * BudgetExceededException, the trees built so far are released by the
+ * unwinding.
+ *
+ * The budget is made current for a thread by BudgetScope. The counters are
+ * atomic, the same budget can be current for the threads of ThreadPool
+ * working on one request (see traverseParallel()). Parsing must not run with
+ * a current budget, since the parser passes only ParsingException's.
+ */
+class ResourceBudget {
+private:
+    const ResourceLimits limits;
+    const CancellationToken *token;
+    const std::chrono::steady_clock::time_point deadline;
+
+    std::atomic<size_t> nodes;
+    std::atomic<unsigned int> passes;
+
+    static thread_local ResourceBudget *active;
+
+    /**
+     * The clock is read once per this number of created nodes.
+     */
+    static const size_t clockInterval = 1024;
+
+    void checkDeadline() const throw (BudgetExceededException);
+
+public:
+    /**
+     * @param limits Limits of the request, the time starts now.
+     * @param token Optional token which cancels the request, it must outlive
+     * the budget.
+     */
+    explicit ResourceBudget(const ResourceLimits &limits, const CancellationToken *token = nullptr);
+
+    ResourceBudget(const ResourceBudget &) = delete;
+    ResourceBudget &operator=(const ResourceBudget &) = delete;
+
+    /**
+     * Count created nodes.
+     */
+    void chargeNodes(size_t count) throw (BudgetExceededException);
+
+    /**
+     * Count one pass of an optimizer.
+     */
+    void chargePass() throw (BudgetExceededException);
+
+    /**
+     * Throw if the request is cancelled or out of time.
+     */
+    void check() const throw (BudgetExceededException);
+
+    size_t getNodes() const {
+        return this->nodes.load(std::memory_order_relaxed);
+    }
+
+    unsigned int getPasses() const {
+        return this->passes.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @return The budget of the calling thread, nullptr if it has none.
+     */
+    static ResourceBudget *current() {
+        return active;
+    }
+
+    friend class BudgetScope;
+};
+
+/**
+ * Makes the budget current for the calling thread until the scope ends, the
+ * previous one is restored then. nullptr stands for no budget.
+ */
+class BudgetScope {
+private:
+    ResourceBudget *previous;
+
+public:
+
+    explicit BudgetScope(ResourceBudget *budget) : previous(ResourceBudget::active) {
+        ResourceBudget::active = budget;
+    }
+
+    ~BudgetScope() {
+        ResourceBudget::active = this->previous;
+    }
+
+    BudgetScope(const BudgetScope &) = delete;
+    BudgetScope &operator=(const BudgetScope &) = delete;
+};
+
+/**
+ * Charge one node to the budget of the calling thread, if it has one.
+ */
+inline void chargeNode() {
+    ResourceBudget *budget = ResourceBudget::current();
+    if (budget != nullptr) {
+        budget->chargeNodes(1);
+    }
+}
+
+/**
+ * Charge one optimizer pass to the budget of the calling thread, if it has one.
+ */
+inline void chargePass() {
+    ResourceBudget *budget = ResourceBudget::current();
+    if (budget != nullptr) {
+        budget->chargePass();
+    }
+}
+
+/**
+ * Check the budget of the calling thread, if it has one.
+ */
+inline void checkBudget() {
+    ResourceBudget *budget = ResourceBudget::current();
+    if (budget != nullptr) {
+        budget->check();
+    }
+}
+
+#endif /* RESOURCEBUDGET_H */
@@ -11,6 +11,7 @@
  * @author agor
  */
 
+#include "ExceptionThrower.h"
 #include "Rule.h"
 
 #include "ParserStack.h"
@@ -23,6 +24,15 @@
 #include "Pow.h"
 #include "Sin.h"
 
+bool Rule::apply(ParserStack &stack, const Token &lookAheadToken) const throw (ParsingException) {
+    ParsingError error;
+    bool isReduced = this->apply(stack, lookAheadToken, error);
+    if (error.isSet) {
+        THROW(ParsingException, error.message, error.context);
+    }
+    return isReduced;
+}
+
 template<>
 bool hasPriority<Sum>(const Token &lookAheadToken) {
     if (lookAheadToken.type == TAlphaNumeric || lookAheadToken.type == TNumeric) {
@@ -26,7 +26,21 @@ using namespace std;
  */
 class Rule {
 public:
-    virtual bool apply(ParserStack &stack, const Token &lookAheadToken) const throw (ParsingException) = 0;
+    /**
+     * Reduce the stack by the rule.
+     * 
+     * @param stack The parsing stack.
+     * @param lookAheadToken The next token in the row.
+     * @param [out] error Set if the stack is malformed, e.g. an operation has no operand.
+     * 
+     * @return true if the stack has been reduced.
+     */
+    virtual bool apply(ParserStack &stack, const Token &lookAheadToken, ParsingError &error) const = 0;
+
+    /**
+     * The same as above, the error is thrown.
+     */
+    bool apply(ParserStack &stack, const Token &lookAheadToken) const throw (ParsingException);
 };
 
 /**
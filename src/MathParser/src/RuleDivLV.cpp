@@ -17,7 +17,7 @@
 #include "Div.h"
 #include "ParsingException.h"
 
-bool RuleDivLV::applyRule(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack &stack) const throw (ParsingException) {
+bool RuleDivLV::applyRule(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack &stack, ParsingError&) const {
     if(SPointerCast<Div>(*op)->lArg != nullptr){
         return false;
     }
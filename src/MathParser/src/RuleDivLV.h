@@ -20,7 +20,7 @@ class Div;
 
 class RuleDivLV : public RuleOperations<Div, false> {    
 private:
-    bool applyRule(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack &stack) const throw (ParsingException) final;
+    bool applyRule(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack &stack, ParsingError &error) const final;
 };
 
 #endif /* RULEDIVLV_H */
@@ -20,7 +20,7 @@ class Div;
 
 class RuleDivRV : public RuleOperations<Div, true> { 
 private:
-    bool applyRule(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack &stack) const throw (ParsingException) final;
+    bool applyRule(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack &stack, ParsingError &error) const final;
 };
 
 #endif /* RULEDIVRV_H */
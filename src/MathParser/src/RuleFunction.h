@@ -26,7 +26,9 @@
 template <class Function>
 class RuleFunction : public Rule {
 public:
-    bool apply(ParserStack& stack, const Token& ) const throw(ParsingException) final;
+    using Rule::apply;
+
+    bool apply(ParserStack& stack, const Token&, ParsingError&) const final;
 
 };
 
@@ -14,7 +14,7 @@
 #include "ParsingException.h"
 
 template <class Function>
-bool RuleFunction<Function>::apply(ParserStack& stack, const Token& ) const throw(ParsingException){
+bool RuleFunction<Function>::apply(ParserStack& stack, const Token&, ParsingError&) const {
     ParserStack::iterator funcIt = stack.begin();
     ParserStack::iterator argIt = stack.begin();
     ++argIt;
@@ -15,7 +15,7 @@
 #include "RuleMultLV.h"
 #include "Mult.h"
 
-bool RuleMultLV::applyRule(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack &stack) const throw (ParsingException) {
+bool RuleMultLV::applyRule(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack &stack, ParsingError&) const {
     if(SPointerCast<Mult>(*op)->lArg != nullptr){
         return false;
     }
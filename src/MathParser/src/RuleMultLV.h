@@ -21,7 +21,7 @@ class Mult;
 class RuleMultLV : public RuleOperations<Mult, false> {
  
 private:
-    bool applyRule(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack &stack) const throw (ParsingException) final;
+    bool applyRule(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack &stack, ParsingError &error) const final;
 };
 
 #endif /* RULEMULTLV_H */
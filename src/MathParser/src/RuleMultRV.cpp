@@ -15,10 +15,11 @@
 #include "RuleMultRV.h"
 #include "Mult.h"
 
-bool RuleMultRV::applyRule(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack &stack) const throw (ParsingException) {
+bool RuleMultRV::applyRule(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack &stack, ParsingError &error) const {
     // if the left side is empty 
     if (SPointerCast<Mult>(*op)->lArg == nullptr) {
-        THROW(ParsingException, "No operand on the left side of '*'.", to_string(stack));
+        error.set("No operand on the left side of '*'.", to_string(stack));
+        return false;
     }
 
     // see Grammar rule #26
@@ -14,7 +14,7 @@
 #include "RuleNoSignMult.h"
 #include "ExpressionFactory.h"
 
-bool RuleNoSignMult::apply(ParserStack& stack, const Token& lookAheadToken) const  throw(ParsingException) {
+bool RuleNoSignMult::apply(ParserStack& stack, const Token& lookAheadToken, ParsingError&) const {
     ParserStack::iterator exprLeftIt = stack.begin();
     ParserStack::iterator exprRightIt = stack.begin();
     ++exprRightIt;
@@ -24,7 +24,9 @@
  */
 class RuleNoSignMult : public Rule {
 public:
-    bool apply(ParserStack &stack, const Token &lookAheadToken) const throw (ParsingException) final;
+    using Rule::apply;
+
+    bool apply(ParserStack &stack, const Token &lookAheadToken, ParsingError&) const final;
 };
 
 #endif /* RULENOSIGNMULT_H */
@@ -32,7 +32,9 @@
 template <class OperationClass, bool isRightHand>
 class RuleOperations : public Rule{
 public:
-    bool apply(ParserStack &stack, const Token &lookAheadToken) const throw (ParsingException) final;
+    using Rule::apply;
+
+    bool apply(ParserStack &stack, const Token &lookAheadToken, ParsingError &error) const final;
     
 protected:
     
@@ -44,10 +46,11 @@ protected:
      * @param op The iterator of parsing stack pointing to considered operation.
      * @param arg The iterator of parsing stack pointing to the assumed argument of considered operation.
      * @param stack The parsing stack.
+     * @param [out] error Set if the operation can not be completed.
      * 
      * @return true if the stack has been reduced.
      */
-    virtual bool applyRule(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack &stack) const throw (ParsingException) = 0;
+    virtual bool applyRule(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack &stack, ParsingError &error) const = 0;
     
 private:
     
@@ -57,10 +60,11 @@ private:
      * @param op The iterator of parsing stack pointing to considered operation.
      * @param arg The iterator of parsing stack pointing to the assumed argument of considered operation.
      * @param stack The parsing stack.
+     * @param [out] error Set if the operation can not be completed.
      * 
      * @return true if the stack has been reduced.
      */
-    bool applyRuleWrapper(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack &stack) const throw (ParsingException);
+    bool applyRuleWrapper(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack &stack, ParsingError &error) const;
     
     /**
      * The method iterates through the stack and invokes the application of rule for relevant stack items.
@@ -70,10 +74,11 @@ private:
      * 
      * @param stack The parsing stack.
      * @param lookAheadToken The next token in the row, to determine the priority of operation.
+     * @param [out] error Set if the operation can not be completed.
      * 
      * @return true if the stack has been reduced.
      */
-    bool iterateStack(ParserStack &stack, const Token &lookAheadToken) const throw (ParsingException);
+    bool iterateStack(ParserStack &stack, const Token &lookAheadToken, ParsingError &error) const;
 };
 
 
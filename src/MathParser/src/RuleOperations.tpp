@@ -14,12 +14,12 @@
 #include "ParsingException.h"
 
 template <class OperationClass, bool isRightHand>
-bool RuleOperations<OperationClass, isRightHand>::apply(ParserStack& stack, const Token& lookAheadToken) const throw (ParsingException) {
-    return iterateStack(stack, lookAheadToken);
+bool RuleOperations<OperationClass, isRightHand>::apply(ParserStack& stack, const Token& lookAheadToken, ParsingError &error) const {
+    return iterateStack(stack, lookAheadToken, error);
 }
 
 template <class OperationClass, bool isRightHand>
-bool RuleOperations<OperationClass, isRightHand>::applyRuleWrapper(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack &stack) const throw (ParsingException) {
+bool RuleOperations<OperationClass, isRightHand>::applyRuleWrapper(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack &stack, ParsingError &error) const {
     // don't apply rule if operation of the left side is incomplete 
     if (!(*arg)->isComplete()) {
         return false;
@@ -32,11 +32,11 @@ bool RuleOperations<OperationClass, isRightHand>::applyRuleWrapper(const ParserS
         return false;
     }
 
-    return (this->applyRule(op, arg, stack));
+    return (this->applyRule(op, arg, stack, error));
 }
 
 template<class OperationClass, bool isRightHand>
-bool RuleOperations<OperationClass, isRightHand>::iterateStack(ParserStack& stack, const Token& lookAheadToken) const throw (ParsingException) {
+bool RuleOperations<OperationClass, isRightHand>::iterateStack(ParserStack& stack, const Token& lookAheadToken, ParsingError &error) const {
     ParserStack::iterator item = stack.begin();
     ParserStack::iterator nextItem = stack.begin();
     ++nextItem;
@@ -60,9 +60,12 @@ bool RuleOperations<OperationClass, isRightHand>::iterateStack(ParserStack& stac
             continue;
         }
 
-        if (applyRuleWrapper(op, arg, stack)) {
+        if (applyRuleWrapper(op, arg, stack, error)) {
             return true;
         }
+        if (error.isSet) {
+            return false;
+        }
     }
 
     return false;
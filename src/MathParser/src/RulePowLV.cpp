@@ -15,7 +15,7 @@
 #include "RulePowLV.h"
 #include "Pow.h"
 
-bool RulePowLV::applyRule(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack &stack) const throw (ParsingException) {
+bool RulePowLV::applyRule(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack &stack, ParsingError&) const {
     if(SPointerCast<Pow>(*op)->lArg != nullptr){
         return false;
     }
@@ -15,9 +15,10 @@
 #include "RulePowRV.h"
 #include "Pow.h"
 
-bool RulePowRV::applyRule(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack &stack) const throw (ParsingException) {
+bool RulePowRV::applyRule(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack &stack, ParsingError &error) const {
     if (SPointerCast<Pow>(*op)->lArg == nullptr) {
-        THROW(ParsingException, "No operand on the left side of '^'.", to_string(stack));
+        error.set("No operand on the left side of '^'.", to_string(stack));
+        return false;
     }
 
     // see Grammar rule #24
@@ -15,7 +15,7 @@
 #include "RuleSubLV.h"
 #include "Sub.h"
 
-bool RuleSubLV::applyRule(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack& stack) const throw(ParsingException) {
+bool RuleSubLV::applyRule(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack &stack, ParsingError&) const {
     if(SPointerCast<Sub>(*op)->lArg != nullptr){
         return false;
     }
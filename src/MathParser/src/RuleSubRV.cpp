@@ -18,7 +18,7 @@
 #include "Constant.h"
 #include "ExpressionFactory.h"
 
-bool RuleSubRV::applyRule(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack& stack) const throw(ParsingException) {
+bool RuleSubRV::applyRule(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack &stack, ParsingError&) const {
         // if the left side is empty 
         // see Grammar rule #34
         if (SPointerCast<Sub>(*op)->lArg == nullptr) {
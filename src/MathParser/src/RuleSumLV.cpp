@@ -15,7 +15,7 @@
 #include "RuleSumLV.h"
 #include "Sum.h"
 
-bool RuleSumLV::applyRule(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack& stack) const throw (ParsingException) {
+bool RuleSumLV::applyRule(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack &stack, ParsingError&) const {
     // skip if larg is already initialized
     if(SPointerCast<Sum>(*op)->lArg != nullptr){
         return false;
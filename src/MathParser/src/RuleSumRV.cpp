@@ -15,7 +15,7 @@
 #include "RuleSumRV.h"
 #include "Sum.h"
 
-bool RuleSumRV::applyRule(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack& stack) const throw (ParsingException) {
+bool RuleSumRV::applyRule(const ParserStack::const_iterator op, const ParserStack::const_iterator arg, ParserStack &stack, ParsingError&) const {
     // if the left side is empty 
     // see Grammar rule #31
     if (SPointerCast<Sum>(*op)->lArg == nullptr) {
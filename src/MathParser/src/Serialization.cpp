@@ -0,0 +1,270 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file Serialization.cpp
+ *
+ * Implementation of the binary encoding of expressions.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#include "Serialization.h"
+
+#include <cstdint>
+#include <cstring>
+#include <unordered_map>
+#include <vector>
+
+#include "ExceptionThrower.h"
+
+namespace {
+
+typedef FlatExpression::Index Index;
+
+const char magic[4] = {'A', 'G', 'E', 'X'};
+
+bool isLeaf(ExpressionType type) {
+    return type == EConstant || type == EVariable;
+}
+
+bool isFunction(ExpressionType type) {
+    return type >= ESin && type <= EExp;
+}
+
+void writeVarint(std::string &out, std::uint32_t value) {
+    while (value >= 0x80) {
+        out += static_cast<char> ((value & 0x7f) | 0x80);
+        value >>= 7;
+    }
+    out += static_cast<char> (value);
+}
+
+void writeDouble(std::string &out, double value) {
+    std::uint64_t bits;
+    std::memcpy(&bits, &value, sizeof (bits));
+    for (int i = 0; i < 8; i++) {
+        out += static_cast<char> (bits >> (8 * i));
+    }
+}
+
+/**
+ * Reads the encoding, every read is checked against the end of the data.
+ */
+class Reader {
+private:
+    const unsigned char *position;
+    const unsigned char *end;
+
+    void need(size_t bytes) throw (ParsingException) {
+        if (static_cast<size_t> (this->end - this->position) < bytes) {
+            THROW(ParsingException, "Serialized expression is truncated.", "N.A.");
+        }
+    }
+
+public:
+    Reader(const char *data, size_t size) :
+    position(reinterpret_cast<const unsigned char *> (data)),
+    end(reinterpret_cast<const unsigned char *> (data) + size) {
+    }
+
+    unsigned char byte() throw (ParsingException) {
+        this->need(1);
+        return *this->position++;
+    }
+
+    std::uint32_t varint() throw (ParsingException) {
+        std::uint32_t value = 0;
+        for (unsigned int shift = 0; shift < 35; shift += 7) {
+            unsigned char next = this->byte();
+            if (shift == 28 && next > 0x0f) {
+                break;
+            }
+            value |= static_cast<std::uint32_t> (next & 0x7f) << shift;
+            if ((next & 0x80) == 0) {
+                return value;
+            }
+        }
+        THROW(ParsingException, "Serialized expression contains a too large number.", "N.A.");
+    }
+
+    double number() throw (ParsingException) {
+        this->need(8);
+        std::uint64_t bits = 0;
+        for (int i = 0; i < 8; i++) {
+            bits |= static_cast<std::uint64_t> (this->position[i]) << (8 * i);
+        }
+        this->position += 8;
+        double value;
+        std::memcpy(&value, &bits, sizeof (value));
+        return value;
+    }
+
+    const char *bytes(size_t count) throw (ParsingException) {
+        this->need(count);
+        const char *result = reinterpret_cast<const char *> (this->position);
+        this->position += count;
+        return result;
+    }
+
+    /**
+     * Read the number of items which take at least the given number of bytes
+     * each, the data must be large enough for them.
+     */
+    std::uint32_t count(size_t minItemSize) throw (ParsingException) {
+        std::uint32_t items = this->varint();
+        this->need(items * minItemSize);
+        return items;
+    }
+
+    bool atEnd() const {
+        return this->position == this->end;
+    }
+};
+
+/**
+ * Index of the argument at the given distance back from the node.
+ */
+Index argument(Reader &reader, Index node) throw (ParsingException) {
+    std::uint32_t distance = reader.varint();
+    if (distance == 0 || distance > node) {
+        THROW(ParsingException, "Argument of the serialized node does not precede it.", "Node: " + to_string(node));
+    }
+    return node - distance;
+}
+
+}
+
+std::string serialize(const FlatExpression &expr) {
+    // local tables, values are written once in the order of the first use
+    std::unordered_map<SymbolId, Index> variables;
+    std::unordered_map<std::uint64_t, Index> constants;
+    std::vector<SymbolId> variableTable;
+    std::vector<double> constantTable;
+    std::vector<Index> leafIndex(expr.size(), 0);
+    for (Index node = 0; node < expr.size(); node++) {
+        if (expr.type(node) == EVariable) {
+            auto inserted = variables.emplace(expr.symbol(node), variableTable.size());
+            if (inserted.second) {
+                variableTable.push_back(expr.symbol(node));
+            }
+            leafIndex[node] = inserted.first->second;
+        } else if (expr.type(node) == EConstant) {
+            double value = expr.value(node);
+            std::uint64_t bits;
+            std::memcpy(&bits, &value, sizeof (bits));
+            auto inserted = constants.emplace(bits, constantTable.size());
+            if (inserted.second) {
+                constantTable.push_back(value);
+            }
+            leafIndex[node] = inserted.first->second;
+        }
+    }
+
+    std::string out(magic, sizeof (magic));
+    out += static_cast<char> (serializationVersion);
+
+    writeVarint(out, variableTable.size());
+    for (SymbolId symbol : variableTable) {
+        const std::string &name = SymbolTable::global().nameOf(symbol);
+        writeVarint(out, name.size());
+        out += name;
+    }
+    writeVarint(out, constantTable.size());
+    for (double value : constantTable) {
+        writeDouble(out, value);
+    }
+
+    writeVarint(out, expr.size());
+    for (Index node = 0; node < expr.size(); node++) {
+        ExpressionType type = expr.type(node);
+        out += static_cast<char> (type);
+        if (isLeaf(type)) {
+            writeVarint(out, leafIndex[node]);
+            continue;
+        }
+        writeVarint(out, node - expr.lArg(node));
+        if (!isFunction(type)) {
+            writeVarint(out, node - expr.rArg(node));
+        }
+    }
+    return out;
+}
+
+std::string serialize(const Expression &expr) throw (TraverseException) {
+    return serialize(flattenShared(expr));
+}
+
+FlatExpression deserializeFlat(const char *data, size_t size) throw (ParsingException) {
+    Reader reader(data, size);
+    if (std::memcmp(reader.bytes(sizeof (magic)), magic, sizeof (magic)) != 0) {
+        THROW(ParsingException, "Data is not a serialized expression.", "N.A.");
+    }
+    unsigned char version = reader.byte();
+    if (version != serializationVersion) {
+        THROW(ParsingException, "Unsupported version of the serialized expression.", "Version: " + to_string(version));
+    }
+
+    // the names are interned when they are used, the expression holds them then
+    std::vector<std::string> names(reader.count(1));
+    for (std::string &name : names) {
+        std::uint32_t length = reader.varint();
+        name.assign(reader.bytes(length), length);
+    }
+    std::vector<SymbolId> variables(names.size(), SymbolTable::none);
+    std::vector<double> constants(reader.count(8));
+    for (double &value : constants) {
+        value = reader.number();
+    }
+
+    FlatExpression expr;
+    std::uint32_t nodes = reader.count(2);
+    expr.reserve(nodes);
+    for (Index node = 0; node < nodes; node++) {
+        unsigned char type = reader.byte();
+        if (type > EExp) {
+            THROW(ParsingException, "Unknown type of the serialized node.", "Node: " + to_string(node));
+        }
+        if (type == EConstant || type == EVariable) {
+            std::uint32_t index = reader.varint();
+            if (index >= (type == EConstant ? constants.size() : variables.size())) {
+                THROW(ParsingException, "Serialized leaf refers to a missing table entry.", "Node: " + to_string(node));
+            }
+            if (type == EConstant) {
+                expr.addConstant(constants[index]);
+            } else if (variables[index] != SymbolTable::none) {
+                expr.addVariable(variables[index]);
+            } else {
+                variables[index] = SymbolTable::global().intern(names[index]);
+                if (variables[index] == SymbolTable::none) {
+                    THROW(ParsingException, "Too many names of variables.", names[index]);
+                }
+                expr.addVariable(variables[index]);
+                SymbolTable::global().release(variables[index]);
+            }
+            continue;
+        }
+
+        Index lArg = argument(reader, node);
+        Index rArg = isFunction(static_cast<ExpressionType> (type)) ? FlatExpression::none : argument(reader, node);
+        expr.addNode(static_cast<ExpressionType> (type), lArg, rArg);
+    }
+    if (!reader.atEnd()) {
+        THROW(ParsingException, "Unexpected data after the serialized expression.", "N.A.");
+    }
+    return expr;
+}
+
+FlatExpression deserializeFlat(const std::string &data) throw (ParsingException) {
+    return deserializeFlat(data.data(), data.size());
+}
+
+PExpression deserialize(const char *data, size_t size) throw (ParsingException) {
+    return deserializeFlat(data, size).toExpression();
+}
+
+PExpression deserialize(const std::string &data) throw (ParsingException) {
+    return deserialize(data.data(), data.size());
+}
@@ -0,0 +1,90 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file Serialization.h
+ *
+ * Compact binary encoding of expressions.
+ *
+ * The encoding is the FlatExpression written byte by byte, so decoding is
+ * one forward pass which appends nodes without tokenizing, parsing or
+ * building the syntax tree. Format of the version 1:
+ *
+ *     "AGEX" version
+ *     varint number of variables, for every variable: varint length, name
+ *     varint number of constants, for every constant: 8 bytes, IEEE 754 little-endian
+ *     varint number of nodes, for every node in post-order (arguments precede nodes):
+ *         type                      (1 byte, ExpressionType)
+ *         Constant:  varint index in the table of constants
+ *         Variable:  varint index in the table of variables
+ *         function:  varint distance back to the argument
+ *         operation: varint distances back to the left and to the right argument
+ *
+ * The last node is the root. Varints are unsigned LEB128 (7 bits per byte,
+ * least significant first). Both tables contain each value once, nodes shared
+ * by several parents are written once.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#ifndef SERIALIZATION_H
+#define SERIALIZATION_H
+
+#include <cstddef>
+#include <string>
+
+#include "Expression.h"
+#include "FlatExpression.h"
+#include "ParsingException.h"
+#include "TraverseException.h"
+
+/**
+ * Version of the format written by serialize().
+ */
+const unsigned char serializationVersion = 1;
+
+/**
+ * Encode the flat expression, nodes keep their order.
+ *
+ * @param expr The expression.
+ * @return Bytes of the encoding.
+ */
+std::string serialize(const FlatExpression &expr);
+
+/**
+ * Encode the tree, identical subtrees are written once (see flattenShared()).
+ *
+ * @param expr Root of the tree.
+ * @return Bytes of the encoding.
+ * @throw TraverseException if the tree is incomplete.
+ */
+std::string serialize(const Expression &expr) throw (TraverseException);
+
+/**
+ * Decode the flat expression, names of variables are interned in
+ * SymbolTable::global().
+ *
+ * @param data Bytes of the encoding.
+ * @param size Number of bytes.
+ * @return The expression with the same nodes as the serialized one.
+ * @throw ParsingException if the data is not an encoding of the supported
+ * version or is truncated.
+ */
+FlatExpression deserializeFlat(const char *data, size_t size) throw (ParsingException);
+
+FlatExpression deserializeFlat(const std::string &data) throw (ParsingException);
+
+/**
+ * Decode the tree, nodes shared in the encoding become shared subtrees.
+ *
+ * @return Root of the tree, nullptr for the empty expression.
+ * @throw ParsingException if the data is not an encoding of the supported
+ * version or is truncated.
+ */
+PExpression deserialize(const char *data, size_t size) throw (ParsingException);
+
+PExpression deserialize(const std::string &data) throw (ParsingException);
+
+#endif /* SERIALIZATION_H */
@@ -13,11 +13,16 @@
 
 #include "Sin.h"
 #include "Visitor.h"
+#include "ReferenceVisitor.h"
 #include "TraverseException.h"
 
 Sin::Sin() : Expression(ESin) {
 }
 
+Sin::~Sin() {
+    releaseArgument(this->arg);
+}
+
 bool Sin::isComplete() const {
     return (this->arg!=nullptr);
 }
@@ -26,4 +31,8 @@ void Sin::traverse(Visitor& visitor) const throw(TraverseException) {
     visitor.visit(shared_from_this());
 }
 
+void Sin::accept(ReferenceVisitor &visitor) const throw (TraverseException) {
+    visitor.visit(*this);
+}
+
 
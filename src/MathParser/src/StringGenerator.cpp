@@ -12,116 +12,172 @@
  */
 
 #include "StringGenerator.h"
-#include <sstream>
-#include <iomanip>
-#include <ios>
+#include <algorithm>
+#include <cstring>
 #include "TraverseException.h"
 
 using namespace std;
 
-void StringGenerator::visit(const PConstConstant expr) throw (TraverseException) {
-    std::stringstream strStream;
-    strStream << std::defaultfloat << std::setprecision(2) << expr->value;  
-    this->setLastVisitResult(strStream.str());
+StreamOutput::StreamOutput(std::ostream &stream) : stream(stream) {
 }
 
-void StringGenerator::visit(const PConstVariable expr) throw (TraverseException) {
-    this->setLastVisitResult(expr->name);
+void StreamOutput::write(const char *text, size_t length) {
+    this->stream.write(text, length);
 }
 
-string StringGenerator::getArgString(const PConstExpression argExpr) throw (TraverseException) {
-    if (argExpr == nullptr) {
-        return "?";
+BufferOutput::BufferOutput(char *buffer, size_t capacity) : buffer(buffer), capacity(capacity) {
+}
+
+void BufferOutput::write(const char *text, size_t length) {
+    if (this->length < this->capacity) {
+        std::memcpy(this->buffer + this->length, text, std::min(length, this->capacity - this->length));
     }
+    this->length += length;
+}
 
-    argExpr->traverse(*this);
-    return this->getLastVisitResult();
+size_t BufferOutput::getLength() const {
+    return this->length;
 }
 
-bool isBinaryOp(PExpression expr){
-    if(expr == NULL){
-        return false;
-    }
-        
-    if(isTypeOf<Sum>(expr)){
-        return true;
-    }
-    if(isTypeOf<Sub>(expr)){
-        return true;
-    }
-    if(isTypeOf<Mult>(expr)){
-        return true;
-    }
-    if(isTypeOf<Div>(expr)){
-        return true;
+const size_t StringGenerator::chunkSize;
+
+StringGenerator::StringGenerator(int precision) : precision(precision) {
+}
+
+StringGenerator::StringGenerator(TextOutput &textOutput, int precision) : precision(precision), textOutput(&textOutput) {
+    this->output.reserve(chunkSize + maxNumberLength);
+}
+
+string StringGenerator::appendNode(const string &text) {
+    return this->appendNode(text.data(), text.size());
+}
+
+string StringGenerator::appendNode(const char *text, size_t length) {
+    this->output.append(text, length);
+    if(this->textOutput != nullptr && (this->depth == 0 || this->output.size() >= chunkSize)){
+        this->textOutput->write(this->output.data(), this->output.size());
+        this->output.clear();
     }
-    if(isTypeOf<Pow>(expr)){
-        return true;
+    if(this->depth > 0 || this->textOutput != nullptr){
+        return string();
     }
-    return false;
+    
+    string result;
+    result.swap(this->output);
+    return result;
+}
+
+string StringGenerator::postVisit(const Constant &expr) throw (TraverseException) {
+    char buffer[maxNumberLength];
+    char *end = formatNumber(expr.value, this->precision, buffer);
+    return this->appendNode(buffer, end - buffer);
+}
+
+string StringGenerator::postVisit(const Variable &expr) throw (TraverseException) {
+    return this->appendNode(expr.name);
 }
 
-template <typename PointerOpClass>
-void StringGenerator::visitArythmeticalOp(const PointerOpClass expr, string op) throw (TraverseException) {
-    string strLArg = this->getArgString(expr->lArg);
-    string strRArg = this->getArgString(expr->rArg);
-    if(isBinaryOp(expr->lArg)){
-        strLArg = "(" + strLArg + ")";
+/**
+ * @return true if the argument is an arithmetical operation, it is put in brackets then.
+ */
+bool isBinaryOp(const Expression *expr){
+    if(expr == nullptr){
+        return false;
     }
-    if(isBinaryOp(expr->rArg)){
-        strRArg = "(" + strRArg + ")";
+    
+    switch(expr->getType()){
+        case ESum:
+        case ESub:
+        case EMult:
+        case EDiv:
+        case EPow:
+            return true;
+        default:
+            return false;
     }
-    this->setLastVisitResult(strLArg + op + strRArg);
 }
 
-template <typename PointerOpClass>
-void StringGenerator::visitFunction(const PointerOpClass expr, string fname) throw (TraverseException) {
-    string strArg = this->getArgString(expr->arg);
-    if (strArg.find('(', 0) != 0 || strArg.find_last_of(')', 0) != (strArg.length() - 1)) {
-        strArg = "(" + strArg + ")";
+/**
+ * Symbol of the arithmetical operation or name of the function.
+ */
+const char *symbolOf(const Expression &expr){
+    switch(expr.getType()){
+        case ESum: return "+";
+        case ESub: return "-";
+        case EMult: return "*";
+        case EDiv: return "/";
+        case EPow: return "^";
+        case ESin: return "sin";
+        case ECos: return "cos";
+        case ETan: return "tan";
+        case ECtan: return "ctan";
+        case ELn: return "ln";
+        case EExp: return "exp";
+        default: return "";
     }
-    this->setLastVisitResult(fname + strArg);
 }
 
-void StringGenerator::visit(const PConstSum expr) throw (TraverseException) {
-    visitArythmeticalOp<PConstSum>(expr, "+");
+void StringGenerator::beforeArgument(const Expression &expr, unsigned int index) throw (TraverseException) {
+    this->depth++;
+    
+    const Expression *args[2];
+    if(argumentsOf(expr, args) == 1){
+        // argument of function is always put in brackets
+        this->output += symbolOf(expr);
+        this->output += "(";
+    }else if(isBinaryOp(args[index])){
+        this->output += "(";
+    }
 }
-void StringGenerator::visit(const PConstSub expr) throw (TraverseException) {
-    visitArythmeticalOp<PConstSub>(expr, "-");
+
+void StringGenerator::afterArgument(const Expression &expr, unsigned int index) throw (TraverseException) {
+    this->depth--;
+    
+    const Expression *args[2];
+    unsigned int argCount = argumentsOf(expr, args);
+    if(args[index] == nullptr){
+        this->output += "?";
+    }
+    if(argCount == 1 || isBinaryOp(args[index])){
+        this->output += ")";
+    }
+    if(argCount == 2 && index == 0){
+        this->output += symbolOf(expr);
+    }
 }
-void StringGenerator::visit(const PConstMult expr) throw (TraverseException) {
-    visitArythmeticalOp<PConstMult>(expr, "*");
+
+// the text of operations and functions is written around their arguments
+
+string StringGenerator::postVisit(const Sum &, string &, string &) throw (TraverseException) {
+    return this->appendNode(string());
 }
-void StringGenerator::visit(const PConstDiv expr) throw (TraverseException) {
-    visitArythmeticalOp<PConstDiv>(expr, "/");
+string StringGenerator::postVisit(const Sub &, string &, string &) throw (TraverseException) {
+    return this->appendNode(string());
 }
-void StringGenerator::visit(const PConstPow expr) throw (TraverseException) {
-    visitArythmeticalOp<PConstPow>(expr, "^");
+string StringGenerator::postVisit(const Mult &, string &, string &) throw (TraverseException) {
+    return this->appendNode(string());
 }
-void StringGenerator::visit(const PConstSin expr) throw (TraverseException) {
-    this->visitFunction<PConstSin>(expr, "sin");
+string StringGenerator::postVisit(const Div &, string &, string &) throw (TraverseException) {
+    return this->appendNode(string());
 }
-void StringGenerator::visit(const PConstCos expr) throw (TraverseException) {
-    this->visitFunction<PConstCos>(expr, "cos");
+string StringGenerator::postVisit(const Pow &, string &, string &) throw (TraverseException) {
+    return this->appendNode(string());
 }
-void StringGenerator::visit(const PConstTan expr) throw (TraverseException) {
-    this->visitFunction<PConstTan>(expr, "tan");
+string StringGenerator::postVisit(const Sin &, string &) throw (TraverseException) {
+    return this->appendNode(string());
 }
-void StringGenerator::visit(const PConstCtan expr) throw (TraverseException) {
-    this->visitFunction<PConstCtan>(expr, "ctan");
+string StringGenerator::postVisit(const Cos &, string &) throw (TraverseException) {
+    return this->appendNode(string());
 }
-void StringGenerator::visit(const PConstLn expr) throw (TraverseException) {
-    this->visitFunction<PConstLn>(expr, "ln");
+string StringGenerator::postVisit(const Tan &, string &) throw (TraverseException) {
+    return this->appendNode(string());
 }
-void StringGenerator::visit(const PConstExp expr) throw (TraverseException) {
-    this->visitFunction<PConstExp>(expr, "exp");
+string StringGenerator::postVisit(const Ctan &, string &) throw (TraverseException) {
+    return this->appendNode(string());
 }
-
-string StringGenerator::getLastVisitResult() const {
-    return this->result;
+string StringGenerator::postVisit(const Ln &, string &) throw (TraverseException) {
+    return this->appendNode(string());
 }
-
-void StringGenerator::setLastVisitResult(string result) {
-    this->result = result;
+string StringGenerator::postVisit(const Exp &, string &) throw (TraverseException) {
+    return this->appendNode(string());
 }
-
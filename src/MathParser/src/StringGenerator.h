@@ -13,44 +13,123 @@
 #define SRC_STRINGGENERATOR_H_
 
 #include <string>
-#include "Visitor.h"
+#include <ostream>
+#include "PostOrderVisitor.h"
+#include "Numbers.h"
 
 class TraverseException;
 
 using namespace std;
 
-class StringGenerator : public Visitor {
+/**
+ * Destination of the text written by StringGenerator in chunks.
+ */
+class TextOutput {
+public:
+    virtual ~TextOutput() {
+    }
+
+    virtual void write(const char *text, size_t length) = 0;
+};
+
+/**
+ * Writes the text to the stream.
+ */
+class StreamOutput : public TextOutput {
 private:
-    string result;
+    std::ostream &stream;
 
-    string getArgString(const PConstExpression argExpr) throw (TraverseException);
+public:
+    StreamOutput(std::ostream &stream);
 
-    template <typename PointerOpClass>
-    void visitArythmeticalOp(const PointerOpClass expr, string op) throw (TraverseException);
+    void write(const char *text, size_t length) final;
+};
 
-    template <typename PointerOpClass>
-    void visitFunction(const PointerOpClass expr, string fname) throw (TraverseException);
+/**
+ * Writes the text to the caller's buffer, the text which does not fit is 
+ * only counted.
+ */
+class BufferOutput : public TextOutput {
+private:
+    char *buffer;
+    size_t capacity;
+    size_t length = 0;
 
 public:
-    void visit(const PConstConstant expr) throw (TraverseException) final;
+    /**
+     * @param buffer The buffer.
+     * @param capacity Size of the buffer.
+     */
+    BufferOutput(char *buffer, size_t capacity);
+
+    void write(const char *text, size_t length) final;
 
-    void visit(const PConstVariable expr) throw (TraverseException) final;
+    /**
+     * @return Length of the whole text, it can exceed the capacity.
+     */
+    size_t getLength() const;
+};
 
-    void visit(const PConstSum expr) throw (TraverseException) final;
-    void visit(const PConstSub expr) throw (TraverseException) final;
-    void visit(const PConstDiv expr) throw (TraverseException) final;
-    void visit(const PConstMult expr) throw (TraverseException) final;
-    void visit(const PConstPow expr) throw (TraverseException) final;
-    void visit(const PConstSin expr) throw (TraverseException) final;
-    void visit(const PConstCos expr) throw (TraverseException) final;
-    void visit(const PConstTan expr) throw (TraverseException) final;
-    void visit(const PConstCtan expr) throw (TraverseException) final;
-    void visit(const PConstLn expr) throw (TraverseException) final;
-    void visit(const PConstExp expr) throw (TraverseException) final;
+/**
+ * Generates the string representation of the Expression.
+ * 
+ * The text is written into a single buffer in order of the traversal, so the
+ * time is linear in the length of the result even for very deep trees. 
+ * Constants are written by formatNumber() with the given precision.
+ * 
+ * If TextOutput is given, the buffer is passed to it whenever it exceeds 
+ * chunkSize and after the root, so the whole text is never kept in the memory.
+ * The result of the traversal is the empty string then.
+ */
+class StringGenerator : public PostOrderVisitor<string> {
+private:
+    string output; // text of the tree being traversed
+    unsigned int depth = 0; // depth of the current node, 0 for the root
+    int precision;
+    TextOutput *textOutput = nullptr;
+
+    /**
+     * Append the text of the node to the output.
+     * 
+     * @return The whole text if the node is the root, otherwise an empty string.
+     */
+    string appendNode(const string &text);
+    string appendNode(const char *text, size_t length);
+
+protected:
+    string postVisit(const Constant &expr) throw (TraverseException) final;
+    string postVisit(const Variable &expr) throw (TraverseException) final;
+    string postVisit(const Sum &expr, string &lArg, string &rArg) throw (TraverseException) final;
+    string postVisit(const Sub &expr, string &lArg, string &rArg) throw (TraverseException) final;
+    string postVisit(const Div &expr, string &lArg, string &rArg) throw (TraverseException) final;
+    string postVisit(const Mult &expr, string &lArg, string &rArg) throw (TraverseException) final;
+    string postVisit(const Pow &expr, string &lArg, string &rArg) throw (TraverseException) final;
+    string postVisit(const Sin &expr, string &arg) throw (TraverseException) final;
+    string postVisit(const Cos &expr, string &arg) throw (TraverseException) final;
+    string postVisit(const Tan &expr, string &arg) throw (TraverseException) final;
+    string postVisit(const Ctan &expr, string &arg) throw (TraverseException) final;
+    string postVisit(const Ln &expr, string &arg) throw (TraverseException) final;
+    string postVisit(const Exp &expr, string &arg) throw (TraverseException) final;
+
+    void beforeArgument(const Expression &expr, unsigned int index) throw (TraverseException) final;
+    void afterArgument(const Expression &expr, unsigned int index) throw (TraverseException) final;
+
+public:
+    /**
+     * @param precision Number of significant digits of constants.
+     */
+    StringGenerator(int precision = defaultNumberPrecision);
 
-    void setLastVisitResult(string result);
+    /**
+     * @param textOutput Destination of the text.
+     * @param precision Number of significant digits of constants.
+     */
+    StringGenerator(TextOutput &textOutput, int precision = defaultNumberPrecision);
 
-    string getLastVisitResult() const;
+    /**
+     * Size of chunks of the text passed to TextOutput.
+     */
+    static const size_t chunkSize = 1 << 16;
 };
 
 #endif /* SRC_STRINGGENERATOR_H_ */
@@ -0,0 +1,246 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file StructuralEquality.cpp
+ *
+ * Implementation of the allocation-free comparison of expressions.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#include <cmath>
+#include <algorithm>
+#include <vector>
+
+#include "StructuralEquality.h"
+#include "Constant.h"
+#include "Variable.h"
+#include "Sum.h"
+#include "Sub.h"
+#include "Mult.h"
+#include "Div.h"
+#include "Pow.h"
+#include "Sin.h"
+#include "Cos.h"
+#include "Tan.h"
+#include "Ctan.h"
+#include "Ln.h"
+#include "Exp.h"
+
+namespace {
+
+/**
+ * Pair of nodes which still have to be compared.
+ *
+ * A choice is a pair of Sum's or Mult's whose arguments can be paired both 
+ * straight and swapped by their hashes. It stays on the stack below the pair of
+ * left arguments while these are compared, and marks where to backtrack to.
+ */
+struct NodePair {
+    const Expression *l;
+    const Expression *r;
+    bool isChoice;
+};
+
+/**
+ * Stack of NodePair's with a fixed capacity on the call stack, spills to the
+ * heap only when it is exceeded.
+ */
+class PairStack {
+private:
+    static const size_t capacity = 256;
+
+    NodePair pairs[capacity];
+    size_t count;
+    std::vector<NodePair> overflow;
+
+public:
+    PairStack() : count(0) {
+    }
+
+    /**
+     * Push the pair of arguments.
+     *
+     * @return false if one of arguments is missing or their hashes differ,
+     *         the pair cannot be equal then.
+     */
+    bool push(const Expression *l, const Expression *r, bool isChoice = false) {
+        if(l == nullptr || r == nullptr || l->getHash() != r->getHash()){
+            return false;
+        }
+        if(this->count < capacity){
+            this->pairs[this->count++] = {l, r, isChoice};
+        } else {
+            this->overflow.push_back({l, r, isChoice});
+        }
+        return true;
+    }
+
+    bool empty() const {
+        return this->count == 0 && this->overflow.empty();
+    }
+
+    NodePair pop() {
+        if(!this->overflow.empty()){
+            NodePair pair = this->overflow.back();
+            this->overflow.pop_back();
+            return pair;
+        }
+        return this->pairs[--this->count];
+    }
+
+    /**
+     * Drop the pairs above the last choice and pop the choice.
+     *
+     * @return false if there is no choice.
+     */
+    bool popChoice(NodePair &choice) {
+        while(!this->empty()){
+            choice = this->pop();
+            if(choice.isChoice){
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+bool constantsEqual(const Constant &l, const Constant &r){
+    double a = l.value;
+    double b = r.value;
+    double eps = 0.00000001;
+    double max = std::max( { std::fabs(a), std::fabs(b), 1.0 } );
+    return std::fabs(a - b) <= max * eps;
+}
+
+template<typename T>
+bool pushDiadic(PairStack &stack, const NodePair &pair){
+    const T &l = static_cast<const T &>(*pair.l);
+    const T &r = static_cast<const T &>(*pair.r);
+    return stack.push(l.lArg.get(), r.lArg.get()) && stack.push(l.rArg.get(), r.rArg.get());
+}
+
+/**
+ * Push arguments of Sum or Mult in the order given by their hashes. If the hashes
+ * allow both pairings, the left arguments are compared first above a choice:
+ * if they are equal, the right ones must be equal too (see pushRightArguments()),
+ * otherwise only the swapped pairing is possible (see pushSwappedArguments()).
+ */
+template<typename T>
+bool pushCommutative(PairStack &stack, const NodePair &pair){
+    const T &l = static_cast<const T &>(*pair.l);
+    const T &r = static_cast<const T &>(*pair.r);
+    if(l.lArg == nullptr || l.rArg == nullptr || r.lArg == nullptr || r.rArg == nullptr){
+        return false;
+    }
+
+    bool straight = l.lArg->getHash() == r.lArg->getHash() && l.rArg->getHash() == r.rArg->getHash();
+    bool swapped = l.lArg->getHash() == r.rArg->getHash() && l.rArg->getHash() == r.lArg->getHash();
+    if(straight && swapped){
+        return stack.push(pair.l, pair.r, true) && stack.push(l.lArg.get(), r.lArg.get());
+    }
+    if(swapped){
+        return stack.push(l.lArg.get(), r.rArg.get()) && stack.push(l.rArg.get(), r.lArg.get());
+    }
+    return stack.push(l.lArg.get(), r.lArg.get()) && stack.push(l.rArg.get(), r.rArg.get());
+}
+
+/**
+ * The left arguments of the choice are equal, push the right ones.
+ */
+bool pushRightArguments(PairStack &stack, const NodePair &choice){
+    const Expression *l[2];
+    const Expression *r[2];
+    argumentsOf(*choice.l, l);
+    argumentsOf(*choice.r, r);
+    return stack.push(l[1], r[1]);
+}
+
+/**
+ * The left arguments of the choice differ, push the swapped pairing.
+ */
+bool pushSwappedArguments(PairStack &stack, const NodePair &choice){
+    const Expression *l[2];
+    const Expression *r[2];
+    argumentsOf(*choice.l, l);
+    argumentsOf(*choice.r, r);
+    return stack.push(l[0], r[1]) && stack.push(l[1], r[0]);
+}
+
+template<typename T>
+bool pushFunction(PairStack &stack, const NodePair &pair){
+    return stack.push(static_cast<const T &>(*pair.l).arg.get(), static_cast<const T &>(*pair.r).arg.get());
+}
+
+/**
+ * Compare the nodes themselves and push pairs of their arguments.
+ *
+ * @return false if the nodes are certainly not equal.
+ */
+bool step(PairStack &stack, const NodePair &pair){
+    if(pair.l == pair.r){
+        return pair.l->isComplete();
+    }
+    if(pair.l->getType() != pair.r->getType()){
+        return false;
+    }
+
+    switch(pair.l->getType()){
+        case EConstant:
+            return constantsEqual(static_cast<const Constant &>(*pair.l), static_cast<const Constant &>(*pair.r));
+        case EVariable:
+            return static_cast<const Variable &>(*pair.l).symbol == static_cast<const Variable &>(*pair.r).symbol;
+        case ESum:
+            return pushCommutative<Sum>(stack, pair);
+        case ESub:
+            return pushDiadic<Sub>(stack, pair);
+        case EMult:
+            return pushCommutative<Mult>(stack, pair);
+        case EDiv:
+            return pushDiadic<Div>(stack, pair);
+        case EPow:
+            return pushDiadic<Pow>(stack, pair);
+        case ESin:
+            return pushFunction<Sin>(stack, pair);
+        case ECos:
+            return pushFunction<Cos>(stack, pair);
+        case ETan:
+            return pushFunction<Tan>(stack, pair);
+        case ECtan:
+            return pushFunction<Ctan>(stack, pair);
+        case ELn:
+            return pushFunction<Ln>(stack, pair);
+        case EExp:
+            return pushFunction<Exp>(stack, pair);
+    }
+    return false;
+}
+
+}
+
+bool structurallyEqual(const Expression &exprL, const Expression &exprR){
+    if(exprL.getHash() != exprR.getHash()){
+        return false;
+    }
+
+    PairStack stack;
+    NodePair pair = {&exprL, &exprR, false};
+    for(;;){
+        bool isEqual = pair.isChoice ? pushRightArguments(stack, pair) : step(stack, pair);
+        while(!isEqual){
+            // backtrack: the left arguments of the last choice differ
+            NodePair choice;
+            if(!stack.popChoice(choice)){
+                return false;
+            }
+            isEqual = pushSwappedArguments(stack, choice);
+        }
+        if(stack.empty()){
+            return true;
+        }
+        pair = stack.pop();
+    }
+}
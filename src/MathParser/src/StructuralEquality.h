@@ -0,0 +1,41 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file StructuralEquality.h
+ *
+ * Definition of the allocation-free comparison of expressions.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#ifndef STRUCTURALEQUALITY_H
+#define STRUCTURALEQUALITY_H
+
+#include "Expression.h"
+
+/**
+ * Check whether two expressions are identical, the same way as Comparator does.
+ *
+ * The trees are compared through raw references with an explicit stack of node
+ * pairs, which is located on the call stack. Therefore no visitors or lambdas
+ * are created and no smart pointers are copied. The heap is used only if more
+ * than a few hundred pairs are pending at once, i.e. for extremely deep trees.
+ *
+ * Subtrees with different Expression::getHash() are not traversed. Arguments of
+ * Sum and Mult are paired by their hashes, both pairings are tried only if
+ * the hashes do not tell them apart (e.g. sums of constants). Then the other
+ * pairing is tried by backtracking on the same stack, without recursion.
+ *
+ * Incomplete expressions are not equal to anything.
+ *
+ * @param exprL First expression (left-hand).
+ * @param exprR Second expression (right-hand).
+ *
+ * @return true if expressions are equal, otherwise - false.
+ */
+bool structurallyEqual(const Expression &exprL, const Expression &exprR);
+
+#endif /* STRUCTURALEQUALITY_H */
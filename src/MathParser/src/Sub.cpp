@@ -13,14 +13,24 @@
 
 #include "Sub.h"
 #include "Visitor.h"
+#include "ReferenceVisitor.h"
 #include "TraverseException.h"
 
 Sub::Sub() : Expression(ESub) {}
 
+Sub::~Sub() {
+    releaseArgument(this->lArg);
+    releaseArgument(this->rArg);
+}
+
 void Sub::traverse(Visitor &visitor) const throw(TraverseException) {
 	visitor.visit(shared_from_this());
 }
 
+void Sub::accept(ReferenceVisitor &visitor) const throw (TraverseException) {
+	visitor.visit(*this);
+}
+
 bool Sub::isComplete() const{
 	return (this->lArg!=nullptr && this->rArg!=nullptr);
 }
\ No newline at end of file
@@ -22,8 +22,10 @@ public:
     PExpression rArg;
 
     Sub();
+    ~Sub();
 
     void traverse(Visitor &) const throw (TraverseException) final;
+    void accept(ReferenceVisitor &) const throw (TraverseException) final;
 
     bool isComplete() const final;
 };
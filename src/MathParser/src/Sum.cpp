@@ -13,14 +13,24 @@
 
 #include "Sum.h"
 #include "Visitor.h"
+#include "ReferenceVisitor.h"
 #include "TraverseException.h"
 
 Sum::Sum() : Expression(ESum) {}
 
+Sum::~Sum() {
+    releaseArgument(this->lArg);
+    releaseArgument(this->rArg);
+}
+
 void Sum::traverse(Visitor &visitor) const throw(TraverseException) {
 	visitor.visit(shared_from_this());
 }
 
+void Sum::accept(ReferenceVisitor &visitor) const throw (TraverseException) {
+	visitor.visit(*this);
+}
+
 bool Sum::isComplete() const{
 	return (this->lArg!=nullptr && this->rArg!=nullptr);
 }
\ No newline at end of file
@@ -22,8 +22,10 @@ public:
     PExpression rArg;
 
     Sum();
+    ~Sum();
 
     void traverse(Visitor &) const throw (TraverseException) final;
+    void accept(ReferenceVisitor &) const throw (TraverseException) final;
 
     bool isComplete() const final;
 };
@@ -0,0 +1,169 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file SymbolTable.cpp
+ *
+ * Implementation of SymbolTable.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#include "SymbolTable.h"
+
+#include <utility>
+
+const SymbolId SymbolTable::emptySymbol;
+const SymbolId SymbolTable::none;
+const size_t SymbolTable::entryMemory;
+const size_t SymbolTable::defaultCapacity;
+
+SymbolTable::SymbolTable(size_t capacity) : capacity(0), memory(0), unreferencedMemory(0) {
+    // the empty name is interned whatever the capacity is, and it is never released
+    this->intern("");
+    this->capacity = capacity;
+}
+
+bool SymbolTable::makeRoom(size_t required) {
+    if (this->capacity == 0 || this->memory + required <= this->capacity) {
+        return true;
+    }
+    if (this->memory - this->unreferencedMemory + required > this->capacity) {
+        return false;
+    }
+
+    // every unreferenced name is queued, so there is enough of them
+    while (this->memory + required > this->capacity) {
+        SymbolId symbol = this->unreferenced.front();
+        this->unreferenced.pop_front();
+        Entry &entry = this->entries[symbol];
+        entry.isQueued = false;
+        if (entry.references != 0) {
+            // referenced again since it was queued
+            continue;
+        }
+
+        this->symbols.erase(entry.name);
+        this->memory -= memoryOf(entry.name);
+        this->unreferencedMemory -= memoryOf(entry.name);
+        std::string().swap(entry.name);
+        this->evicted.push_back(symbol);
+    }
+    return true;
+}
+
+SymbolId SymbolTable::intern(const std::string &name) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto found = this->symbols.find(name);
+    if (found != this->symbols.end()) {
+        Entry &entry = this->entries[found->second];
+        if (entry.references++ == 0) {
+            this->unreferencedMemory -= memoryOf(name);
+        }
+        return found->second;
+    }
+    if ((this->evicted.empty() && this->entries.size() == none) || !this->makeRoom(memoryOf(name))) {
+        return none;
+    }
+
+    SymbolId symbol;
+    if (this->evicted.empty()) {
+        symbol = this->entries.size();
+        this->entries.emplace_back();
+    } else {
+        symbol = this->evicted.back();
+        this->evicted.pop_back();
+    }
+    Entry &entry = this->entries[symbol];
+    entry.name = name;
+    entry.references = 1;
+    this->symbols.emplace(name, symbol);
+    this->memory += memoryOf(name);
+    return symbol;
+}
+
+bool SymbolTable::canIntern(const std::string &name) const {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (this->capacity == 0 || this->memory - this->unreferencedMemory + memoryOf(name) <= this->capacity) {
+        return true;
+    }
+    return this->symbols.find(name) != this->symbols.end();
+}
+
+const std::string &SymbolTable::acquire(SymbolId symbol) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    Entry &entry = this->entries[symbol];
+    if (entry.references++ == 0) {
+        this->unreferencedMemory -= memoryOf(entry.name);
+    }
+    return entry.name;
+}
+
+void SymbolTable::release(SymbolId symbol) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    Entry &entry = this->entries[symbol];
+    if (--entry.references != 0) {
+        return;
+    }
+    this->unreferencedMemory += memoryOf(entry.name);
+    if (!entry.isQueued) {
+        entry.isQueued = true;
+        this->unreferenced.push_back(symbol);
+    }
+}
+
+SymbolId SymbolTable::find(const std::string &name) const {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    auto found = this->symbols.find(name);
+    return found == this->symbols.end() ? none : found->second;
+}
+
+const std::string &SymbolTable::nameOf(SymbolId symbol) const {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->entries[symbol].name;
+}
+
+size_t SymbolTable::size() const {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->entries.size();
+}
+
+size_t SymbolTable::referencedMemory() const {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    return this->memory - this->unreferencedMemory;
+}
+
+void SymbolTable::setCapacity(size_t capacity) {
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->capacity = capacity;
+}
+
+SymbolTable &SymbolTable::global() {
+    // never destroyed, static expressions release their names after the end of main()
+    static SymbolTable *table = new SymbolTable();
+    return *table;
+}
+
+SymbolReference::SymbolReference(SymbolId symbol) : symbol(symbol) {
+    SymbolTable::global().acquire(symbol);
+}
+
+SymbolReference::SymbolReference(const SymbolReference &other) : SymbolReference(other.symbol) {
+}
+
+SymbolReference::SymbolReference(SymbolReference &&other) noexcept : symbol(other.symbol) {
+    other.symbol = SymbolTable::none;
+}
+
+SymbolReference::~SymbolReference() {
+    if (this->symbol != SymbolTable::none) {
+        SymbolTable::global().release(this->symbol);
+    }
+}
+
+SymbolReference &SymbolReference::operator=(SymbolReference other) noexcept {
+    std::swap(this->symbol, other.symbol);
+    return *this;
+}
@@ -0,0 +1,183 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file SymbolTable.h
+ *
+ * Definition of the table of interned names of variables.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#ifndef SYMBOLTABLE_H
+#define SYMBOLTABLE_H
+
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Dense integer identifier of a name of variable.
+ */
+typedef std::uint32_t SymbolId;
+
+/**
+ * Maps names of variables to dense identifiers 0, 1, 2, ... and back.
+ *
+ * A name gets its identifier when it is interned for the first time. Names of
+ * variables are interned by the Variable itself (i.e. at parse time), and all
+ * expressions share the global() table, so variables are compared by their
+ * identifiers and identifiers can index arrays (e.g. values of variables).
+ * The empty name is always emptySymbol.
+ *
+ * The table is thread-safe. Since long running processes (e.g. SolverServer)
+ * intern the names of every request, the memory of the names is bounded by the
+ * capacity. Names are reference counted by their holders (Variable, 
+ * FlatExpression, SymbolValues). Once the table is full, the names which are not
+ * referenced any more are evicted, the oldest first, and their identifiers are
+ * reused. Only if the referenced names alone exhaust the capacity, new names
+ * are refused. The reference returned by nameOf() stays valid as long as the
+ * name is referenced.
+ */
+class SymbolTable {
+private:
+
+    struct Entry {
+        std::string name;
+        size_t references = 0;
+        bool isQueued = false; // in unreferenced
+    };
+
+    mutable std::mutex mutex;
+    std::unordered_map<std::string, SymbolId> symbols;
+    std::deque<Entry> entries; // references to elements are not invalidated by push_back()
+    std::deque<SymbolId> unreferenced; // candidates for eviction, oldest first
+    std::vector<SymbolId> evicted; // identifiers to be reused
+    size_t capacity;
+    size_t memory;
+    size_t unreferencedMemory;
+
+    static size_t memoryOf(const std::string &name) {
+        return name.size() + entryMemory;
+    }
+
+    /**
+     * Evict unreferenced names until the required memory is available.
+     *
+     * @return false if it is not possible.
+     */
+    bool makeRoom(size_t required);
+
+public:
+    static const SymbolId emptySymbol = 0;
+    static const SymbolId none = UINT32_MAX;
+
+    /**
+     * Approximate memory of one name in the table besides its characters.
+     */
+    static const size_t entryMemory = 64;
+
+    /**
+     * Capacity of the global() table, 16 MiB.
+     */
+    static const size_t defaultCapacity = 16u << 20;
+
+    /**
+     * @param capacity The bound of memory of the names in bytes, 0 stands for no bound.
+     */
+    explicit SymbolTable(size_t capacity = defaultCapacity);
+
+    SymbolTable(const SymbolTable &) = delete;
+    SymbolTable &operator=(const SymbolTable &) = delete;
+
+    /**
+     * Get the identifier of the name, a new one is assigned if the name is unknown.
+     * The caller gets a reference to the name, which must be given back by release().
+     *
+     * @param name The name.
+     * @return The identifier, none if the name is unknown and the table is full.
+     */
+    SymbolId intern(const std::string &name);
+
+    /**
+     * @param name The name.
+     * @return false if intern() would refuse the name at the moment.
+     */
+    bool canIntern(const std::string &name) const;
+
+    /**
+     * Take one more reference to the name, the name is not evicted until it is released.
+     *
+     * @param symbol The identifier, the name must be referenced by the caller.
+     * @return The name.
+     */
+    const std::string &acquire(SymbolId symbol);
+
+    /**
+     * Give back the reference taken by intern() or acquire().
+     */
+    void release(SymbolId symbol);
+
+    /**
+     * @param name The name.
+     * @return The identifier of the name or none if it is not interned. An 
+     * unreferenced name can be evicted at any time, the identifier is valid only
+     * as long as an expression contains the name.
+     */
+    SymbolId find(const std::string &name) const;
+
+    /**
+     * @param symbol The identifier, it must be obtained from this table.
+     * @return The name.
+     */
+    const std::string &nameOf(SymbolId symbol) const;
+
+    /**
+     * @return Number of identifiers, all of them are less than it.
+     */
+    size_t size() const;
+
+    /**
+     * @return Memory of the referenced names in bytes, they can not be evicted.
+     */
+    size_t referencedMemory() const;
+
+    /**
+     * Change the bound of memory of the names, the names already interned stay.
+     *
+     * @param capacity The bound in bytes, 0 stands for no bound.
+     */
+    void setCapacity(size_t capacity);
+
+    /**
+     * @return The table shared by all expressions.
+     */
+    static SymbolTable &global();
+};
+
+/**
+ * Reference to a name in SymbolTable::global() held by a container of 
+ * identifiers (e.g. FlatExpression), see SymbolTable::acquire().
+ */
+class SymbolReference {
+private:
+    SymbolId symbol;
+
+public:
+    /**
+     * @param symbol The identifier, the name must be referenced by the caller.
+     */
+    explicit SymbolReference(SymbolId symbol);
+    SymbolReference(const SymbolReference &other);
+    SymbolReference(SymbolReference &&other) noexcept;
+    ~SymbolReference();
+
+    SymbolReference &operator=(SymbolReference other) noexcept;
+};
+
+#endif /* SYMBOLTABLE_H */
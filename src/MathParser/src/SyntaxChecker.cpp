@@ -0,0 +1,340 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file SyntaxChecker.cpp
+ *
+ * Implementation of the validation of expression strings without building trees.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#include "SyntaxChecker.h"
+
+#include <cmath>
+#include <cstring>
+
+#include "Numbers.h"
+#include "ParserImpl.h"
+#include "SymbolTable.h"
+
+bool SyntaxChecker::Shape::isComplete() const {
+    if (this->kind == KTerminal) {
+        return true;
+    }
+    if (this->kind >= KSin) {
+        return this->lArg;
+    }
+    return this->lArg && this->rArg;
+}
+
+SyntaxChecker::SyntaxChecker(const std::string &text) : text(text), result{true, 0, nullptr} {
+}
+
+void SyntaxChecker::fail(size_t position, const char *reason) {
+    if (this->result.isValid) {
+        this->result = SyntaxCheck{false, position, reason};
+    }
+}
+
+std::string SyntaxChecker::valueOf(const Lexeme &lexeme) const {
+    std::string value;
+    for (size_t i = lexeme.position; i < lexeme.position + lexeme.length; i++) {
+        if (!ParserImpl::isWhitespace(this->text[i])) {
+            value += this->text[i];
+        }
+    }
+    return value;
+}
+
+bool SyntaxChecker::equals(const Lexeme &lexeme, const char *value) const {
+    if (lexeme.isSpaced) {
+        return this->valueOf(lexeme) == value;
+    }
+    return lexeme.length == std::strlen(value) && this->text.compare(lexeme.position, lexeme.length, value) == 0;
+}
+
+SyntaxChecker::Kind SyntaxChecker::functionOf(const Lexeme &lexeme) const {
+    if (lexeme.type != TAlphaNumeric) {
+        return KTerminal;
+    }
+    static const char *names[] = {"sin", "cos", "tan", "ctan", "ln", "exp"};
+    static const Kind kinds[] = {KSin, KCos, KTan, KCtan, KLn, KExp};
+    for (size_t i = 0; i < 6; i++) {
+        if (this->equals(lexeme, names[i])) {
+            return kinds[i];
+        }
+    }
+    // a variable
+    return KTerminal;
+}
+
+bool SyntaxChecker::hasPriority(Kind operation, const Lexeme *lookAhead) const {
+    if (lookAhead == nullptr) {
+        return false;
+    }
+    // see hasPriority() in Rule.cpp
+    switch (operation) {
+        case KSum:
+        case KSub:
+            if (lookAhead->type == TOperation) {
+                return this->equals(*lookAhead, "*") || this->equals(*lookAhead, "/")
+                        || this->equals(*lookAhead, "\\") || this->equals(*lookAhead, "^");
+            }
+            return true;
+        case KMult:
+        case KDiv:
+            if (lookAhead->type == TAlphaNumeric) {
+                return this->functionOf(*lookAhead) != KTerminal;
+            }
+            return lookAhead->type == TOperation && this->equals(*lookAhead, "^");
+        default:
+            return lookAhead->type == TAlphaNumeric && this->functionOf(*lookAhead) != KTerminal;
+    }
+}
+
+void SyntaxChecker::tokenize() {
+    // the same tokens as of ParserImpl::getTokens()
+    TokenType tokenType = TNoToken;
+    for (size_t i = 0; i < this->text.length(); i++) {
+        char c = this->text[i];
+        TokenType tokenTypeOfSymbol = TNoToken;
+        if (ParserImpl::isNumeric(c)) {
+            tokenTypeOfSymbol = TNumeric;
+        } else if (ParserImpl::isAlpha(c)) {
+            tokenTypeOfSymbol = TAlphaNumeric;
+        } else if (ParserImpl::isGroupBracket(c)) {
+            tokenTypeOfSymbol = TGroupBracket;
+        } else if (ParserImpl::isArithOperation(c)) {
+            tokenTypeOfSymbol = TOperation;
+        } else if (ParserImpl::isWhitespace(c)) {
+            continue;
+        } else {
+            this->fail(i, "Unknown character.");
+            return;
+        }
+
+        if (tokenType != tokenTypeOfSymbol || tokenType == TGroupBracket) {
+            this->lexemes.push_back(Lexeme{tokenTypeOfSymbol, i, 1, false});
+            tokenType = tokenTypeOfSymbol;
+            continue;
+        }
+        // whitespaces are skipped inside of tokens, e.g. "1 2" is 12
+        Lexeme &lexeme = this->lexemes.back();
+        lexeme.isSpaced = lexeme.isSpaced || lexeme.position + lexeme.length != i;
+        lexeme.length = i + 1 - lexeme.position;
+    }
+}
+
+bool SyntaxChecker::reduceFunction(Stack &stack, Kind function) {
+    for (size_t i = 0; i + 1 < stack.size(); i++) {
+        if (stack[i].kind == function && !stack[i].isComplete() && stack[i + 1].isComplete()) {
+            stack[i].lArg = true;
+            stack.erase(stack.begin() + i + 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SyntaxChecker::reduceLeftArgument(Stack &stack, Kind operation, const Lexeme *lookAhead) {
+    // RuleSumLV, RuleSubLV, RuleMultLV, RuleDivLV, RulePowLV
+    for (size_t i = 0; i + 1 < stack.size(); i++) {
+        Shape &op = stack[i + 1];
+        if (op.kind != operation || (i + 2 == stack.size() && this->hasPriority(operation, lookAhead))) {
+            continue;
+        }
+        if (!stack[i].isComplete() || op.isComplete() || op.lArg) {
+            continue;
+        }
+        op.lArg = true;
+        stack.erase(stack.begin() + i);
+        return true;
+    }
+    return false;
+}
+
+bool SyntaxChecker::reduceRightArgument(Stack &stack, Kind operation, const Lexeme *lookAhead) {
+    // RuleSumRV, RuleSubRV, RuleMultRV, RuleDivRV, RulePowRV
+    for (size_t i = 0; i + 1 < stack.size(); i++) {
+        Shape &op = stack[i];
+        if (op.kind != operation || (i + 2 == stack.size() && this->hasPriority(operation, lookAhead))) {
+            continue;
+        }
+        if (!stack[i + 1].isComplete() || op.isComplete()) {
+            continue;
+        }
+        if (!op.lArg) {
+            if (operation == KSum) {
+                // unary plus
+                stack.erase(stack.begin() + i);
+            } else if (operation == KSub) {
+                // negation, -1 * argument
+                op = Shape{KMult, true, true, op.position};
+                stack.erase(stack.begin() + i + 1);
+            } else {
+                this->fail(op.position, operation == KMult ? "No operand on the left side of '*'."
+                        : operation == KDiv ? "No operand on the left side of '/'." : "No operand on the left side of '^'.");
+                return false;
+            }
+            return true;
+        }
+        op.rArg = true;
+        stack.erase(stack.begin() + i + 1);
+        return true;
+    }
+    return false;
+}
+
+bool SyntaxChecker::reduceNoSignMult(Stack &stack, const Lexeme *lookAhead) {
+    for (size_t i = 0; i + 1 < stack.size(); i++) {
+        if (i + 2 == stack.size() && this->hasPriority(KMult, lookAhead)) {
+            return false;
+        }
+        if (stack[i].isComplete() && stack[i + 1].isComplete()) {
+            stack[i] = Shape{KMult, true, true, stack[i].position};
+            stack.erase(stack.begin() + i + 1);
+            return true;
+        }
+    }
+    return false;
+}
+
+bool SyntaxChecker::reduce(Stack &stack, const Lexeme *lookAhead) {
+    // in the order of ParserImpl::grammar
+    return this->reduceFunction(stack, KSin)
+            || this->reduceFunction(stack, KCos)
+            || this->reduceFunction(stack, KTan)
+            || this->reduceFunction(stack, KCtan)
+            || this->reduceFunction(stack, KLn)
+            || this->reduceFunction(stack, KExp)
+            || this->reduceLeftArgument(stack, KPow, lookAhead)
+            || (this->result.isValid && this->reduceRightArgument(stack, KPow, lookAhead))
+            || (this->result.isValid && this->reduceLeftArgument(stack, KMult, lookAhead))
+            || (this->result.isValid && this->reduceRightArgument(stack, KMult, lookAhead))
+            || (this->result.isValid && this->reduceNoSignMult(stack, lookAhead))
+            || (this->result.isValid && this->reduceLeftArgument(stack, KDiv, lookAhead))
+            || (this->result.isValid && this->reduceRightArgument(stack, KDiv, lookAhead))
+            || (this->result.isValid && this->reduceLeftArgument(stack, KSum, lookAhead))
+            || (this->result.isValid && this->reduceRightArgument(stack, KSum, lookAhead))
+            || (this->result.isValid && this->reduceLeftArgument(stack, KSub, lookAhead))
+            || (this->result.isValid && this->reduceRightArgument(stack, KSub, lookAhead));
+}
+
+size_t SyntaxChecker::findEndOfParentheses(size_t start, size_t end) {
+    int depth = 1;
+    for (size_t i = start; i < end; i++) {
+        if (this->lexemes[i].type != TGroupBracket) {
+            continue;
+        }
+        depth += this->text[this->lexemes[i].position] == '(' ? 1 : -1;
+        if (depth == 0) {
+            return i;
+        }
+    }
+    // the position of the opening bracket
+    this->fail(this->lexemes[start - 1].position, "No closing bracket has been found.");
+    return end;
+}
+
+size_t SyntaxChecker::shift(size_t current, size_t end, Stack &stack, unsigned int depth) {
+    const Lexeme &lexeme = this->lexemes[current];
+    Shape shape{KTerminal, false, false, lexeme.position};
+    if (lexeme.type == TNumeric) {
+        std::string spaced = lexeme.isSpaced ? this->valueOf(lexeme) : "";
+        const char *first = lexeme.isSpaced ? spaced.data() : this->text.data() + lexeme.position;
+        const char *last = first + (lexeme.isSpaced ? spaced.size() : lexeme.length);
+        double value;
+        if (parseNumber(first, last, value) != last) {
+            this->fail(lexeme.position, "Not a number token.");
+            return end;
+        }
+        if (std::isinf(value)) {
+            this->fail(lexeme.position, "Not a number token. (The number is out of range)");
+            return end;
+        }
+    } else if (lexeme.type == TOperation) {
+        // see ParserImpl::createOperation()
+        shape.kind = this->equals(lexeme, "+") ? KSum
+                : this->equals(lexeme, "-") ? KSub
+                : this->equals(lexeme, "*") ? KMult
+                : (this->equals(lexeme, "/") || this->equals(lexeme, "\\")) ? KDiv : KPow;
+    } else if (lexeme.type == TAlphaNumeric) {
+        shape.kind = this->functionOf(lexeme);
+        // ParserImpl interns the names of variables
+        if (shape.kind == KTerminal && !SymbolTable::global().canIntern(this->valueOf(lexeme))) {
+            this->fail(lexeme.position, "Too many names of variables.");
+            return end;
+        }
+    } else {
+        if (this->text[lexeme.position] == ')') {
+            this->fail(lexeme.position, "Unexpected closing bracket ')'.");
+            return end;
+        }
+        if (depth >= maxNestingDepth) {
+            this->fail(lexeme.position, "The expression is nested too deeply.");
+            return end;
+        }
+        ++current;
+        if (current == end) {
+            this->fail(lexeme.position + 1, "Unexpect end of the expression.");
+            return end;
+        }
+        size_t endParentheses = this->findEndOfParentheses(current, end);
+        if (!this->result.isValid) {
+            return end;
+        }
+        Stack subStack;
+        this->check(current, endParentheses, subStack, depth + 1);
+        if (!this->result.isValid) {
+            return end;
+        }
+        shape = subStack.front();
+        current = endParentheses;
+    }
+    stack.push_back(shape);
+    return current + 1;
+}
+
+void SyntaxChecker::check(size_t start, size_t end, Stack &stack, unsigned int depth) {
+    size_t first = start;
+    while (start != end) {
+        start = this->shift(start, end, stack, depth);
+        if (!this->result.isValid) {
+            return;
+        }
+        const Lexeme *lookAhead = start != end ? &this->lexemes[start] : nullptr;
+        while (this->reduce(stack, lookAhead)) {
+        }
+        if (!this->result.isValid) {
+            return;
+        }
+    }
+    if (stack.size() != 1) {
+        // the beginning of the expression which can not be reduced
+        size_t position = first < this->lexemes.size() ? this->lexemes[first].position : this->text.size();
+        this->fail(position, "The specified expression is ambiguous. Not able to completely reduce syntax tree.");
+    } else if (!stack.front().isComplete()) {
+        // the left operand is missing before the operation, the others after the last token
+        const Shape &shape = stack.front();
+        const Lexeme &last = this->lexemes[end - 1];
+        bool isLeftMissing = shape.kind < KSin && !shape.lArg;
+        this->fail(isLeftMissing ? shape.position : last.position + last.length, "The expression is incomplete. An operand or argument is missing.");
+    }
+}
+
+SyntaxCheck SyntaxChecker::check() {
+    this->tokenize();
+    if (this->result.isValid) {
+        Stack stack;
+        this->check(0, this->lexemes.size(), stack, 0);
+    }
+    return this->result;
+}
+
+SyntaxCheck checkSyntax(const std::string &strExpr) {
+    SyntaxChecker checker(strExpr);
+    return checker.check();
+}
@@ -0,0 +1,86 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file SyntaxChecker.h
+ *
+ * Definition of the validation of expression strings without building trees.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#ifndef SYNTAXCHECKER_H
+#define SYNTAXCHECKER_H
+
+#include <string>
+#include <vector>
+
+#include "Parser.h"
+#include "Token.h"
+
+/**
+ * Runs the shift-reduce algorithm of ParserImpl on shapes of expressions: the
+ * grammar rules depend only on the kind of an expression and on which of its
+ * arguments are set, so the stack holds these instead of allocated trees.
+ * The string is accepted exactly when ParserImpl accepts it, the first error
+ * is the one ParserImpl reports.
+ */
+class SyntaxChecker {
+private:
+
+    enum Kind : unsigned char {
+        KTerminal, KSum, KSub, KMult, KDiv, KPow, KSin, KCos, KTan, KCtan, KLn, KExp
+    };
+
+    struct Lexeme {
+        TokenType type;
+        size_t position;
+        size_t length;
+        bool isSpaced; // contains whitespaces, which are not a part of the value
+    };
+
+    struct Shape {
+        Kind kind;
+        bool lArg; // the argument of functions
+        bool rArg;
+        size_t position;
+
+        bool isComplete() const;
+    };
+
+    typedef std::vector<Shape> Stack;
+
+    const std::string &text;
+    std::vector<Lexeme> lexemes;
+    SyntaxCheck result;
+
+    void fail(size_t position, const char *reason);
+
+    std::string valueOf(const Lexeme &lexeme) const;
+    bool equals(const Lexeme &lexeme, const char *value) const;
+    Kind functionOf(const Lexeme &lexeme) const;
+    bool hasPriority(Kind operation, const Lexeme *lookAhead) const;
+
+    void tokenize();
+
+    // the grammar rules, see ParserImpl::ParserImpl()
+    bool reduceFunction(Stack &stack, Kind function);
+    bool reduceLeftArgument(Stack &stack, Kind operation, const Lexeme *lookAhead);
+    bool reduceRightArgument(Stack &stack, Kind operation, const Lexeme *lookAhead);
+    bool reduceNoSignMult(Stack &stack, const Lexeme *lookAhead);
+    bool reduce(Stack &stack, const Lexeme *lookAhead);
+
+    size_t findEndOfParentheses(size_t start, size_t end);
+    // depth is the number of the enclosing parentheses, see maxNestingDepth
+    size_t shift(size_t current, size_t end, Stack &stack, unsigned int depth);
+    void check(size_t start, size_t end, Stack &stack, unsigned int depth);
+
+public:
+    explicit SyntaxChecker(const std::string &text);
+
+    SyntaxCheck check();
+};
+
+#endif /* SYNTAXCHECKER_H */
@@ -13,11 +13,16 @@
 
 #include "Tan.h"
 #include "Visitor.h"
+#include "ReferenceVisitor.h"
 #include "TraverseException.h"
 
 Tan::Tan() : Expression(ETan) {
 }
 
+Tan::~Tan() {
+    releaseArgument(this->arg);
+}
+
 bool Tan::isComplete() const {
     return (this->arg!=nullptr);
 }
@@ -26,4 +31,8 @@ void Tan::traverse(Visitor& visitor) const throw(TraverseException) {
     visitor.visit(shared_from_this());
 }
 
+void Tan::accept(ReferenceVisitor &visitor) const throw (TraverseException) {
+    visitor.visit(*this);
+}
+
 
@@ -11,18 +11,42 @@
  * \author agor
  */
 
+#include "ExceptionThrower.h"
 #include "Variable.h"
 #include "Visitor.h"
+#include "ReferenceVisitor.h"
 
-Variable::Variable() : Expression(EVariable) {
+Variable::Variable() : Variable(SymbolTable::emptySymbol) {
 }
 
-Variable::Variable(string name) : Expression(EVariable), name(name) {}
+static SymbolId internName(const string &name) throw (TraverseException) {
+    SymbolId symbol = SymbolTable::global().intern(name);
+    if (symbol == SymbolTable::none) {
+        THROW(TraverseException, "Too many names of variables.", name);
+    }
+    return symbol;
+}
+
+Variable::Variable(const string &name) throw (TraverseException) : Variable(internName(name)) {
+    // the delegated constructor has taken its own reference
+    SymbolTable::global().release(this->symbol);
+}
+
+Variable::Variable(SymbolId symbol) : Expression(EVariable), symbol(symbol), name(SymbolTable::global().acquire(symbol)) {
+}
+
+Variable::~Variable() {
+    SymbolTable::global().release(this->symbol);
+}
 
  void Variable::traverse(Visitor &visitor) const throw(TraverseException) {
 	visitor.visit(shared_from_this());
 }
 
+void Variable::accept(ReferenceVisitor &visitor) const throw (TraverseException) {
+	visitor.visit(*this);
+}
+
  bool Variable::isComplete() const{
 	return true;
 }
\ No newline at end of file
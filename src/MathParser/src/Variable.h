@@ -17,6 +17,7 @@
 #include <string>
 
 #include "Expression.h"
+#include "SymbolTable.h"
 
 using namespace std;
 
@@ -25,11 +26,26 @@ private:
     Variable();
 
 public:
-    const string name;
-
-    Variable(string name);
+    /**
+     * Identifier of the name in SymbolTable::global().
+     */
+    const SymbolId symbol;
+    
+    /**
+     * The name, it is stored in SymbolTable::global() and referenced by the Variable.
+     */
+    const string &name;
+
+    /**
+     * @param name The name, it is interned in SymbolTable::global().
+     * @throws TraverseException if the SymbolTable is full.
+     */
+    Variable(const string &name) throw (TraverseException);
+    Variable(SymbolId symbol);
+    ~Variable();
 
     void traverse(Visitor &) const throw (TraverseException) final;
+    void accept(ReferenceVisitor &) const throw (TraverseException) final;
 
     bool isComplete() const final;
     
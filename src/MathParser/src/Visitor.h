@@ -34,19 +34,19 @@
 class Visitor
 {
 public:	
-	virtual void visit(const PConstConstant expr) throw(TraverseException) = 0;
-	virtual void visit(const PConstVariable expr) throw(TraverseException) = 0;
-	virtual void visit(const PConstSum expr) throw(TraverseException) = 0;
-	virtual void visit(const PConstSub expr) throw(TraverseException) = 0;
-	virtual void visit(const PConstDiv expr) throw(TraverseException) = 0;
-	virtual void visit(const PConstMult expr) throw(TraverseException) = 0;
-        virtual void visit(const PConstPow expr) throw(TraverseException) = 0;
-        virtual void visit(const PConstSin expr) throw(TraverseException) = 0;
-        virtual void visit(const PConstCos expr) throw(TraverseException) = 0;
-        virtual void visit(const PConstTan expr) throw(TraverseException) = 0;
-        virtual void visit(const PConstCtan expr) throw(TraverseException) = 0;
-        virtual void visit(const PConstLn expr) throw(TraverseException) = 0;
-        virtual void visit(const PConstExp expr) throw(TraverseException) = 0;
+	virtual void visit(const PConstConstant &expr) throw(TraverseException) = 0;
+	virtual void visit(const PConstVariable &expr) throw(TraverseException) = 0;
+	virtual void visit(const PConstSum &expr) throw(TraverseException) = 0;
+	virtual void visit(const PConstSub &expr) throw(TraverseException) = 0;
+	virtual void visit(const PConstDiv &expr) throw(TraverseException) = 0;
+	virtual void visit(const PConstMult &expr) throw(TraverseException) = 0;
+        virtual void visit(const PConstPow &expr) throw(TraverseException) = 0;
+        virtual void visit(const PConstSin &expr) throw(TraverseException) = 0;
+        virtual void visit(const PConstCos &expr) throw(TraverseException) = 0;
+        virtual void visit(const PConstTan &expr) throw(TraverseException) = 0;
+        virtual void visit(const PConstCtan &expr) throw(TraverseException) = 0;
+        virtual void visit(const PConstLn &expr) throw(TraverseException) = 0;
+        virtual void visit(const PConstExp &expr) throw(TraverseException) = 0;
 };
 
 #endif	/* VISITOR_H */
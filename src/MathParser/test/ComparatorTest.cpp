@@ -275,4 +275,27 @@ TEST_F(FX_Comparator, visit_WhatIfLeftExprIsNull_TraverseException) {
     Comparator comparator(sum);
     PSum sumBeingCompared; // it is nullptr
     EXPECT_THROW(comparator.visit(sumBeingCompared), TraverseException);
-}
\ No newline at end of file
+}
+TEST_F(FX_Comparator, accept_IdenticalExpressions_Equal) {
+    PExpression expr1 = createSin(createSum(createVariable("x"), createConstant(1.0)));
+    PExpression expr2 = createSin(createSum(createConstant(1.0), createVariable("x")));
+
+    Comparator comparator(expr2);
+    expr1->accept(comparator);
+    ASSERT_TRUE(comparator.areEqual());
+    ASSERT_EQ(1, expr1.use_count());
+}
+
+TEST_F(FX_Comparator, accept_VisitorAdapter_SameAsTraverse) {
+    PExpression expr1 = createMult(createVariable("x"), createVariable("y"));
+    PExpression expr2 = createMult(createVariable("x"), createVariable("z"));
+
+    Comparator comparator(expr2);
+    VisitorAdapter adapter(comparator);
+    expr1->accept(adapter);
+    ASSERT_FALSE(comparator.areEqual());
+
+    Comparator comparator2(createMult(createVariable("x"), nullptr));
+    VisitorAdapter adapter2(comparator2);
+    EXPECT_THROW(expr1->accept(adapter2), TraverseException);
+}
@@ -0,0 +1,72 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file EquivalenceTest.cpp
+ *
+ * Test cases for probablyEquivalent().
+ *
+ * @since 18.10.2026
+ * @author agor
+ */
+
+#include <gtest/gtest.h>
+
+#include "Equivalence.h"
+#include "Parser.h"
+#include "ExpressionFactory.h"
+
+class FX_Equivalence : public testing::Test {
+protected:
+
+    virtual void SetUp() {
+    }
+
+    virtual void TearDown() {
+    }
+
+    bool equivalent(const std::string &exprL, const std::string &exprR) {
+        return probablyEquivalent(*parse(exprL), *parse(exprR));
+    }
+};
+
+TEST_F(FX_Equivalence, probablyEquivalent_AlgebraicallyEqual_True) {
+    ASSERT_TRUE(equivalent("x", "x"));
+    ASSERT_TRUE(equivalent("2*(x+1)", "2*x+2"));
+    ASSERT_TRUE(equivalent("(x+y)^2", "x^2+2*x*y+y^2"));
+    ASSERT_TRUE(equivalent("sin(x)^2+cos(x)^2", "1"));
+    ASSERT_TRUE(equivalent("ln(exp(x*y))", "y*x"));
+    ASSERT_TRUE(equivalent("x/x", "1"));
+}
+
+TEST_F(FX_Equivalence, probablyEquivalent_DifferentFunctions_False) {
+    ASSERT_FALSE(equivalent("x", "y"));
+    ASSERT_FALSE(equivalent("x+1", "x+1.001"));
+    ASSERT_FALSE(equivalent("sin(x)", "cos(x)"));
+    ASSERT_FALSE(equivalent("x^2", "x^3"));
+    ASSERT_FALSE(equivalent("(x+y)^2", "x^2+y^2"));
+}
+
+TEST_F(FX_Equivalence, probablyEquivalent_NoConclusivePoint_StructuralComparison) {
+    // the logarithm of a negative number is never finite
+    ASSERT_TRUE(equivalent("ln(0-x-1)", "ln(0-x-1)"));
+    ASSERT_FALSE(equivalent("ln(0-x-1)", "ln(0-x-2)"));
+}
+
+TEST_F(FX_Equivalence, probablyEquivalent_SameSeed_SameResult) {
+    EquivalenceOptions options;
+    options.points = 1;
+    options.tolerance = 0.05;
+    PExpression exprL = parse("x");
+    PExpression exprR = parse("x+0.1*sin(50*x)");
+
+    bool first = probablyEquivalent(*exprL, *exprR, options);
+    for (int i = 0; i < 10; i++) {
+        ASSERT_EQ(first, probablyEquivalent(*exprL, *exprR, options));
+    }
+}
+
+TEST_F(FX_Equivalence, probablyEquivalent_IncompleteExpression_TraverseException) {
+    ASSERT_THROW(probablyEquivalent(*createSum(createVariable("x"), nullptr), *parse("x")), TraverseException);
+}
@@ -0,0 +1,83 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file EvaluatorTest.cpp
+ *
+ * Test cases for evaluate().
+ *
+ * @since 18.10.2026
+ * @author agor
+ */
+
+#include <gtest/gtest.h>
+#include <cmath>
+#include <map>
+
+#include "Evaluator.h"
+#include "Parser.h"
+#include "ExpressionFactory.h"
+
+class FX_Evaluator : public testing::Test {
+protected:
+
+    class MapValues : public VariableValues {
+    public:
+        std::map<std::string, double> values;
+
+        double valueOf(const std::string &name) const final {
+            return this->values.at(name);
+        }
+    };
+
+    MapValues values;
+
+    virtual void SetUp() {
+        values.values["x"] = 0.5;
+        values.values["y"] = 2.0;
+    }
+
+    virtual void TearDown() {
+    }
+};
+
+TEST_F(FX_Evaluator, evaluate_AllOperations_Calculated) {
+    ASSERT_DOUBLE_EQ(3.0, evaluate(*parse("3"), values));
+    ASSERT_DOUBLE_EQ(0.5, evaluate(*parse("x"), values));
+    ASSERT_DOUBLE_EQ(2.5, evaluate(*parse("x+y"), values));
+    ASSERT_DOUBLE_EQ(-1.5, evaluate(*parse("x-y"), values));
+    ASSERT_DOUBLE_EQ(1.0, evaluate(*parse("x*y"), values));
+    ASSERT_DOUBLE_EQ(0.25, evaluate(*parse("x/y"), values));
+    ASSERT_DOUBLE_EQ(0.25, evaluate(*parse("x^y"), values));
+    ASSERT_DOUBLE_EQ(std::sin(0.5), evaluate(*parse("sin(x)"), values));
+    ASSERT_DOUBLE_EQ(std::cos(0.5), evaluate(*parse("cos(x)"), values));
+    ASSERT_DOUBLE_EQ(std::tan(0.5), evaluate(*parse("tan(x)"), values));
+    ASSERT_DOUBLE_EQ(1.0 / std::tan(0.5), evaluate(*parse("ctan(x)"), values));
+    ASSERT_DOUBLE_EQ(std::log(0.5), evaluate(*parse("ln(x)"), values));
+    ASSERT_DOUBLE_EQ(std::exp(0.5), evaluate(*parse("exp(x)"), values));
+    ASSERT_DOUBLE_EQ(std::sin(1.0) * 2.0 + 1.0, evaluate(*parse("sin(x*y)*y+1"), values));
+}
+
+TEST_F(FX_Evaluator, evaluate_UndefinedInPoint_NotFinite) {
+    ASSERT_FALSE(std::isfinite(evaluate(*parse("1/(y-2)"), values)));
+    ASSERT_TRUE(std::isnan(evaluate(*parse("ln(x-y)"), values)));
+}
+
+TEST_F(FX_Evaluator, evaluate_IncompleteExpression_TraverseException) {
+    ASSERT_THROW(evaluate(*createSum(createVariable("x"), nullptr), values), TraverseException);
+    ASSERT_THROW(evaluate(*createSin(), values), TraverseException);
+}
+
+TEST_F(FX_Evaluator, evaluate_SymbolValues_IndexedBySymbol) {
+    PExpression expr = parse("x*y+z");
+    SymbolValues symbolValues;
+    symbolValues.set("x", 0.5);
+    symbolValues.set(SymbolTable::global().find("y"), 2.0);
+
+    ASSERT_TRUE(std::isnan(evaluate(*expr, symbolValues)));
+    symbolValues.set("z", 3.0);
+    ASSERT_DOUBLE_EQ(4.0, evaluate(*expr, symbolValues));
+    ASSERT_DOUBLE_EQ(2.0, symbolValues.valueOf("y"));
+    ASSERT_TRUE(std::isnan(symbolValues.valueOf("notInternedName")));
+}
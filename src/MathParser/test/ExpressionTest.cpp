@@ -13,6 +13,9 @@
 
 #include <gtest/gtest.h>
 
+#include <thread>
+#include <vector>
+
 #include "ExpressionFactory.h"
 
 class FX_Expression : public testing::Test {
@@ -57,4 +60,69 @@ TEST_F(FX_Expression, equals_NullArguments_False) {
     
     EXPECT_FALSE(equals(nullptr, varX));
     EXPECT_FALSE(equals(varX, nullptr));
-}
\ No newline at end of file
+}
+TEST_F(FX_Expression, getHash_EqualExpressions_EqualHashes) {
+    // commutative arguments in different order
+    ASSERT_EQ(createSum(createVariable("x"), createSin(createVariable("y")))->getHash(),
+            createSum(createSin(createVariable("y")), createVariable("x"))->getHash());
+    ASSERT_EQ(createMult(createConstant(2.0), createVariable("x"))->getHash(),
+            createMult(createVariable("x"), createConstant(2.0))->getHash());
+    // constants which are equal with the precision of equals()
+    ASSERT_EQ(createConstant(1.0)->getHash(), createConstant(1.0 + 1e-12)->getHash());
+}
+
+TEST_F(FX_Expression, getHash_DifferentExpressions_DifferentHashes) {
+    ASSERT_NE(createVariable("x")->getHash(), createVariable("y")->getHash());
+    ASSERT_NE(createSub(createVariable("x"), createVariable("y"))->getHash(),
+            createSub(createVariable("y"), createVariable("x"))->getHash());
+    ASSERT_NE(createSin(createVariable("x"))->getHash(), createCos(createVariable("x"))->getHash());
+}
+
+TEST_F(FX_Expression, getHash_IncompleteExpression_NotCached) {
+    PSum sum = createSum(createVariable("x"), nullptr);
+    size_t incompleteHash = sum->getHash();
+    sum->rArg = createVariable("y");
+
+    ASSERT_NE(incompleteHash, sum->getHash());
+    ASSERT_EQ(createSum(createVariable("x"), createVariable("y"))->getHash(), sum->getHash());
+}
+
+TEST_F(FX_Expression, getHash_SharedTreeHashedByThreads_SameHash) {
+    PExpression expr = createVariable("x");
+    for (int i = 1; i < 2000; i++) {
+        expr = createSum(createSin(expr), createMult(createConstant(i), createVariable("y")));
+    }
+    size_t expected = createSum(createSin(expr), createVariable("x"))->getHash();
+
+    // the fresh tree is hashed by all threads at once
+    PExpression shared = createSum(createSin(expr), createVariable("x"));
+    std::vector<size_t> hashes(4);
+    std::vector<std::thread> threads;
+    for (size_t n = 0; n < hashes.size(); n++) {
+        threads.emplace_back([&shared, &hashes, n]() {
+            hashes[n] = shared->getHash();
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+    for (size_t hash : hashes) {
+        ASSERT_EQ(expected, hash);
+    }
+}
+
+TEST_F(FX_Expression, equals_DeepCommutativeChains_Compared) {
+    // x1+(x2+(x3+...)) versus the same chain with swapped arguments on each level;
+    // comparing all orders of arguments would take 4^depth traversals
+    PExpression chain = createVariable("x0");
+    PExpression swappedChain = createVariable("x0");
+    for (int i = 1; i < 200; i++) {
+        PExpression var = createVariable("x" + std::to_string(i));
+        chain = createSum(var, createMult(createConstant(2.0), chain));
+        swappedChain = createSum(createMult(swappedChain, createConstant(2.0)), var);
+    }
+    ASSERT_TRUE(equals(chain, swappedChain));
+
+    PExpression differentChain = createSum(createVariable("z"), chain);
+    ASSERT_FALSE(equals(differentChain, createSum(createVariable("y"), swappedChain)));
+}
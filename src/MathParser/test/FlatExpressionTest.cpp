@@ -0,0 +1,163 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file FlatExpressionTest.cpp
+ *
+ * Test cases for FlatExpression.
+ *
+ * @since 18.10.2026
+ * @author agor
+ */
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "FlatExpression.h"
+#include "StructuralEquality.h"
+#include "Parser.h"
+#include "ExpressionFactory.h"
+
+class FX_FlatExpression : public testing::Test {
+protected:
+
+    virtual void SetUp() {
+    }
+
+    virtual void TearDown() {
+    }
+};
+
+TEST_F(FX_FlatExpression, flatten_Expressions_SameTextAndTree) {
+    const char *expressions[] = {
+        "x", "2.5", "x+3", "3-x*y", "(x+1)*(x+2)/y", "x^2^y",
+        "sin(x)+cos(x)*tan(x)-ctan(x)", "ln(x^2+2*x)/exp(x)", "sin(cos(tan(x)))"
+    };
+
+    for (const char *strExpr : expressions) {
+        PExpression expr = parse(strExpr);
+        FlatExpression flat = flatten(*expr);
+
+        ASSERT_EQ(to_string(expr), to_string(flat)) << strExpr;
+        ASSERT_TRUE(structurallyEqual(*expr, *flat.toExpression())) << strExpr;
+    }
+}
+
+TEST_F(FX_FlatExpression, flatten_NodesInPostOrder) {
+    FlatExpression flat = flatten(*parse("sin(x)*2"));
+
+    ASSERT_EQ(4u, flat.size());
+    ASSERT_EQ(EMult, flat.type(flat.root()));
+    ASSERT_EQ(EVariable, flat.type(0));
+    ASSERT_EQ("x", flat.name(0));
+    ASSERT_EQ(ESin, flat.type(1));
+    ASSERT_EQ(0u, flat.lArg(1));
+    ASSERT_EQ(FlatExpression::none, flat.rArg(1));
+    ASSERT_EQ(EConstant, flat.type(2));
+    ASSERT_DOUBLE_EQ(2.0, flat.value(2));
+    ASSERT_EQ(1u, flat.lArg(3));
+    ASSERT_EQ(2u, flat.rArg(3));
+}
+
+TEST_F(FX_FlatExpression, flatten_IncompleteExpression_TraverseException) {
+    PExpression expr = createSum(createVariable("x"), createSin(nullptr));
+
+    ASSERT_THROW(flatten(*expr), TraverseException);
+}
+
+TEST_F(FX_FlatExpression, addNode_ArgumentNotAddedYet_TraverseException) {
+    FlatExpression flat;
+    FlatExpression::Index x = flat.addVariable("x");
+
+    ASSERT_THROW(flat.addNode(ESum, x, x + 1), TraverseException);
+    ASSERT_THROW(flat.addNode(EConstant, x), TraverseException);
+    ASSERT_NO_THROW(flat.addNode(ESum, x, x));
+}
+
+TEST_F(FX_FlatExpression, compact_SharedAndUnreachableNodes) {
+    FlatExpression flat;
+    FlatExpression::Index x = flat.addVariable("x");
+    flat.addConstant(42.0); // unreachable
+    FlatExpression::Index sinX = flat.addNode(ESin, x);
+    FlatExpression::Index root = flat.addNode(EMult, sinX, sinX);
+    flat.addNode(ECos, root); // unreachable
+
+    FlatExpression compacted = flat.compact(root);
+
+    ASSERT_EQ(3u, compacted.size());
+    ASSERT_EQ("sin(x)*sin(x)", to_string(compacted));
+    PExpression expr = compacted.toExpression();
+    ASSERT_EQ(SPointerCast<Mult>(expr)->lArg, SPointerCast<Mult>(expr)->rArg);
+}
+
+TEST_F(FX_FlatExpression, memoryUsage_FewBytesPerNode) {
+    PExpression expr = createVariable("x");
+    for (int i = 0; i < 10000; i++) {
+        expr = createSum(expr, createMult(createVariable("y"), createSin(createVariable("x"))));
+    }
+
+    FlatExpression flat = flatten(*expr);
+
+    ASSERT_EQ(50001u, flat.size());
+    ASSERT_LT(flat.memoryUsage(), 16 * flat.size());
+}
+
+TEST_F(FX_FlatExpression, toString_VeryDeepExpression_NoStackOverflow) {
+    PExpression expr = createVariable("x");
+    for (int i = 0; i < 200000; i++) {
+        expr = createSum(expr, createVariable("y"));
+    }
+
+    FlatExpression flat = flatten(*expr);
+
+    ASSERT_EQ(to_string(expr), to_string(flat));
+}
+
+TEST_F(FX_FlatExpression, flattenShared_IdenticalSubtrees_OneNode) {
+    PExpression expr = parse("sin(x+y)*cos(x+y)+sin(x+y)");
+
+    FlatExpression flat = flattenShared(*expr);
+
+    // x, y, x+y, sin, cos, *, +
+    ASSERT_EQ(7u, flat.size());
+    ASSERT_EQ(to_string(expr), to_string(flat));
+    ASSERT_TRUE(structurallyEqual(*expr, *flat.toExpression()));
+}
+
+TEST_F(FX_FlatExpression, flattenShared_SharedSubtrees_TraversedOnce) {
+    // the expanded tree has 2^61-1 nodes
+    PExpression expr = createVariable("x");
+    for (int i = 0; i < 60; i++) {
+        expr = createMult(expr, expr);
+    }
+
+    FlatExpression flat = flattenShared(*expr);
+
+    ASSERT_EQ(61u, flat.size());
+}
+
+TEST_F(FX_FlatExpression, printLet_RepeatedSubexpressions_Temporaries) {
+    ASSERT_EQ("t1 = x+y; t2 = sin(t1); result = (t2*cos(t1))+t2",
+            to_let_string(flattenShared(*parse("sin(x+y)*cos(x+y)+sin(x+y)"))));
+    ASSERT_EQ("t1 = x^2; result = ln(t1)/t1", to_let_string(flattenShared(*parse("ln(x^2)/x^2"))));
+    // leaves are not bound
+    ASSERT_EQ("(x*2)+(x*y)", to_let_string(flattenShared(*parse("x*2+x*y"))));
+    ASSERT_EQ("?", to_let_string(FlatExpression()));
+}
+
+TEST_F(FX_FlatExpression, printLet_ExponentialTree_LinearOutput) {
+    PExpression expr = createSin(createVariable("x"));
+    for (int i = 0; i < 60; i++) {
+        expr = createMult(expr, createCos(expr));
+    }
+    std::ostringstream out;
+
+    printLet(out, flattenShared(*expr), 3);
+
+    std::string text = out.str();
+    ASSERT_EQ(0u, text.find("t1 = sin(x); t2 = t1*cos(t1); t3 = t2*cos(t2);"));
+    ASSERT_EQ("result = t60*cos(t60)", text.substr(text.rfind("; ") + 2));
+    ASSERT_LT(text.size(), 2000u);
+}
@@ -0,0 +1,79 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file LruCacheTest.cpp
+ *
+ * Test cases for LruCache.
+ *
+ * @since 18.10.2026
+ * @author agor
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "LruCache.h"
+
+class FX_LruCache : public testing::Test {
+protected:
+
+    virtual void SetUp() {
+    }
+
+    virtual void TearDown() {
+    }
+};
+
+TEST_F(FX_LruCache, put_FullCache_LeastRecentlyUsedEvicted) {
+    LruCache<std::string, int> cache(2);
+    cache.put("a", 1);
+    cache.put("b", 2);
+
+    ASSERT_EQ(1, *cache.find("a"));
+    cache.put("c", 3);
+
+    ASSERT_EQ(2u, cache.size());
+    ASSERT_EQ(nullptr, cache.find("b"));
+    ASSERT_EQ(1, *cache.find("a"));
+    ASSERT_EQ(3, *cache.find("c"));
+    ASSERT_EQ(1u, cache.getStatistics().evictions);
+}
+
+TEST_F(FX_LruCache, put_ExistingKey_ValueReplacedAndUsed) {
+    LruCache<std::string, int> cache(2);
+    cache.put("a", 1);
+    cache.put("b", 2);
+
+    cache.put("a", 10);
+    cache.put("c", 3);
+
+    ASSERT_EQ(10, *cache.find("a"));
+    ASSERT_EQ(nullptr, cache.find("b"));
+}
+
+TEST_F(FX_LruCache, find_Statistics_HitRate) {
+    LruCache<int, int> cache(4);
+    ASSERT_DOUBLE_EQ(0.0, cache.getStatistics().hitRate());
+    cache.put(1, 1);
+
+    cache.find(1);
+    cache.find(1);
+    cache.find(1);
+    cache.find(2);
+
+    ASSERT_EQ(3u, cache.getStatistics().hits);
+    ASSERT_EQ(1u, cache.getStatistics().misses);
+    ASSERT_DOUBLE_EQ(0.75, cache.getStatistics().hitRate());
+}
+
+TEST_F(FX_LruCache, put_ZeroCapacity_NothingCached) {
+    LruCache<int, int> cache(0);
+
+    cache.put(1, 1);
+
+    ASSERT_EQ(0u, cache.size());
+    ASSERT_EQ(nullptr, cache.find(1));
+}
@@ -0,0 +1,146 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file NumbersTest.cpp
+ *
+ * Test cases for parseNumber() and formatNumber().
+ *
+ * @since 18.10.2026
+ * @author agor
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdlib>
+#include <iomanip>
+#include <random>
+#include <sstream>
+#include <string>
+
+#include "Numbers.h"
+
+class FX_Numbers : public testing::Test {
+protected:
+
+    virtual void SetUp() {
+    }
+
+    virtual void TearDown() {
+    }
+
+    static double parse(const std::string &text, size_t *parsedLength = nullptr) {
+        double value = -1.0;
+        const char *end = parseNumber(text.data(), text.data() + text.size(), value);
+        if (parsedLength != nullptr) {
+            *parsedLength = end - text.data();
+        }
+        return value;
+    }
+
+    static std::string format(double value, int precision) {
+        char buffer[maxNumberLength];
+        return std::string(buffer, formatNumber(value, precision, buffer));
+    }
+
+    static std::string formatByStream(double value, int precision) {
+        std::stringstream stream;
+        stream << std::defaultfloat << std::setprecision(precision) << value;
+        return stream.str();
+    }
+};
+
+TEST_F(FX_Numbers, parseNumber_DecimalNumbers_Exact) {
+    ASSERT_EQ(3.0, parse("3"));
+    ASSERT_EQ(3.7, parse("3.7"));
+    ASSERT_EQ(5.3, parse("5,3"));
+    ASSERT_EQ(0.05, parse("0.05"));
+    ASSERT_EQ(0.1, parse(".1"));
+    ASSERT_EQ(2.0, parse("2."));
+    ASSERT_EQ(-12.5, parse("-12.5"));
+    ASSERT_EQ(1.5e10, parse("1.5e10"));
+    ASSERT_EQ(2.5e-3, parse("25E-4"));
+    ASSERT_EQ(123456789012345.0, parse("123456789012345"));
+    ASSERT_TRUE(std::signbit(parse("-0")));
+}
+
+TEST_F(FX_Numbers, parseNumber_ManyDigitsAndLargeExponents_SameAsStrtod) {
+    const char *texts[] = {
+        "3.14159265358979323846", "12345678901234567890123", "0.000000000000000000000000123",
+        "1e300", "2.2250738585072014e-308", "9007199254740993", "1.7976931348623157e308"
+    };
+
+    for (const char *text : texts) {
+        ASSERT_EQ(std::strtod(text, nullptr), parse(text)) << text;
+    }
+    ASSERT_TRUE(std::isinf(parse("1e999")));
+    ASSERT_EQ(0.0, parse("1e-999"));
+}
+
+TEST_F(FX_Numbers, parseNumber_RandomNumbers_SameAsStrtod) {
+    std::mt19937_64 random(42);
+    std::uniform_int_distribution<int> exponents(-30, 30);
+    for (int i = 0; i < 2000; i++) {
+        std::stringstream stream;
+        stream << (random() % 10000000) << "." << (random() % 100000000) << "e" << exponents(random);
+        std::string text = stream.str();
+        ASSERT_EQ(std::strtod(text.c_str(), nullptr), parse(text)) << text;
+    }
+}
+
+TEST_F(FX_Numbers, parseNumber_TrailingText_StopsAfterNumber) {
+    size_t length;
+
+    ASSERT_EQ(1.2, parse("1.2.3", &length));
+    ASSERT_EQ(3u, length);
+    ASSERT_EQ(5.0, parse("5e", &length));
+    ASSERT_EQ(1u, length);
+    ASSERT_EQ(-1.0, parse("...", &length));
+    ASSERT_EQ(0u, length);
+    ASSERT_EQ(-1.0, parse("-x", &length));
+    ASSERT_EQ(0u, length);
+}
+
+TEST_F(FX_Numbers, formatNumber_Numbers_SameAsStream) {
+    const double values[] = {
+        0.0, -0.0, 1.0, -1.0, 2.0, 10.0, 99.0, 100.0, 0.5, 0.125, 0.25, -2.5, 1.0 / 3.0,
+        12345.678, 1e-5, 1e21, 123456789.0, 9007199254740993.0, INFINITY, -INFINITY
+    };
+
+    for (int precision = 1; precision <= maxNumberPrecision; precision++) {
+        for (double value : values) {
+            ASSERT_EQ(formatByStream(value, precision), format(value, precision)) << value << " " << precision;
+        }
+    }
+}
+
+TEST_F(FX_Numbers, formatNumber_RandomNumbers_SameAsStream) {
+    std::mt19937_64 random(7);
+    std::uniform_real_distribution<double> mantissas(-10.0, 10.0);
+    std::uniform_int_distribution<int> exponents(-20, 20);
+    for (int i = 0; i < 2000; i++) {
+        double value = mantissas(random) * std::pow(10.0, exponents(random));
+        if (i % 3 == 0) {
+            value = std::round(value);
+        }
+        for (int precision : {2, 6, 17}) {
+            ASSERT_EQ(formatByStream(value, precision), format(value, precision)) << value;
+        }
+    }
+}
+
+TEST_F(FX_Numbers, formatNumber_PrecisionOutOfRange_Limited) {
+    ASSERT_EQ("0.3", format(1.0 / 3.0, 0));
+    ASSERT_EQ("0.33333333333333331", format(1.0 / 3.0, 100));
+}
+
+TEST_F(FX_Numbers, formatNumber_ParseNumber_RoundTrip) {
+    std::mt19937_64 random(3);
+    std::uniform_real_distribution<double> values(-1e6, 1e6);
+    for (int i = 0; i < 1000; i++) {
+        double value = values(random);
+        ASSERT_EQ(value, parse(format(value, maxNumberPrecision)));
+    }
+}
@@ -0,0 +1,90 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file ParseCacheTest.cpp
+ *
+ * Test cases for ParseCache.
+ *
+ * @since 18.10.2026
+ * @author agor
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+#include "ParseCache.h"
+#include "Parser.h"
+#include "StructuralEquality.h"
+
+class FX_ParseCache : public testing::Test {
+protected:
+
+    virtual void SetUp() {
+    }
+
+    virtual void TearDown() {
+    }
+};
+
+TEST_F(FX_ParseCache, parse_SameTextUpToSpaces_SameTree) {
+    ParseCache cache;
+
+    PExpression first = cache.parse("sin(x) + 2*x");
+    PExpression second = cache.parse(" sin(x)+2 * x\t");
+
+    ASSERT_EQ(first, second);
+    ASSERT_TRUE(structurallyEqual(*parse("sin(x)+2*x"), *first));
+    ASSERT_EQ(1u, cache.getStatistics().hits);
+    ASSERT_EQ(1u, cache.getStatistics().misses);
+}
+
+TEST_F(FX_ParseCache, parse_InvalidText_ExceptionEveryTime) {
+    ParseCache cache;
+
+    ASSERT_THROW(cache.parse("x^(3+)"), ParsingException);
+    ASSERT_THROW(cache.parse("x^(3+)"), ParsingException);
+    ASSERT_THROW(cache.parse("x\n+1"), ParsingException);
+    ASSERT_EQ(0u, cache.getStatistics().hits);
+}
+
+TEST_F(FX_ParseCache, parse_MoreTextsThanCapacity_Evicted) {
+    ParseCache cache(2);
+
+    PExpression x = cache.parse("x");
+    cache.parse("y");
+    cache.parse("z");
+
+    ASSERT_NE(x, cache.parse("x"));
+    ASSERT_EQ(2u, cache.getStatistics().evictions);
+}
+
+TEST_F(FX_ParseCache, parse_ConcurrentThreads_OneTreePerText) {
+    if (!isSPointerThreadSafe) {
+        return;
+    }
+    ParseCache cache;
+    PExpression expected = cache.parse("ln(x)*y");
+    std::vector<std::thread> threads;
+    std::vector<int> same(4, 0);
+
+    for (size_t t = 0; t < same.size(); t++) {
+        threads.emplace_back([&cache, &expected, &same, t]() {
+            bool allSame = true;
+            for (int i = 0; i < 1000; i++) {
+                allSame = allSame && cache.parse("ln(x) * y") == expected;
+            }
+            same[t] = allSame;
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    for (int allSame : same) {
+        ASSERT_TRUE(allSame);
+    }
+}
@@ -14,8 +14,10 @@
 #include <gtest/gtest.h>
 #include <string>
 #include <list>
+#include <random>
 #include <vector>
 
+#include "Parser.h"
 #include "ParserImpl.h"
 #include "Expression.h"
 #include "ExpressionFactory.h"
@@ -447,6 +449,13 @@ TEST_F(FX_Parser, parse_NotANumber_ParsingException) {
     ASSERT_THROW(parser.parse(strExpr), ParsingException);
 }
 
+TEST_F(FX_Parser, parse_SeveralDecimalSeparators_ParsingException) {
+    ParserTest parser;
+
+    ASSERT_THROW(parser.parse("1.2.3+x"), ParsingException);
+    ASSERT_THROW(parser.parse("x*1,5,"), ParsingException);
+}
+
 TEST_F(FX_Parser, parse_FailedParentness_ParsingException) {
     ParserTest parser;
     ASSERT_THROW(parser.parse("a+(b+(c+(d+e)+k)"), ParsingException);
@@ -471,3 +480,124 @@ TEST_F(FX_Parser, parse_WhiteSpaceString_ParsingException) {
     ParserTest parser;
     ASSERT_THROW(parser.parse("     "), ParsingException);
 }
+
+TEST_F(FX_Parser, tryParse_ValidExpression_SameTreeAsParse) {
+    ParserTest parser;
+    Expected<PExpression> result = parser.tryParse("sin(x)^2 + 2x/(1-x)");
+    ASSERT_TRUE(result.hasValue());
+    ASSERT_EQ(to_string(parser.parse("sin(x)^2 + 2x/(1-x)")), to_string(result.getValue()));
+}
+
+TEST_F(FX_Parser, tryParse_MalformedExpressions_FailureWithMessageOfException) {
+    ParserTest parser;
+    // the last one fails in a grammar rule
+    std::vector<string> tests = {"...", "1.2.3+x", "a+(b+(c+(d+e)+k)", "a+)b)", "(", "a+'b'", "     ", "x^(3+)", "*x"};
+
+    for (unsigned int testId = 0; testId < tests.size(); testId++) {
+        Expected<PExpression> result = parser.tryParse(tests[testId]);
+        ASSERT_FALSE(result) << "Test ID=" << testId;
+        ASSERT_EQ(Failure::Parsing, result.getFailure().kind) << "Test ID=" << testId;
+        try {
+            parser.parse(tests[testId]);
+            FAIL() << "Test ID=" << testId << " did not throw an exception!";
+        } catch (ParsingException ex) {
+            // the exception may have the debug context in addition
+            string message = result.getFailure().message;
+            ASSERT_EQ(message, string(ex.what()).substr(0, message.size())) << "Test ID=" << testId;
+        }
+    }
+}
+
+TEST_F(FX_Parser, tryParse_DeeplyNestedExpression_FailureBeyondLimit) {
+    ParserTest parser;
+    auto nested = [](const string &opening, unsigned int depth) {
+        string text;
+        for (unsigned int i = 0; i < depth; i++) {
+            text += opening;
+        }
+        text += "x";
+        return text + string(depth, ')');
+    };
+
+    ASSERT_TRUE(parser.tryParse(nested("sin(", maxNestingDepth)).hasValue());
+    ASSERT_TRUE(parser.tryParse(nested("(", maxNestingDepth)).hasValue());
+
+    // the recursion of the parser is not entered beyond the limit
+    std::vector<string> tests = {nested("sin(", maxNestingDepth + 1), nested("(", 20000), nested("sin(", 20000)};
+    for (unsigned int testId = 0; testId < tests.size(); testId++) {
+        Expected<PExpression> result = parser.tryParse(tests[testId]);
+        ASSERT_FALSE(result) << "Test ID=" << testId;
+        ASSERT_EQ(0u, result.getFailure().message.find("The expression is nested too deeply.")) << "Test ID=" << testId;
+    }
+    ASSERT_THROW(parser.parse(tests[0]), ParsingException);
+}
+
+TEST_F(FX_Parser, checkSyntax_Expressions_PositionAndReasonOfFirstError) {
+    ASSERT_TRUE(checkSyntax("sin(x)^2 + 2x/(1-x)").isValid);
+    ASSERT_TRUE(checkSyntax("-x + 1 2").isValid);
+
+    struct {
+        const char *text;
+        size_t position;
+        const char *reason;
+    } tests[] = {
+        {"x + 'y'", 4, "Unknown character."},
+        {"x*1.2.3", 2, "Not a number token."},
+        {"a+(b+(c+d)", 2, "No closing bracket has been found."},
+        {"a+)b", 2, "Unexpected closing bracket ')'."},
+        {"x*(", 3, "Unexpect end of the expression."},
+        {"x^(3+)", 5, "The expression is incomplete. An operand or argument is missing."},
+        {"x+", 2, "The expression is incomplete. An operand or argument is missing."},
+        {"x/", 2, "The expression is incomplete. An operand or argument is missing."},
+        {"x^ ", 2, "The expression is incomplete. An operand or argument is missing."},
+        {"sin", 3, "The expression is incomplete. An operand or argument is missing."},
+        {"x + (2 sin)", 5, "The specified expression is ambiguous. Not able to completely reduce syntax tree."},
+        {"(/x)", 1, "No operand on the left side of '/'."},
+    };
+    for (auto &test : tests) {
+        SyntaxCheck result = checkSyntax(test.text);
+        EXPECT_FALSE(result.isValid) << test.text;
+        EXPECT_EQ(test.position, result.position) << test.text;
+        EXPECT_STREQ(test.reason, result.reason) << test.text;
+    }
+}
+
+TEST_F(FX_Parser, checkSyntax_DeeplyNestedExpression_SameAsParse) {
+    ParserTest parser;
+    for (unsigned int depth : {maxNestingDepth, maxNestingDepth + 1, 20000u}) {
+        string text;
+        for (unsigned int i = 0; i < depth; i++) {
+            text += "sin(";
+        }
+        text += "x" + string(depth, ')');
+
+        Expected<PExpression> parsed = parser.tryParse(text);
+        SyntaxCheck checked = checkSyntax(text);
+        ASSERT_EQ(parsed.hasValue(), checked.isValid) << "Depth " << depth;
+        if (depth > maxNestingDepth) {
+            ASSERT_STREQ("The expression is nested too deeply.", checked.reason) << "Depth " << depth;
+            // the bracket which exceeds the limit
+            ASSERT_EQ(4 * maxNestingDepth + 3, checked.position) << "Depth " << depth;
+            ASSERT_EQ(0u, parsed.getFailure().message.find(checked.reason)) << "Depth " << depth;
+        }
+    }
+}
+
+TEST_F(FX_Parser, checkSyntax_RandomStrings_SameAsParse) {
+    const char *pieces[] = {"x", "y", "2", "0.5", "1.2.3", " ", "(", ")", "+", "-", "*", "/", "^", "**", "sin", "ln", "exp", "s in", "1 2", "'"};
+    std::mt19937 random(49);
+    for (int testId = 0; testId < 20000; testId++) {
+        string text;
+        int length = random() % 9;
+        for (int i = 0; i < length; i++) {
+            text += pieces[random() % (sizeof (pieces) / sizeof (pieces[0]))];
+        }
+        ParserTest parser;
+        Expected<PExpression> parsed = parser.tryParse(text);
+        SyntaxCheck checked = checkSyntax(text);
+        ASSERT_EQ(parsed.hasValue(), checked.isValid) << "'" << text << "'";
+        if (!checked.isValid) {
+            ASSERT_EQ(0u, parsed.getFailure().message.find(checked.reason)) << "'" << text << "'";
+        }
+    }
+}
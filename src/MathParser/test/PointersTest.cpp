@@ -0,0 +1,136 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file PointersTest.cpp
+ *
+ * Test cases for SPointer, the same for both backends of reference counting.
+ *
+ * @since 18.10.2026
+ * @author agor
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "Pointers.h"
+#include "ExpressionFactory.h"
+#include "Visitor.h"
+
+class FX_Pointers : public testing::Test {
+protected:
+
+    virtual void SetUp() {
+    }
+
+    virtual void TearDown() {
+    }
+};
+
+namespace {
+
+/**
+ * Records the use count of the pointer passed to visit().
+ */
+class UseCountVisitor : public Visitor {
+public:
+    long useCount = 0;
+
+    void visit(const PConstConstant &) throw (TraverseException) final {
+    }
+
+    void visit(const PConstVariable &expr) throw (TraverseException) final {
+        this->useCount = expr.use_count();
+    }
+
+    void visit(const PConstSum &) throw (TraverseException) final {
+    }
+
+    void visit(const PConstSub &) throw (TraverseException) final {
+    }
+
+    void visit(const PConstDiv &) throw (TraverseException) final {
+    }
+
+    void visit(const PConstMult &) throw (TraverseException) final {
+    }
+
+    void visit(const PConstPow &) throw (TraverseException) final {
+    }
+
+    void visit(const PConstSin &) throw (TraverseException) final {
+    }
+
+    void visit(const PConstCos &) throw (TraverseException) final {
+    }
+
+    void visit(const PConstTan &) throw (TraverseException) final {
+    }
+
+    void visit(const PConstCtan &) throw (TraverseException) final {
+    }
+
+    void visit(const PConstLn &) throw (TraverseException) final {
+    }
+
+    void visit(const PConstExp &) throw (TraverseException) final {
+    }
+};
+
+}
+
+TEST_F(FX_Pointers, MakeSPointer_RvalueArgument_Forwarded) {
+    std::string name = "x";
+
+    PVariable copied = MakeSPointer<Variable>(name);
+    PVariable moved = MakeSPointer<Variable>(std::move(name));
+
+    ASSERT_EQ("x", copied->name);
+    ASSERT_EQ("x", moved->name);
+    ASSERT_EQ(copied->symbol, moved->symbol);
+}
+
+TEST_F(FX_Pointers, SPointerCast_ConcreteType_SameObjectOrNull) {
+    PExpression expr = createSum(createVariable("x"), createVariable("y"));
+
+    PSum sum = SPointerCast<Sum>(expr);
+    PMult mult = SPointerCast<Mult>(expr);
+
+    ASSERT_EQ(expr, sum);
+    ASSERT_EQ(2, expr.use_count());
+    ASSERT_EQ(nullptr, mult);
+    ASSERT_FALSE(mult);
+}
+
+TEST_F(FX_Pointers, traverse_PointerToThis_OneReferenceAdded) {
+    PVariable var = createVariable("x");
+    UseCountVisitor visitor;
+
+    var->traverse(visitor);
+
+    ASSERT_EQ(2, visitor.useCount);
+    ASSERT_EQ(1, var.use_count());
+}
+
+TEST_F(FX_Pointers, createSum_Arguments_MovedIntoExpression) {
+    PExpression x = createVariable("x");
+
+    PSum sum = createSum(x, createVariable("y"));
+
+    ASSERT_EQ(2, x.use_count());
+    ASSERT_EQ(1, sum->rArg.use_count());
+    sum.reset();
+    ASSERT_EQ(1, x.use_count());
+}
+
+TEST_F(FX_Pointers, reset_SharedSubtree_RemainsAlive) {
+    PExpression shared = createSin(createVariable("x"));
+    PExpression expr = createMult(shared, createCos(shared));
+
+    expr.reset();
+
+    ASSERT_EQ(1, shared.use_count());
+    ASSERT_EQ("x", SPointerCast<Variable>(SPointerCast<Sin>(shared)->arg)->name);
+}
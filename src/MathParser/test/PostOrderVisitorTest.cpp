@@ -0,0 +1,159 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file PostOrderVisitorTest.cpp
+ *
+ * Test cases for PostOrderVisitor.
+ *
+ * @since 18.10.2026
+ * @author agor
+ */
+
+#include <gtest/gtest.h>
+#include <string>
+
+#include "PostOrderVisitor.h"
+#include "ExceptionThrower.h"
+#include "ExpressionFactory.h"
+
+/**
+ * Counts nodes of the tree and records the order of calls.
+ */
+class NodeCounter : public PostOrderVisitor<int> {
+public:
+    std::string log;
+    bool throwOnVariable = false;
+    
+protected:
+    int postVisit(const Constant &) throw (TraverseException) final {
+        log += "c";
+        return 1;
+    }
+    int postVisit(const Variable &) throw (TraverseException) final {
+        if (throwOnVariable) {
+            THROW(TraverseException, "Variable", "N.A.");
+        }
+        log += "v";
+        return 1;
+    }
+    int postVisit(const Sum &, int &lArg, int &rArg) throw (TraverseException) final {
+        log += "+";
+        return lArg + rArg + 1;
+    }
+    int postVisit(const Sub &expr, int &lArg, int &rArg) throw (TraverseException) final {
+        // nested traversal of the other tree must not affect this one
+        PExpression other = createSum(createConstant(1), createConstant(2));
+        int nested = this->traversePostOrder(*other);
+        log += "-";
+        return lArg + rArg + 1 + (expr.isComplete() ? 0 : 100) + nested * 1000;
+    }
+    int postVisit(const Div &, int &lArg, int &rArg) throw (TraverseException) final {
+        return lArg + rArg + 1;
+    }
+    int postVisit(const Mult &, int &lArg, int &rArg) throw (TraverseException) final {
+        log += "*";
+        return lArg + rArg + 1;
+    }
+    int postVisit(const Pow &, int &lArg, int &rArg) throw (TraverseException) final {
+        return lArg + rArg + 1;
+    }
+    int postVisit(const Sin &, int &arg) throw (TraverseException) final {
+        log += "s";
+        return arg + 1;
+    }
+    int postVisit(const Cos &, int &arg) throw (TraverseException) final {
+        return arg + 1;
+    }
+    int postVisit(const Tan &, int &arg) throw (TraverseException) final {
+        return arg + 1;
+    }
+    int postVisit(const Ctan &, int &arg) throw (TraverseException) final {
+        return arg + 1;
+    }
+    int postVisit(const Ln &, int &arg) throw (TraverseException) final {
+        return arg + 1;
+    }
+    int postVisit(const Exp &, int &arg) throw (TraverseException) final {
+        return arg + 1;
+    }
+    
+    void beforeArgument(const Expression &, unsigned int index) throw (TraverseException) final {
+        log += "[" + std::to_string(index);
+    }
+    
+    void afterArgument(const Expression &, unsigned int index) throw (TraverseException) final {
+        log += std::to_string(index) + "]";
+    }
+};
+
+class FX_PostOrderVisitor : public testing::Test {
+protected:
+
+    virtual void SetUp() {
+    }
+
+    virtual void TearDown() {
+    }
+};
+
+TEST_F(FX_PostOrderVisitor, traversePostOrder_Tree_ArgumentsBeforeNode) {
+    PExpression expr = createMult(createSin(createVariable("x")), createConstant(2));
+    
+    NodeCounter counter;
+    ASSERT_EQ(4, counter.traversePostOrder(*expr));
+    ASSERT_EQ("[0[0v0]s0][1c1]*", counter.log);
+}
+
+TEST_F(FX_PostOrderVisitor, visit_Tree_ResultIsStored) {
+    PExpression expr = createSum(createVariable("x"), createConstant(2));
+    
+    NodeCounter counter;
+    expr->traverse(counter);
+    ASSERT_EQ(3, counter.getLastVisitResult());
+}
+
+TEST_F(FX_PostOrderVisitor, accept_Tree_ResultIsStored) {
+    PExpression expr = createSum(createVariable("x"), createCos(createConstant(2)));
+    
+    NodeCounter counter;
+    expr->accept(counter);
+    ASSERT_EQ(4, counter.getLastVisitResult());
+    ASSERT_EQ(1, expr.use_count());
+}
+
+TEST_F(FX_PostOrderVisitor, traversePostOrder_MissingArgument_DefaultResult) {
+    PExpression expr = createSin(createSum(createVariable("x"), nullptr));
+    
+    NodeCounter counter;
+    ASSERT_EQ(3, counter.traversePostOrder(*expr));
+}
+
+TEST_F(FX_PostOrderVisitor, traversePostOrder_NestedTraversal_Independent) {
+    PExpression expr = createSum(createSub(createVariable("x"), createVariable("y")), createVariable("z"));
+    
+    NodeCounter counter;
+    ASSERT_EQ(3005, counter.traversePostOrder(*expr));
+}
+
+TEST_F(FX_PostOrderVisitor, traversePostOrder_Exception_VisitorIsReusable) {
+    PExpression expr = createSum(createConstant(1), createMult(createVariable("x"), createConstant(2)));
+    
+    NodeCounter counter;
+    counter.throwOnVariable = true;
+    ASSERT_THROW(counter.traversePostOrder(*expr), TraverseException);
+    
+    counter.throwOnVariable = false;
+    ASSERT_EQ(5, counter.traversePostOrder(*expr));
+}
+
+TEST_F(FX_PostOrderVisitor, traversePostOrder_VeryDeepTree_NoStackOverflow) {
+    PExpression expr = createVariable("x");
+    for (int i = 0; i < 200000; i++) {
+        expr = (i % 2 == 0) ? createSum(expr, createConstant(1)) : PExpression(createSin(expr));
+    }
+    
+    NodeCounter counter;
+    ASSERT_EQ(300001, counter.traversePostOrder(*expr));
+}
@@ -0,0 +1,107 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file RebalancerTest.cpp
+ *
+ * Test cases for rebalance().
+ *
+ * @since 18.10.2026
+ * @author agor
+ */
+
+#include <gtest/gtest.h>
+#include <algorithm>
+
+#include "Rebalancer.h"
+#include "Equivalence.h"
+#include "Parser.h"
+#include "ExpressionFactory.h"
+
+class FX_Rebalancer : public testing::Test {
+protected:
+
+    virtual void SetUp() {
+    }
+
+    virtual void TearDown() {
+    }
+
+    // only for balanced trees, the recursion is not deeper than the tree
+    unsigned int depth(const Expression *expr) {
+        if (expr == nullptr) {
+            return 0;
+        }
+        const Expression *args[2];
+        unsigned int count = argumentsOf(*expr, args);
+        unsigned int maxDepth = 0;
+        for (unsigned int i = 0; i < count; i++) {
+            maxDepth = std::max(maxDepth, depth(args[i]));
+        }
+        return maxDepth + 1;
+    }
+};
+
+TEST_F(FX_Rebalancer, rebalance_LongSum_LogarithmicDepth) {
+    PExpression expr = createVariable("x");
+    for (int i = 1; i < 1024; i++) {
+        expr = createSum(expr, createMult(createConstant(i), createVariable("x")));
+    }
+
+    PExpression balanced = rebalance(expr);
+
+    ASSERT_EQ(12u, depth(balanced.get())); // 10 levels of sums, mult and its arguments
+    ASSERT_TRUE(probablyEquivalent(*expr, *balanced));
+}
+
+TEST_F(FX_Rebalancer, rebalance_OperandsKeepTheirOrder) {
+    PExpression expr = parse("a+b+c+d+e");
+
+    ASSERT_EQ("(a+b)+(c+(d+e))", to_string(rebalance(expr, 2)));
+}
+
+TEST_F(FX_Rebalancer, rebalance_ShortChain_Unchanged) {
+    PExpression expr = parse("a*b*c+d+sin(e+f+g)");
+
+    PExpression result = rebalance(expr);
+
+    ASSERT_NE(expr, result);
+    ASSERT_EQ(to_string(expr), to_string(result));
+}
+
+TEST_F(FX_Rebalancer, rebalance_NestedChains_BalancedSeparately) {
+    PExpression expr = parse("a*b*c*d+x+y+z-sin(p+q+r+s)");
+
+    ASSERT_EQ("((((a*b)*(c*d))+x)+(y+z))-sin((p+q)+(r+s))", to_string(rebalance(expr, 4)));
+}
+
+TEST_F(FX_Rebalancer, rebalance_OriginalNotModified) {
+    PExpression expr = parse("a+b+c+d");
+    std::string original = to_string(expr);
+
+    rebalance(expr, 2);
+
+    ASSERT_EQ(original, to_string(expr));
+}
+
+TEST_F(FX_Rebalancer, rebalance_IncompleteExpression_KeptIncomplete) {
+    PSum sum = createSum(createSum(createVariable("a"), createVariable("b")), createVariable("c"));
+    sum->rArg = nullptr;
+
+    PExpression result = rebalance(sum, 2);
+
+    ASSERT_FALSE(result->isComplete());
+    ASSERT_EQ(to_string(sum), to_string(result));
+}
+
+TEST_F(FX_Rebalancer, rebalance_VeryDeepSum_NoStackOverflow) {
+    PExpression expr = createVariable("x");
+    for (int i = 0; i < 200000; i++) {
+        expr = createSum(expr, createVariable("y"));
+    }
+
+    PExpression balanced = rebalance(expr);
+
+    ASSERT_EQ(19u, depth(balanced.get())); // 200001 operands
+}
@@ -0,0 +1,148 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file ResourceBudgetTest.cpp
+ *
+ * Test cases for ResourceBudget.
+ *
+ * @since 18.10.2026
+ * @author agor
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include "ExpressionFactory.h"
+#include "ResourceBudget.h"
+
+class FX_ResourceBudget : public testing::Test {
+protected:
+
+    virtual void SetUp() {
+    }
+
+    virtual void TearDown() {
+    }
+};
+
+TEST_F(FX_ResourceBudget, create_NoBudget_NothingCharged) {
+    ASSERT_EQ(nullptr, ResourceBudget::current());
+    for (int i = 0; i < 100; i++) {
+        createSum(createVariable("x"), createConstant(1.0));
+    }
+    ASSERT_EQ(nullptr, ResourceBudget::current());
+}
+
+TEST_F(FX_ResourceBudget, create_BudgetInScope_NodesCharged) {
+    ResourceLimits limits;
+    ResourceBudget budget(limits);
+    {
+        BudgetScope scope(&budget);
+        ASSERT_EQ(&budget, ResourceBudget::current());
+        createSum(createVariable("x"), createConstant(1.0));
+        createSin(createVariable("x"));
+    }
+    ASSERT_EQ(nullptr, ResourceBudget::current());
+    ASSERT_EQ(5u, budget.getNodes());
+}
+
+TEST_F(FX_ResourceBudget, create_NodeLimitExceeded_BudgetExceededException) {
+    ResourceLimits limits;
+    limits.maxNodes = 3;
+    ResourceBudget budget(limits);
+    BudgetScope scope(&budget);
+    createSum(createVariable("x"), createConstant(1.0));
+    try {
+        createVariable("y");
+        FAIL() << "The limit of nodes is exceeded.";
+    } catch (BudgetExceededException ex) {
+        ASSERT_EQ(BudgetExceededException::Nodes, ex.getReason());
+        ASSERT_EQ(0u, std::string(ex.what()).find("The request has exceeded the limit of nodes."));
+    }
+    // the budget stays exhausted
+    ASSERT_THROW(createConstant(2.0), BudgetExceededException);
+}
+
+TEST_F(FX_ResourceBudget, chargePass_PassLimitExceeded_BudgetExceededException) {
+    ResourceLimits limits;
+    limits.maxPasses = 2;
+    ResourceBudget budget(limits);
+    BudgetScope scope(&budget);
+    chargePass();
+    chargePass();
+    ASSERT_EQ(2u, budget.getPasses());
+    try {
+        chargePass();
+        FAIL() << "The limit of passes is exceeded.";
+    } catch (BudgetExceededException ex) {
+        ASSERT_EQ(BudgetExceededException::Passes, ex.getReason());
+    }
+}
+
+TEST_F(FX_ResourceBudget, check_TimeLimitExceeded_BudgetExceededException) {
+    ResourceLimits limits;
+    limits.maxMilliseconds = 1;
+    ResourceBudget budget(limits);
+    BudgetScope scope(&budget);
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    try {
+        checkBudget();
+        FAIL() << "The time limit is exceeded.";
+    } catch (BudgetExceededException ex) {
+        ASSERT_EQ(BudgetExceededException::Time, ex.getReason());
+    }
+    // the factory reads the clock once per many nodes
+    try {
+        for (int i = 0; i < 10000; i++) {
+            createVariable("x");
+        }
+        FAIL() << "The time limit is exceeded.";
+    } catch (BudgetExceededException ex) {
+        ASSERT_EQ(BudgetExceededException::Time, ex.getReason());
+        ASSERT_GE(1024u, budget.getNodes());
+    }
+}
+
+TEST_F(FX_ResourceBudget, check_CancelledByOtherThread_BudgetExceededException) {
+    CancellationToken token;
+    ResourceLimits limits;
+    ResourceBudget budget(limits, &token);
+    BudgetScope scope(&budget);
+    checkBudget();
+
+    std::thread canceller([&token]() {
+        token.cancel();
+    });
+    canceller.join();
+    ASSERT_TRUE(token.isCancelled());
+    try {
+        checkBudget();
+        FAIL() << "The request is cancelled.";
+    } catch (BudgetExceededException ex) {
+        ASSERT_EQ(BudgetExceededException::Cancelled, ex.getReason());
+        ASSERT_EQ(0u, std::string(ex.what()).find("The request has been cancelled."));
+    }
+}
+
+TEST_F(FX_ResourceBudget, BudgetScope_Nested_PreviousRestored) {
+    ResourceLimits limits;
+    ResourceBudget outer(limits);
+    ResourceBudget inner(limits);
+    BudgetScope outerScope(&outer);
+    {
+        BudgetScope innerScope(&inner);
+        createVariable("x");
+        {
+            BudgetScope noBudget(nullptr);
+            createVariable("x");
+        }
+        createVariable("x");
+    }
+    createVariable("x");
+    ASSERT_EQ(1u, outer.getNodes());
+    ASSERT_EQ(2u, inner.getNodes());
+}
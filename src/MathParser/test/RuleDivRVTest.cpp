@@ -81,4 +81,18 @@ TEST_F(FX_RuleDivRV, apply_DivisionWithoutLeftArgument_ParsingException) {
     
     RuleDivRV ruleDivRV;
     EXPECT_THROW(ruleDivRV.apply(stack, lookAheadToken()), ParsingException);
-}
\ No newline at end of file
+}
+TEST_F(FX_RuleDivRV, apply_DivisionWithoutLeftArgument_ParsingError) {
+    ParserStack stack;
+
+    // /a
+    stack.push_back(createDiv());
+    stack.push_back(createVariable("a"));
+    
+    RuleDivRV ruleDivRV;
+    ParsingError error;
+    EXPECT_FALSE(ruleDivRV.apply(stack, lookAheadToken(), error));
+    EXPECT_TRUE(error.isSet);
+    EXPECT_EQ("No operand on the left side of '/'.", error.message);
+    EXPECT_EQ(2u, stack.size());
+}
@@ -0,0 +1,117 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file SerializationTest.cpp
+ *
+ * Test cases for the binary encoding of expressions.
+ *
+ * @since 18.10.2026
+ * @author agor
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+
+#include "Serialization.h"
+#include "StructuralEquality.h"
+#include "Parser.h"
+#include "ExpressionFactory.h"
+
+class FX_Serialization : public testing::Test {
+protected:
+
+    virtual void SetUp() {
+    }
+
+    virtual void TearDown() {
+    }
+};
+
+TEST_F(FX_Serialization, deserialize_Expressions_SameTree) {
+    const char *expressions[] = {
+        "x", "2.5", "x+3", "3-x*y", "(x+1)*(x+2)/y", "x^2^y", "-0.1*var",
+        "sin(x)+cos(x)*tan(x)-ctan(x)", "ln(x^2+2*x)/exp(x)", "sin(cos(tan(x)))"
+    };
+
+    for (const char *strExpr : expressions) {
+        PExpression expr = parse(strExpr);
+
+        PExpression restored = deserialize(serialize(*expr));
+
+        ASSERT_TRUE(structurallyEqual(*expr, *restored)) << strExpr;
+        ASSERT_EQ(to_string(expr), to_string(deserializeFlat(serialize(*expr)))) << strExpr;
+    }
+}
+
+TEST_F(FX_Serialization, serialize_ExactConstants) {
+    PExpression expr = createSum(createConstant(0.1), createConstant(1e300));
+
+    PSum restored = SPointerCast<Sum>(deserialize(serialize(*expr)));
+
+    ASSERT_EQ(0.1, SPointerCast<Constant>(restored->lArg)->value);
+    ASSERT_EQ(1e300, SPointerCast<Constant>(restored->rArg)->value);
+}
+
+TEST_F(FX_Serialization, serialize_RepeatedValuesAndSubtrees_WrittenOnce) {
+    PExpression shared = createVariable("x");
+    for (int i = 0; i < 60; i++) {
+        shared = createMult(shared, createSin(shared));
+    }
+    PExpression expr = createSum(shared, parse("verylongname*2.5+verylongname*2.5"));
+
+    std::string data = serialize(*expr);
+
+    // header, tables of 2 variables and 1 constant, 126 nodes
+    ASSERT_LT(data.size(), 6u + 20u + 9u + 2u + 126u * 3u);
+    PExpression restored = deserialize(data);
+    ASSERT_EQ(to_let_string(flattenShared(*expr)), to_let_string(flattenShared(*restored)));
+    PMult root = SPointerCast<Mult>(SPointerCast<Sum>(restored)->lArg);
+    ASSERT_EQ(root->lArg, SPointerCast<Sin>(root->rArg)->arg);
+}
+
+TEST_F(FX_Serialization, serialize_FlatExpression_SameNodes) {
+    FlatExpression flat;
+    FlatExpression::Index x = flat.addVariable("x");
+    FlatExpression::Index two = flat.addConstant(2.0);
+    flat.addNode(ECos, flat.addNode(EPow, x, two));
+
+    FlatExpression restored = deserializeFlat(serialize(flat));
+
+    ASSERT_EQ(flat.size(), restored.size());
+    for (FlatExpression::Index node = 0; node < flat.size(); node++) {
+        ASSERT_EQ(flat.type(node), restored.type(node));
+        ASSERT_EQ(flat.lArg(node), restored.lArg(node)) << node;
+        ASSERT_EQ(flat.rArg(node), restored.rArg(node)) << node;
+    }
+    ASSERT_EQ(nullptr, deserialize(serialize(FlatExpression())));
+}
+
+TEST_F(FX_Serialization, deserialize_InvalidData_ParsingException) {
+    std::string data = serialize(*parse("sin(x)*x+2"));
+
+    ASSERT_THROW(deserialize(""), ParsingException);
+    ASSERT_THROW(deserialize("x+2"), ParsingException);
+    for (size_t size = 0; size < data.size(); size++) {
+        ASSERT_THROW(deserialize(data.data(), size), ParsingException) << size;
+    }
+    ASSERT_THROW(deserialize(data + "?"), ParsingException);
+
+    std::string version = data;
+    version[4] = serializationVersion + 1;
+    ASSERT_THROW(deserialize(version), ParsingException);
+
+    // the left argument of the last node (+) refers before the first node
+    std::string argument = data;
+    argument[argument.size() - 2] = 100;
+    ASSERT_THROW(deserialize(argument), ParsingException);
+
+    std::string type = data;
+    type[type.size() - 3] = EExp + 1;
+    ASSERT_THROW(deserialize(type), ParsingException);
+
+    std::string count("AGEX\x01\xff\xff\xff\xff\x0f", 10);
+    ASSERT_THROW(deserialize(count), ParsingException);
+}
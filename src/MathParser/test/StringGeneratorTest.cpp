@@ -11,6 +11,7 @@
 
 #include <gtest/gtest.h>
 #include <string>
+#include <sstream>
 
 #include "StringGenerator.h"
 #include "Variable.h"
@@ -71,4 +72,74 @@ TEST_F(FX_StringGenerator, visit_SinusOfSum_ok) {
     StringGenerator strGen;
     sin->traverse(strGen);
     ASSERT_STREQ("sin(a+b)", strGen.getLastVisitResult().c_str());
-}
\ No newline at end of file
+}
+TEST_F(FX_StringGenerator, visit_IncompleteExpression_QuestionMarks) {
+    PExpression sum = createSum(createVariable("a"), nullptr);
+    PExpression sin = createSin(createMult(sum, createCos()));
+
+    StringGenerator strGen;
+    sin->traverse(strGen);
+    ASSERT_STREQ("sin((a+?)*cos(?))", strGen.getLastVisitResult().c_str());
+}
+
+TEST_F(FX_StringGenerator, visit_VeryDeepExpression_NoStackOverflow) {
+    PExpression expr = createVariable("a");
+    for (int i = 0; i < 200000; i++) {
+        expr = createSum(expr, createVariable("a"));
+    }
+
+    StringGenerator strGen;
+    ASSERT_NO_THROW(expr->traverse(strGen));
+    std::string result = strGen.getLastVisitResult();
+    ASSERT_EQ(std::string(200000 - 1, '(') + "a+a)", result.substr(0, 200000 + 3));
+    ASSERT_EQ(std::string("+a"), result.substr(result.length() - 2));
+}
+
+TEST_F(FX_StringGenerator, visit_Precision_SignificantDigitsOfConstants) {
+    PExpression expr = createSum(createConstant(3.14159), createMult(createConstant(42), createVariable("x")));
+
+    ASSERT_EQ("3.1+(42*x)", to_string(expr));
+    ASSERT_EQ("3.1416+(42*x)", to_string(expr, 5));
+    
+    StringGenerator strGen(1);
+    expr->accept(strGen);
+    ASSERT_EQ("3+(4e+01*x)", strGen.getLastVisitResult());
+}
+
+TEST_F(FX_StringGenerator, print_Stream_SameAsToString) {
+    PExpression expr = createSum(createConstant(3.14159), createMult(createConstant(42), createVariable("x")));
+    std::ostringstream out;
+
+    print(out, expr, 5);
+
+    ASSERT_EQ(to_string(expr, 5), out.str());
+}
+
+TEST_F(FX_StringGenerator, print_SmallBuffer_TruncatedAndFullLength) {
+    PExpression expr = createSum(createVariable("a"), createMult(createConstant(5), createVariable("b")));
+    char buffer[5];
+
+    ASSERT_EQ(7u, print(buffer, sizeof (buffer), expr));
+    ASSERT_EQ(std::string("a+(5"), buffer);
+    ASSERT_EQ(7u, print(nullptr, 0, expr));
+    ASSERT_EQ(1u, print(buffer, sizeof (buffer), nullptr));
+    ASSERT_EQ(std::string("?"), buffer);
+}
+
+TEST_F(FX_StringGenerator, print_OutputLongerThanChunk_WrittenCompletely) {
+    PExpression expr = createVariable("a");
+    for (size_t i = 0; i < StringGenerator::chunkSize; i++) {
+        expr = createSum(expr, createVariable("b"));
+    }
+    std::ostringstream out;
+
+    print(out, expr);
+
+    std::string expected = to_string(expr);
+    ASSERT_GT(expected.length(), 2 * StringGenerator::chunkSize);
+    ASSERT_EQ(expected, out.str());
+
+    std::string buffer(expected.length() + 1, 'x');
+    ASSERT_EQ(expected.length(), print(&buffer[0], buffer.length(), expr));
+    ASSERT_EQ(expected, buffer.c_str());
+}
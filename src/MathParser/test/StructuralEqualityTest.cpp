@@ -0,0 +1,110 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file StructuralEqualityTest.cpp
+ *
+ * Test cases for structurallyEqual().
+ *
+ * @since 18.10.2026
+ * @author agor
+ */
+
+#include <gtest/gtest.h>
+
+#include <functional>
+
+#include "StructuralEquality.h"
+#include "Comparator.h"
+#include "Parser.h"
+#include "Sum.h"
+#include "ExpressionFactory.h"
+
+class FX_StructuralEquality : public testing::Test {
+protected:
+
+    virtual void SetUp() {
+    }
+
+    virtual void TearDown() {
+    }
+
+    bool compareByComparator(PExpression exprL, PExpression exprR) {
+        Comparator comparator(exprR);
+        exprL->traverse(comparator);
+        return comparator.areEqual();
+    }
+};
+
+TEST_F(FX_StructuralEquality, structurallyEqual_SameResultAsComparator) {
+    const char *expressions[] = {
+        "x", "y", "3", "3.000000001", "4",
+        "x+3", "3+x", "x+y", "x-3", "3-x",
+        "x*y*2", "2*y*x", "(x+1)*(x+2)", "(x+2)*(x+1)", "(x+2)*(x+2)",
+        "x/y", "y/x", "x^2", "2^x", "x^2.0000000001",
+        "sin(x)", "cos(x)", "tan(x)", "ctan(x)", "ln(x)", "exp(x)", "sin(y)",
+        "sin(x+1)*cos(x)", "cos(x)*sin(1+x)", "ln(x^2+2*x)/exp(x)",
+        "(1+2)*(3+4)", "(4+3)*(2+1)", "(1+3)*(2+4)", "(1+2)*(3+5)", "(1*2+3)+(4*5+6)", "(6+5*4)+(3+2*1)"
+    };
+
+    for (const char *l : expressions) {
+        for (const char *r : expressions) {
+            PExpression exprL = parse(l);
+            PExpression exprR = parse(r);
+            ASSERT_EQ(compareByComparator(exprL, exprR), structurallyEqual(*exprL, *exprR)) << l << " vs " << r;
+        }
+    }
+}
+
+TEST_F(FX_StructuralEquality, structurallyEqual_SameInstance_Equal) {
+    PExpression expr = createSum(createVariable("x"), createSin(createVariable("x")));
+
+    ASSERT_TRUE(structurallyEqual(*expr, *expr));
+}
+
+TEST_F(FX_StructuralEquality, structurallyEqual_IncompleteExpression_NotEqual) {
+    PSum sum1 = createSum(createVariable("x"), createConstant(1.0));
+    PSum sum2 = createSum(createVariable("x"), createConstant(1.0));
+    sum1->rArg = nullptr;
+    sum2->rArg = nullptr;
+
+    ASSERT_FALSE(structurallyEqual(*sum1, *sum2));
+    ASSERT_FALSE(structurallyEqual(*sum1, *sum1));
+}
+
+TEST_F(FX_StructuralEquality, structurallyEqual_SumsOfConstants_BothPairingsTried) {
+    // all sums of 2^depth constants have the same hash, every level allows both pairings
+    std::function<PExpression(int, int, bool) > build = [&build](int depth, int first, bool isMirrored) -> PExpression {
+        if (depth == 0) {
+            return createConstant(first);
+        }
+        PExpression l = build(depth - 1, first, isMirrored);
+        PExpression r = build(depth - 1, first + (1 << (depth - 1)), isMirrored);
+        return isMirrored ? createSum(r, l) : createSum(l, r);
+    };
+    PExpression sum = build(12, 0, false);
+    PExpression mirrored = build(12, 0, true);
+    PExpression shifted = build(12, 1, false);
+
+    ASSERT_TRUE(structurallyEqual(*sum, *mirrored));
+    ASSERT_FALSE(structurallyEqual(*sum, *shifted));
+    ASSERT_FALSE(structurallyEqual(*mirrored, *shifted));
+}
+
+TEST_F(FX_StructuralEquality, structurallyEqual_VeryDeepTree_ComparedWithoutRecursion) {
+    // more pending pairs than fit into the stack on the call stack
+    PExpression chain1 = createVariable("x");
+    PExpression chain2 = createVariable("x");
+    for (int i = 0; i < 2000; i++) {
+        chain1 = createSub(createMult(createConstant(i), createVariable("y")), chain1);
+        chain2 = createSub(createMult(createVariable("y"), createConstant(i)), chain2);
+    }
+    ASSERT_TRUE(structurallyEqual(*chain1, *chain2));
+
+    PExpression chain3 = createSub(createVariable("x"), createConstant(1.0));
+    for (int i = 0; i < 2000; i++) {
+        chain3 = createSub(createMult(createConstant(i), createVariable("y")), chain3);
+    }
+    ASSERT_FALSE(structurallyEqual(*chain1, *chain3));
+}
@@ -0,0 +1,163 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file SymbolTableTest.cpp
+ *
+ * Test cases for SymbolTable.
+ *
+ * @since 18.10.2026
+ * @author agor
+ */
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "SymbolTable.h"
+#include "Parser.h"
+#include "ExpressionFactory.h"
+
+class FX_SymbolTable : public testing::Test {
+protected:
+
+    virtual void SetUp() {
+    }
+
+    virtual void TearDown() {
+    }
+};
+
+TEST_F(FX_SymbolTable, intern_Names_DenseIdentifiers) {
+    SymbolTable table;
+
+    ASSERT_EQ(SymbolTable::emptySymbol, table.intern(""));
+    ASSERT_EQ(1u, table.intern("x"));
+    ASSERT_EQ(2u, table.intern("y"));
+    ASSERT_EQ(1u, table.intern("x"));
+    ASSERT_EQ(3u, table.size());
+    ASSERT_EQ("y", table.nameOf(2));
+}
+
+TEST_F(FX_SymbolTable, find_UnknownName_None) {
+    SymbolTable table;
+    table.intern("x");
+
+    ASSERT_EQ(1u, table.find("x"));
+    ASSERT_EQ(SymbolTable::none, table.find("y"));
+    ASSERT_EQ(2u, table.size());
+}
+
+TEST_F(FX_SymbolTable, intern_CapacityExceeded_NewNamesRefused) {
+    // the empty name, "x" and "y"
+    SymbolTable table(3 * SymbolTable::entryMemory + 2);
+
+    ASSERT_EQ(1u, table.intern("x"));
+    ASSERT_EQ(2u, table.intern("y"));
+    ASSERT_FALSE(table.canIntern("z"));
+    ASSERT_EQ(SymbolTable::none, table.intern("z"));
+    ASSERT_TRUE(table.canIntern("x"));
+    ASSERT_EQ(1u, table.intern("x"));
+    ASSERT_EQ(3u, table.size());
+
+    table.setCapacity(0);
+    ASSERT_EQ(3u, table.intern("z"));
+}
+
+TEST_F(FX_SymbolTable, intern_CapacityExceeded_UnreferencedNamesEvicted) {
+    // the empty name and two names of one character
+    SymbolTable table(3 * SymbolTable::entryMemory + 2);
+    ASSERT_EQ(1u, table.intern("x"));
+    ASSERT_EQ(2u, table.intern("y"));
+    table.acquire(1);
+    table.release(1);
+    table.release(2);
+    ASSERT_TRUE(table.canIntern("z"));
+
+    // "x" is still referenced, "y" is evicted and its identifier is reused
+    ASSERT_EQ(2u, table.intern("z"));
+    ASSERT_EQ("z", table.nameOf(2));
+    ASSERT_EQ(SymbolTable::none, table.find("y"));
+    ASSERT_EQ(1u, table.find("x"));
+    ASSERT_EQ(SymbolTable::none, table.intern("w"));
+    ASSERT_EQ(3u, table.size());
+
+    table.release(1);
+    ASSERT_EQ(1u, table.intern("w"));
+    ASSERT_EQ(SymbolTable::none, table.find("x"));
+}
+
+TEST_F(FX_SymbolTable, parse_ManyNamesOfReleasedExpressions_NotRefused) {
+    // the global table has room for the referenced names and two more
+    PExpression alive = parse("aliveVariable");
+    SymbolTable::global().setCapacity(SymbolTable::global().referencedMemory() + 2 * (SymbolTable::entryMemory + 16));
+    bool isParsed = true;
+    for (char c = 'a'; c <= 'z' && isParsed; c++) {
+        isParsed = tryParse(std::string("released") + c + " + x").hasValue();
+    }
+    Expected<PExpression> third = tryParse("releaseda + releasedb + releasedc");
+    SymbolTable::global().setCapacity(SymbolTable::defaultCapacity);
+
+    ASSERT_TRUE(isParsed);
+    ASSERT_FALSE(third);
+    ASSERT_EQ("aliveVariable", SPointerCast<Variable>(alive)->name);
+    ASSERT_EQ(SPointerCast<Variable>(alive)->symbol, SymbolTable::global().find("aliveVariable"));
+}
+
+TEST_F(FX_SymbolTable, intern_SeveralThreads_SameIdentifiers) {
+    SymbolTable table;
+    std::vector<std::vector<SymbolId>> symbols(4);
+    std::vector<std::thread> threads;
+    for (size_t t = 0; t < symbols.size(); t++) {
+        threads.emplace_back([&table, &symbols, t]() {
+            for (int i = 0; i < 500; i++) {
+                symbols[t].push_back(table.intern("v" + std::to_string(i)));
+            }
+        });
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    ASSERT_EQ(501u, table.size());
+    for (size_t t = 1; t < symbols.size(); t++) {
+        ASSERT_EQ(symbols[0], symbols[t]);
+    }
+}
+
+TEST_F(FX_SymbolTable, parse_SameNames_SharedSymbols) {
+    PExpression expr1 = parse("alpha+beta");
+    PExpression expr2 = parse("beta*alpha");
+
+    PVariable alpha1 = SPointerCast<Variable>(SPointerCast<Sum>(expr1)->lArg);
+    PVariable alpha2 = SPointerCast<Variable>(SPointerCast<Mult>(expr2)->rArg);
+    ASSERT_EQ(alpha1->symbol, alpha2->symbol);
+    ASSERT_EQ(alpha1->symbol, SymbolTable::global().find("alpha"));
+    ASSERT_EQ(&alpha1->name, &alpha2->name);
+    ASSERT_EQ("alpha", createVariable(alpha1->symbol)->name);
+}
+
+TEST_F(FX_SymbolTable, parse_GlobalTableFull_ParsingError) {
+    parse("x");
+    SymbolTable::global().setCapacity(1);
+
+    ASSERT_TRUE(tryParse("2x").hasValue());
+    Expected<PExpression> result = tryParse("x + unknownVariable");
+    SymbolTable::global().setCapacity(SymbolTable::defaultCapacity);
+
+    ASSERT_FALSE(result);
+    ASSERT_EQ(0u, result.getFailure().message.find("Too many names of variables."));
+    ASSERT_EQ(SymbolTable::none, SymbolTable::global().find("unknownVariable"));
+
+    SymbolTable::global().setCapacity(1);
+    SyntaxCheck checked = checkSyntax("x + unknownVariable");
+    ASSERT_THROW(createVariable("unknownVariable"), TraverseException);
+    SymbolTable::global().setCapacity(SymbolTable::defaultCapacity);
+
+    ASSERT_FALSE(checked.isValid);
+    ASSERT_EQ(4u, checked.position);
+    ASSERT_STREQ("Too many names of variables.", checked.reason);
+}
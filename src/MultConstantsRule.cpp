@@ -19,6 +19,14 @@
 MultConstantsRule::MultConstantsRule(PMult _expression) : OptimizationRule(_expression) {
 }
 
+const char *MultConstantsRule::name() {
+    return "MultConstantsRule";
+}
+
+bool MultConstantsRule::mayApply(const PMult &expr) {
+    return expr->lArg->getType() == EConstant || expr->rArg->getType() == EConstant;
+}
+
 bool MultConstantsRule::apply() throw(TraverseException) {
     if(isTypeOf<Constant>(this->expression->lArg) && isTypeOf<Constant>(this->expression->rArg)){
         double val1=SPointerCast<Constant>(this->expression->lArg)->value;
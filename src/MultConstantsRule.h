@@ -30,6 +30,9 @@ class MultConstantsRule : public OptimizationRule<PMult> {
 public:
     MultConstantsRule(PMult _expression);
     bool apply() throw (TraverseException) final;
+
+    static const char *name();
+    static bool mayApply(const PMult &expr);
 };
 
 #endif /* MULTCONSTANTSRULE_H */
@@ -17,6 +17,15 @@
 MultIdenticalExpressionsRule::MultIdenticalExpressionsRule(PMult _expression): OptimizationRule(_expression) {
 }
 
+const char *MultIdenticalExpressionsRule::name() {
+    return "MultIdenticalExpressionsRule";
+}
+
+bool MultIdenticalExpressionsRule::mayApply(const PMult &) {
+    // any pair of factors can be powers of the same base: x*x^2
+    return true;
+}
+
 PPow castRightArgToPow(PExpression expr){
     if(isTypeOf<Pow>(expr)){
         return SPointerCast<Pow>(expr);
@@ -30,6 +30,9 @@ class MultIdenticalExpressionsRule : public OptimizationRule<PMult> {
 public:
     MultIdenticalExpressionsRule(PMult _expression);
     bool apply() throw(TraverseException) final;
+
+    static const char *name();
+    static bool mayApply(const PMult &expr);
 };
 
 #endif /* MULTIDENTICALEXPRESSIONSRULE_H */
@@ -17,6 +17,14 @@
 MultNumeratorDenominatorRule::MultNumeratorDenominatorRule(PMult _expression) : OptimizationRule(_expression){
 }
 
+const char *MultNumeratorDenominatorRule::name() {
+    return "MultNumeratorDenominatorRule";
+}
+
+bool MultNumeratorDenominatorRule::mayApply(const PMult &expr) {
+    return (expr->lArg->getType() == EDiv) != (expr->rArg->getType() == EDiv);
+}
+
 bool reduciblePair(PExpression denom, PExpression numer, std::function<void (PPow, PPow)> doReduce) {
     // 3.1. reducible means that both examined expressions are in fact exponentiations with the same base
     
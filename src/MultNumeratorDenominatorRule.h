@@ -30,6 +30,9 @@ class MultNumeratorDenominatorRule : public OptimizationRule<PMult>{
 public:
     MultNumeratorDenominatorRule(PMult _expression);
     bool apply() throw(TraverseException) final;
+
+    static const char *name();
+    static bool mayApply(const PMult &expr);
 };
 
 #endif /* MULTNUMERATORDENOMINATOR_H */
@@ -17,6 +17,18 @@
 MultQuotientsRule::MultQuotientsRule(PMult _expression) : OptimizationRule(_expression) {
 }
 
+const char *MultQuotientsRule::name() {
+    return "MultQuotientsRule";
+}
+
+bool MultQuotientsRule::mayApply(const PMult &expr) {
+    // a constant and a product or quotient
+    bool lArgIsConst = expr->lArg->getType() == EConstant;
+    bool rArgIsConst = expr->rArg->getType() == EConstant;
+    ExpressionType other = lArgIsConst ? expr->rArg->getType() : expr->lArg->getType();
+    return (lArgIsConst || rArgIsConst) && (other == EMult || other == EDiv);
+}
+
 bool putConstantToLeft(PMult expr, std::function<bool (PMult)> onSuccess) {
     bool isLArgConst = isTypeOf<Constant>(expr->lArg);
     bool isRArgConst = isTypeOf<Constant>(expr->rArg);
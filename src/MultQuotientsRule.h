@@ -29,6 +29,9 @@ class MultQuotientsRule : public OptimizationRule<PMult> {
 public:
     MultQuotientsRule(PMult _expression);
     bool apply() throw(TraverseException) final;
+
+    static const char *name();
+    static bool mayApply(const PMult &expr);
 };
 
 #endif /* MULTQUOTIENTSRULE_H */
@@ -17,6 +17,14 @@
 MultWithNumeratorRule::MultWithNumeratorRule(PMult _expression) : OptimizationRule(_expression) {
 }
 
+const char *MultWithNumeratorRule::name() {
+    return "MultWithNumeratorRule";
+}
+
+bool MultWithNumeratorRule::mayApply(const PMult &expr) {
+    return (expr->lArg->getType() == EDiv) != (expr->rArg->getType() == EDiv);
+}
+
 bool MultWithNumeratorRule::apply() throw(TraverseException) {
     bool largIsDiv=isTypeOf<Div>(this->expression->lArg);
     bool rargIsDiv=isTypeOf<Div>(this->expression->rArg);
@@ -30,6 +30,9 @@ public:
     MultWithNumeratorRule(PMult _expression);
     bool apply() throw(TraverseException) final;
 
+    static const char *name();
+    static bool mayApply(const PMult &expr);
+
 private:
 
 };
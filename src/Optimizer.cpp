@@ -18,164 +18,78 @@
 #include <iomanip>
 #include <sstream>
 #include <cmath>
+#include <deque>
 
 #include <ExpressionFactory.h>
 #include <Expression.h>
+#include <StructuralEquality.h>
+#include <ResourceBudget.h>
 
 #include "Doubles.h"
 #include "ExceptionThrower.h"
-#include "SumConstantsRule.h"
-#include "SumWithNullArgumentRule.h"
-#include "SumIdenticalExpressionsRule.h"
-#include "SumWithNegativeRule.h"
-#include "MultConstantsRule.h"
-#include "MultIdenticalExpressionsRule.h"
-#include "MultQuotientsRule.h"
-#include "MultNumeratorDenominatorRule.h"
-#include "MultWithNumeratorRule.h"
-#include "PowConstantRule.h"
-#include "PowOfPowRule.h"
+#include "RuleTable.tpp"
 #include "OptimizationRule.tpp"
 #include "FunctionEvaluateRule.tpp"
 #include "LnOfExpRule.h"
+#include "ParallelTraversal.tpp"
 
-/**
- * Initialize the vector of optimization rules for summation expression.
- * 
- * @param expr The Summation expression.
- * @return Vector consisting of unique pointers to OptimizationRule's.
- */
-inline std::vector<std::unique_ptr<OptimizationRule<PSum>>> summationRules(PSum expr) {
-    std::vector<std::unique_ptr<OptimizationRule<PSum>>> rules;
-    
-    // @TODO think about trygonometric rules: (sin(x))^2+(cos(x)^2)
-    rules.push_back(std::make_unique<SumConstantsRule>(expr));
-    rules.push_back(std::make_unique<SumWithNullArgumentRule>(expr));
-    rules.push_back(std::make_unique<SumIdenticalExpressionsRule>(expr));
-    rules.push_back(std::make_unique<SumWithNegativeRule>(expr));
-    
-    return rules;
-}
-
-/**
- * Initialize the vector of optimization rules for multiplication expression.
- * 
- * @param expr The Mult expression.
- * @return Vector consisting of unique pointers to OptimizationRule's.
- */
-inline std::vector<std::unique_ptr<OptimizationRule<PMult>>> multiplicationRules(PMult expr) {
-    std::vector<std::unique_ptr<OptimizationRule<PMult>>> rules;
-    
-    rules.push_back(std::make_unique<MultConstantsRule>(expr));
-    rules.push_back(std::make_unique<MultIdenticalExpressionsRule>(expr));
-    rules.push_back(std::make_unique<MultQuotientsRule>(expr));
-    rules.push_back(std::make_unique<MultNumeratorDenominatorRule>(expr));
-    rules.push_back(std::make_unique<MultWithNumeratorRule>(expr));
-    
-    return rules;
-}
-
-/**
- * Initialize the vector of optimization rules for exponentiation expression.
- * 
- * @param expr The Pow expression.
- * @return Vector consisting of unique pointers to OptimizationRule's.
- */
-inline std::vector<std::unique_ptr<OptimizationRule<PPow>>> exponentiationRules(PPow expr) {
-    std::vector<std::unique_ptr<OptimizationRule<PPow>>> rules;
-    
-    rules.push_back(std::make_unique<PowConstantRule>(expr));
-    rules.push_back(std::make_unique<PowOfPowRule>(expr));
-    
-    return rules;
+Optimizer::Optimizer(OptimizerStatistics *statistics) : statistics(statistics) {
 }
 
-void Optimizer::visit(const PConstConstant expr) throw (TraverseException) {
+PExpression Optimizer::postVisit(const Constant &expr) throw (TraverseException) {
     // Not applicable
-    this->setLastVisitResult(createConstant(expr->value));
+    return createConstant(expr.value);
 }
 
-void Optimizer::visit(const PConstVariable expr) throw (TraverseException) {
-    if (expr->name.empty()) {
+PExpression Optimizer::postVisit(const Variable &expr) throw (TraverseException) {
+    if (expr.name.empty()) {
         THROW(TraverseException, "No variable name is given.", "N.A");
     }
     // Not applicable
-    this->setLastVisitResult(createVariable(expr->name));
+    return createVariable(expr.symbol);
 }
 
 
-template <typename PCT, typename PT>
-PT Optimizer::optimizeArgumentsDiadic(const PCT expr, std::function<PT (PExpression, PExpression)> factory) {
-    if (!expr->isComplete()) {
-        THROW(TraverseException, "Expression is not consistent.", "LArg: " + to_string(expr->lArg) + "RArg:" + to_string(expr->rArg));
+template <typename T>
+void Optimizer::checkArgumentsDiadic(const T &expr) throw (TraverseException) {
+    if (!expr.isComplete()) {
+        THROW(TraverseException, "Expression is not consistent.", "LArg: " + to_string(expr.lArg) + "RArg:" + to_string(expr.rArg));
     }
-    
-    expr->lArg->traverse(*this);
-    PExpression optimizedLArg=this->getLastVisitResult();
-    
-    expr->rArg->traverse(*this);
-    PExpression optimizedRArg=this->getLastVisitResult();
-    
-    return factory(optimizedLArg, optimizedRArg);
 }
 
-template <typename PCT, typename PT>
-PT Optimizer::optimizeArgumentMonadic(const PCT expr, std::function<PT (PExpression)> factory) {
-    if (!expr->isComplete()) {
-        THROW(TraverseException, "Expression is not consistent.", "Arg: " + to_string(expr->arg));
+template <typename T>
+void Optimizer::checkArgumentMonadic(const T &expr) throw (TraverseException) {
+    if (!expr.isComplete()) {
+        THROW(TraverseException, "Expression is not consistent.", "Arg: " + to_string(expr.arg));
     }
-    
-    expr->arg->traverse(*this);
-    PExpression optimizedArg=this->getLastVisitResult();
-    
-    return factory(optimizedArg);
 }
 
 /**
- * Apply rules from the collection for the expression of type PT (rule must me suitable for type PT).
+ * Apply rules from the table for the expression of type PT until the first of them succeeds.
  * 
- * @param rules Vectror of OptimizationRule's. 
- * @param ifApplied Lambda which will be executed if at least one rule has been applied.
- * @param ifNotApplied Lambda which will be executed if no rule has been applied.
+ * @param Rules RuleTable for the type PT.
+ * @param expr The expression to be optimized.
+ * @param notOptimized The result if no rule has been applied.
+ * @param statistics Where attempts are recorded, can be nullptr.
+ * @return The optimized expression or notOptimized.
  */
-template <typename PT>
-void applyCollectionOfRules(std::vector<std::unique_ptr<OptimizationRule<PT>>> rules,
-        std::function<void(PExpression)> ifApplied, std::function<void()> ifNotApplied) {
-    for (auto &rule : rules){
-        if (rule->apply()) {
-            ifApplied(rule->getOptimizedExpression());
-            return;
-        }
+template <typename Rules, typename PT>
+PExpression applyRules(const PT &expr, const PExpression &notOptimized, OptimizerStatistics *statistics) throw (TraverseException) {
+    PExpression optimized;
+    if (Rules::applyFirst(expr, optimized, statistics)) {
+        return optimized;
     }
-    ifNotApplied();
+    return notOptimized;
 }
 
-void Optimizer::visit(const PConstSum expr) throw (TraverseException) {
-    PSum sumWithOptimizedArgs = optimizeArgumentsDiadic<PConstSum, PSum>(expr, [](PExpression lArg, PExpression rArg) -> PSum {
-        return createSum(lArg, rArg);
-    });
+PExpression Optimizer::postVisit(const Sum &expr, PExpression &lArg, PExpression &rArg) throw (TraverseException) {
+    checkArgumentsDiadic(expr);
+    PSum sumWithOptimizedArgs = createSum(lArg, rArg);
     
-    applyCollectionOfRules<PSum>(summationRules(sumWithOptimizedArgs), [this](PExpression optimizedExpression){
-        this->setLastVisitResult(optimizedExpression);
-    }, 
-    [this, &sumWithOptimizedArgs](){
-        this->setLastVisitResult(sumWithOptimizedArgs);
-    }
-    );
+    return applyRules<SummationRules>(sumWithOptimizedArgs, sumWithOptimizedArgs, this->statistics);
 }
 
-/**
- * Get the negative counterpart of given expression.
- * 
- * For instance: for negateExpression(a) = -a
- * If the expr is Variable or any function the Mult with 
- * "-1" as left argument will be returned.
- * 
- * @param expr The expression to be negated.
- * 
- * @return Negative expression.
- */
-inline PExpression negateExpression(PExpression expr) throw(TraverseException){
+PExpression negateExpression(PExpression expr) throw(TraverseException){
     if(isTypeOf<Mult>(expr)){
         PMult typedExpr=SPointerCast<Mult>(expr);
         
@@ -197,31 +111,18 @@ inline PExpression negateExpression(PExpression expr) throw(TraverseException){
     // @TODO what about Div?
 }
 
-void Optimizer::visit(const PConstSub expr) throw (TraverseException) {
-    PSub subWithOptimizedArgs = optimizeArgumentsDiadic<PConstSub, PSub>(expr, [](PExpression lArg, PExpression rArg) -> PSub {
-        return createSub(lArg, rArg);
-    });
+PExpression Optimizer::postVisit(const Sub &expr, PExpression &lArg, PExpression &rArg) throw (TraverseException) {
+    checkArgumentsDiadic(expr);
+    PSub subWithOptimizedArgs = createSub(lArg, rArg);
     
     // reprsent as summation and apply summation rules
-    negateExpression(subWithOptimizedArgs->rArg)->traverse(*this);
-    PExpression optimizedNegatedRArg=this->getLastVisitResult();
+    PExpression optimizedNegatedRArg=this->traversePostOrder(*negateExpression(subWithOptimizedArgs->rArg));
     PSum sumWithOptimizedArgs = createSum(subWithOptimizedArgs->lArg, optimizedNegatedRArg);
     
-    applyCollectionOfRules<PSum>(summationRules(sumWithOptimizedArgs), [this](PExpression optimizedExpression){
-        this->setLastVisitResult(optimizedExpression);
-    }, 
-    [this, &subWithOptimizedArgs](){
-        this->setLastVisitResult(subWithOptimizedArgs);
-    });
+    return applyRules<SummationRules>(sumWithOptimizedArgs, subWithOptimizedArgs, this->statistics);
 }
 
-/**
- * Obtain the inverted expression. For example: invertDenominator(x) = 1/x
- * 
- * @param expr Expression to invert
- * @return 
- */
-inline PExpression invertDenominator(PExpression expr) throw(TraverseException){
+PExpression invertDenominator(PExpression expr) throw(TraverseException){
     if(isTypeOf<Pow>(expr)){
         // x^n => x^-n
         PPow typedExpr=SPointerCast<Pow>(expr);
@@ -266,82 +167,58 @@ inline PExpression invertDenominator(PExpression expr) throw(TraverseException){
     return createPow(expr, createConstant(-1.0));
 }
 
-void Optimizer::visit(const PConstDiv expr) throw (TraverseException) {
-    PDiv divWithOptimizedArgs = optimizeArgumentsDiadic<PConstDiv, PDiv>(expr, [](PExpression lArg, PExpression rArg) -> PDiv {
-        return createDiv(lArg, rArg);
-    });
+PExpression Optimizer::postVisit(const Div &expr, PExpression &lArg, PExpression &rArg) throw (TraverseException) {
+    checkArgumentsDiadic(expr);
+    PDiv divWithOptimizedArgs = createDiv(lArg, rArg);
     
     // reprsent as product and apply multiplicationrules
-    invertDenominator(divWithOptimizedArgs->rArg)->traverse(*this);
-    PExpression optimizedInvertedRArg=this->getLastVisitResult();
+    PExpression optimizedInvertedRArg=this->traversePostOrder(*invertDenominator(divWithOptimizedArgs->rArg));
     PMult multWithOptimizedArgs = createMult(divWithOptimizedArgs->lArg, optimizedInvertedRArg);
     
-    applyCollectionOfRules<PMult>(multiplicationRules(multWithOptimizedArgs), [this](PExpression optimizedExpression){
-        this->setLastVisitResult(optimizedExpression);
-    }, 
-    [this, &divWithOptimizedArgs](){
-        this->setLastVisitResult(divWithOptimizedArgs);
-    });
+    return applyRules<MultiplicationRules>(multWithOptimizedArgs, divWithOptimizedArgs, this->statistics);
 }
 
-void Optimizer::visit(const PConstMult expr) throw (TraverseException) {
-    PMult multWithOptimizedArgs = optimizeArgumentsDiadic<PConstMult, PMult>(expr, [](PExpression lArg, PExpression rArg) -> PMult {
-        return createMult(lArg, rArg);
-    });
+PExpression Optimizer::postVisit(const Mult &expr, PExpression &lArg, PExpression &rArg) throw (TraverseException) {
+    checkArgumentsDiadic(expr);
+    PMult multWithOptimizedArgs = createMult(lArg, rArg);
     
-    applyCollectionOfRules<PMult>(multiplicationRules(multWithOptimizedArgs), [this](PExpression optimizedExpression){
-        this->setLastVisitResult(optimizedExpression);
-    }, 
-    [this, &multWithOptimizedArgs](){
-        this->setLastVisitResult(multWithOptimizedArgs);
-    });
+    return applyRules<MultiplicationRules>(multWithOptimizedArgs, multWithOptimizedArgs, this->statistics);
 }
 
-void Optimizer::visit(const PConstPow expr) throw (TraverseException) {
-    PPow powWithOptimizedArgs =optimizeArgumentsDiadic<PConstPow, PPow>(expr, [](PExpression lArg, PExpression rArg) -> PPow {
-        return createPow(lArg, rArg);
-    });
+PExpression Optimizer::postVisit(const Pow &expr, PExpression &lArg, PExpression &rArg) throw (TraverseException) {
+    checkArgumentsDiadic(expr);
+    PPow powWithOptimizedArgs = createPow(lArg, rArg);
     
-    applyCollectionOfRules<PPow>(exponentiationRules(powWithOptimizedArgs), [this](PExpression optimizedExpression){
-        this->setLastVisitResult(optimizedExpression);
-    }, 
-    [this, &powWithOptimizedArgs](){
-        this->setLastVisitResult(powWithOptimizedArgs);
-    });
+    return applyRules<ExponentiationRules>(powWithOptimizedArgs, powWithOptimizedArgs, this->statistics);
 }
 
-void Optimizer::visit(const PConstSin expr) throw (TraverseException) {
-    PSin sinWithOptimizedArgs = optimizeArgumentMonadic<PConstSin, PSin>(expr, [](PExpression arg) -> PSin {
-        return createSin(arg);
-    });
+PExpression Optimizer::postVisit(const Sin &expr, PExpression &arg) throw (TraverseException) {
+    checkArgumentMonadic(expr);
+    PSin sinWithOptimizedArgs = createSin(arg);
     
     FunctionEvaluateRule<Sin> rule(sinWithOptimizedArgs, [](double v) -> double{ return std::sin(v); });
-    if(rule.apply()){
-        this->setLastVisitResult(rule.getOptimizedExpression());
-        return;
+    if(applyRule(rule, "FunctionEvaluateRule<Sin>", this->statistics)){
+        return rule.getOptimizedExpression();
     }
     
-    this->setLastVisitResult(sinWithOptimizedArgs);
+    return sinWithOptimizedArgs;
 }
 
-void Optimizer::visit(const PConstCos expr) throw (TraverseException) {
-    PCos cosWithOptimizedArgs =optimizeArgumentMonadic<PConstCos, PCos>(expr, [](PExpression arg) -> PCos {
-        return createCos(arg);
-    });
+PExpression Optimizer::postVisit(const Cos &expr, PExpression &arg) throw (TraverseException) {
+    checkArgumentMonadic(expr);
+    PCos cosWithOptimizedArgs = createCos(arg);
     
     FunctionEvaluateRule<Cos> rule(cosWithOptimizedArgs, [](double v) -> double{ return std::cos(v); });
-    if(rule.apply()){
-        this->setLastVisitResult(rule.getOptimizedExpression());
-        return;
+    if(applyRule(rule, "FunctionEvaluateRule<Cos>", this->statistics)){
+        return rule.getOptimizedExpression();
     }
     
-    this->setLastVisitResult(cosWithOptimizedArgs);
+    return cosWithOptimizedArgs;
 }
 
-void Optimizer::visit(const PConstTan expr) throw (TraverseException) {
-    PTan tanWithOptimizedArgs = optimizeArgumentMonadic<PConstTan, PTan>(expr, [](PExpression arg) -> PTan {
-        return createTan(arg);
-    });
+PExpression Optimizer::postVisit(const Tan &expr, PExpression &arg) throw (TraverseException) {
+    checkArgumentMonadic(expr);
+    PTan tanWithOptimizedArgs = createTan(arg);
     
     FunctionEvaluateRule<Tan> rule(tanWithOptimizedArgs, [&tanWithOptimizedArgs](double v) -> double{ 
         double n = ((2*v)+PI)/(2*PI);
@@ -353,18 +230,16 @@ void Optimizer::visit(const PConstTan expr) throw (TraverseException) {
         return std::tan(v); 
     });
     
-    if(rule.apply()){
-        this->setLastVisitResult(rule.getOptimizedExpression());
-        return;
+    if(applyRule(rule, "FunctionEvaluateRule<Tan>", this->statistics)){
+        return rule.getOptimizedExpression();
     }
     
-    this->setLastVisitResult(tanWithOptimizedArgs);
+    return tanWithOptimizedArgs;
 }
 
-void Optimizer::visit(const PConstCtan expr) throw (TraverseException) {
-    PCtan ctanWithOptimizedArgs = optimizeArgumentMonadic<PConstCtan, PCtan>(expr, [](PExpression arg) -> PCtan {
-        return createCtan(arg);
-    });
+PExpression Optimizer::postVisit(const Ctan &expr, PExpression &arg) throw (TraverseException) {
+    checkArgumentMonadic(expr);
+    PCtan ctanWithOptimizedArgs = createCtan(arg);
     
     FunctionEvaluateRule<Ctan> rule(ctanWithOptimizedArgs, [&ctanWithOptimizedArgs](double v) -> double{ 
         double n = v/PI;
@@ -376,18 +251,16 @@ void Optimizer::visit(const PConstCtan expr) throw (TraverseException) {
         return std::cos(v)/std::sin(v); 
     });
     
-    if(rule.apply()){
-        this->setLastVisitResult(rule.getOptimizedExpression());
-        return;
+    if(applyRule(rule, "FunctionEvaluateRule<Ctan>", this->statistics)){
+        return rule.getOptimizedExpression();
     }
     
-    this->setLastVisitResult(ctanWithOptimizedArgs);
+    return ctanWithOptimizedArgs;
 }
 
-void Optimizer::visit(const PConstLn expr) throw (TraverseException) {
-    PLn lnWithOptimizedArgs = optimizeArgumentMonadic<PConstLn, PLn>(expr, [](PExpression arg) -> PLn {
-        return createLn(arg);
-    });
+PExpression Optimizer::postVisit(const Ln &expr, PExpression &arg) throw (TraverseException) {
+    checkArgumentMonadic(expr);
+    PLn lnWithOptimizedArgs = createLn(arg);
     
     FunctionEvaluateRule<Ln> ruleEval(lnWithOptimizedArgs, [&lnWithOptimizedArgs](double v) -> double{ 
         if(v <= 0.0){ 
@@ -396,47 +269,55 @@ void Optimizer::visit(const PConstLn expr) throw (TraverseException) {
         }
         return std::log(v); 
     });
-    if(ruleEval.apply()){
-        this->setLastVisitResult(ruleEval.getOptimizedExpression());
-        return;
+    if(applyRule(ruleEval, "FunctionEvaluateRule<Ln>", this->statistics)){
+        return ruleEval.getOptimizedExpression();
     }
     
     LnOfExpRule ruleLnExp(lnWithOptimizedArgs);
-    if(ruleLnExp.apply()){
-        this->setLastVisitResult(ruleLnExp.getOptimizedExpression());
-        return;
+    if(applyRule(ruleLnExp, LnOfExpRule::name(), this->statistics)){
+        return ruleLnExp.getOptimizedExpression();
     }
 
-    this->setLastVisitResult(lnWithOptimizedArgs);
+    return lnWithOptimizedArgs;
 }
 
-void Optimizer::visit(const PConstExp expr) throw (TraverseException) {
-//    std::cout << "Visit EXP: entered" << std::endl;
-    PExp expWithOptimizedArgs = optimizeArgumentMonadic<PConstExp, PExp>(expr, [](PExpression arg) -> PExp {
-        return createExp(arg);
-    });
+PExpression Optimizer::postVisit(const Exp &expr, PExpression &arg) throw (TraverseException) {
+    checkArgumentMonadic(expr);
+    PExp expWithOptimizedArgs = createExp(arg);
     
     FunctionEvaluateRule<Exp> rule(expWithOptimizedArgs, [](double v) -> double{ 
         return std::exp(v); 
     });
     
-    if(rule.apply()){
-        this->setLastVisitResult(rule.getOptimizedExpression());
-        return;
+    if(applyRule(rule, "FunctionEvaluateRule<Exp>", this->statistics)){
+        return rule.getOptimizedExpression();
     }
     
-    this->setLastVisitResult(expWithOptimizedArgs);
-}
-
-PExpression Optimizer::getLastVisitResult() const {
-    return this->result;
+    return expWithOptimizedArgs;
 }
 
-void Optimizer::setLastVisitResult(PExpression result) {
-    this->result = result;
+/**
+ * Single pass of optimize() by several threads. Workers record their attempts
+ * separately, they are added to the statistics afterwards.
+ */
+static PExpression optimizeParallel(Optimizer &optimizer, const Expression &expr, OptimizerStatistics *statistics, 
+        ThreadPool &pool, size_t grainSize) throw (TraverseException){
+    std::deque<OptimizerStatistics> taskStatistics;
+    PExpression optimizedExpr=traverseParallel<PExpression, Optimizer>(expr, pool, grainSize, [statistics, &taskStatistics]() {
+        if(statistics==nullptr){
+            return std::unique_ptr<Optimizer>(new Optimizer());
+        }
+        taskStatistics.emplace_back();
+        return std::unique_ptr<Optimizer>(new Optimizer(&taskStatistics.back()));
+    }, optimizer);
+    
+    for(const OptimizerStatistics &workerStatistics : taskStatistics){
+        statistics->merge(workerStatistics);
+    }
+    return optimizedExpr;
 }
 
-PExpression optimize(PExpression expr) throw (TraverseException){
+PExpression optimize(PExpression expr, OptimizerStatistics *statistics, ThreadPool *pool, size_t grainSize) throw (TraverseException){
     if(expr==nullptr){
         THROW(TraverseException, "Not possible to optimize the NULL expressions.", "N.A.");
     }
@@ -449,15 +330,37 @@ PExpression optimize(PExpression expr) throw (TraverseException){
     // will not differ
     PExpression previousExpression=expr;
     while(!isDone || attemptN < attemtLimit){
-        Optimizer optimizer;
-        previousExpression->traverse(optimizer);
-        PExpression optimizedExpr=optimizer.getLastVisitResult();
+        // an oscillating expression is not done ever, it is stopped by the budget
+        chargePass();
+        Optimizer optimizer(statistics);
+        if(statistics!=nullptr){
+            statistics->beginPass();
+        }
+        PExpression optimizedExpr=(pool==nullptr) 
+                ? optimizer.traversePostOrder(*previousExpression)
+                : optimizeParallel(optimizer, *previousExpression, statistics, *pool, grainSize);
+        if(statistics!=nullptr){
+            statistics->endPass();
+        }
         //std::cout << "Optimization step #" << attemptN << ": " << to_string(optimizedExpr) << std::endl;
-        isDone = equals(optimizedExpr, previousExpression);
+        isDone = structurallyEqual(*optimizedExpr, *previousExpression);
         
         previousExpression=optimizedExpr;
         attemptN++;
     }
     
     return previousExpression;
-}
\ No newline at end of file
+}
+
+Expected<PExpression> tryOptimize(PExpression expr, OptimizerStatistics *statistics, ThreadPool *pool, size_t grainSize){
+    if(expr==nullptr){
+        return Failure{Failure::Traverse, "Not possible to optimize the NULL expressions. Context: N.A."};
+    }
+    try{
+        return optimize(expr, statistics, pool, grainSize);
+    }catch(BudgetExceededException ex){
+        return Failure{Failure::Budget, ex.what()};
+    }catch(TraverseException ex){
+        return Failure{Failure::Traverse, ex.what()};
+    }
+}
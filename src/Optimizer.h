@@ -15,7 +15,11 @@
 #define OPTIMIZER_H
 
 #include <vector>
-#include <Visitor.h>
+#include <PostOrderVisitor.h>
+#include <Expected.h>
+
+#include "OptimizerStatistics.h"
+#include "ThreadPool.h"
 
 /**
  * The Optimizer is intended to simtlify the Expression.
@@ -26,55 +30,49 @@
  * compare current optimization with previous result. In other words input expression 
  * should be structurally immutable here. 
  */
-class Optimizer : public Visitor {
+class Optimizer : public PostOrderVisitor<PExpression> {
 private:
-    /* the optimized expression
-     Consideration: the result SPointer must not be the same as  expr
-     * argimet of visit() method!
-     */
-    PExpression result; 
+    OptimizerStatistics *statistics;
     
     /**
-     * Optimize the arguments of the expression representing diadic operation (+,-, * etc.).
-     * 
-     * @TODO This code is ugly because of PCT and PT template parameters. 
-     * @TODO PT denptes the ponter type of expression and PCT is a pointer type for constant of the same expression.
-     * @TODO I have no idea so far how to refactor it properly.
+     * Ensure that the expression representing diadic operation (+,-, * etc.) 
+     * has both arguments.
      * 
-     * @param expr The expression which arguments have to be optimized.
-     * @param factory A lambda function that acts like a factory method to create the new instance of expression.
-     * @return The new expression of the same type as expr, but with optimized arguments.
+     * @param expr The expression which arguments have been optimized.
      */
-    template <typename PCT, typename PT>
-    PT optimizeArgumentsDiadic(const PCT expr, std::function<PT (PExpression, PExpression)> factory) ;
+    template <typename T>
+    void checkArgumentsDiadic(const T &expr) throw (TraverseException);
     
     /**
-     * Optimize the argument of the expression representing monadic operation (function of one arg).
+     * Ensure that the expression representing monadic operation (function of one arg) 
+     * has the argument.
      * 
-     * @param expr The expression which arguments have to be optimized.
-     * @param factory A lambda function that acts like a factory method to create the new instance of expression.
-     * @return The new expression of the same type as expr, but with optimized argument.
+     * @param expr The expression which argument has been optimized.
      */
-    template <typename PCT, typename PT>
-    PT optimizeArgumentMonadic(const PCT expr, std::function<PT (PExpression)> factory) ;
+    template <typename T>
+    void checkArgumentMonadic(const T &expr) throw (TraverseException);
+    
+protected:
+    PExpression postVisit(const Constant &expr) throw (TraverseException) final;
+    PExpression postVisit(const Variable &expr) throw (TraverseException) final;
+    PExpression postVisit(const Sum &expr, PExpression &lArg, PExpression &rArg) throw (TraverseException) final;
+    PExpression postVisit(const Sub &expr, PExpression &lArg, PExpression &rArg) throw (TraverseException) final;
+    PExpression postVisit(const Mult &expr, PExpression &lArg, PExpression &rArg) throw (TraverseException) final;
+    PExpression postVisit(const Div &expr, PExpression &lArg, PExpression &rArg) throw (TraverseException) final;
+    PExpression postVisit(const Pow &expr, PExpression &lArg, PExpression &rArg) throw (TraverseException) final;
+    PExpression postVisit(const Sin &expr, PExpression &arg) throw (TraverseException) final;
+    PExpression postVisit(const Cos &expr, PExpression &arg) throw (TraverseException) final;
+    PExpression postVisit(const Tan &expr, PExpression &arg) throw (TraverseException) final;
+    PExpression postVisit(const Ctan &expr, PExpression &arg) throw (TraverseException) final;
+    PExpression postVisit(const Ln &expr, PExpression &arg) throw (TraverseException) final;
+    PExpression postVisit(const Exp &expr, PExpression &arg) throw (TraverseException) final;
     
 public:
-    void visit(const PConstConstant expr) throw (TraverseException) final;
-    void visit(const PConstVariable expr) throw (TraverseException) final;
-    void visit(const PConstSum expr) throw (TraverseException) final;
-    void visit(const PConstSub expr) throw (TraverseException) final;
-    void visit(const PConstMult expr) throw (TraverseException) final;
-    void visit(const PConstDiv expr) throw (TraverseException) final;
-    void visit(const PConstPow expr) throw (TraverseException) final;
-    void visit(const PConstSin expr) throw (TraverseException) final;
-    void visit(const PConstCos expr) throw (TraverseException) final;
-    void visit(const PConstTan expr) throw (TraverseException) final;
-    void visit(const PConstCtan expr) throw (TraverseException) final;
-    void visit(const PConstLn expr) throw (TraverseException) final;
-    void visit(const PConstExp expr) throw (TraverseException) final;
-
-    void setLastVisitResult(const PExpression result);
-    PExpression getLastVisitResult() const;
+    /**
+     * @param statistics Where attempts to apply OptimizationRule's are recorded.
+     * Can be nullptr, then nothing is recorded.
+     */
+    Optimizer(OptimizerStatistics *statistics = nullptr);
 };
 
 /**
@@ -82,10 +80,47 @@ public:
  * 
  * This function is a facade for Optmizer.
  * 
+ * Every pass and the created nodes are charged to the ResourceBudget of the 
+ * calling thread, if it has one (see BudgetScope).
+ * 
  * @param expr Expression to be optimized.
+ * @param statistics Optional statistics of rules and passes.
+ * @param pool If given, subtrees of large expressions are optimized in parallel
+ * (see traverseParallel()), the result is the same.
+ * @param grainSize Expressions of fewer nodes are optimized by one thread.
  * @return The SPointer to the optimized Expression (it can be in factthe same SPointer as an input.)
  */
-PExpression optimize(PExpression expr) throw (TraverseException);
+PExpression optimize(PExpression expr, OptimizerStatistics *statistics = nullptr, 
+        ThreadPool *pool = nullptr, size_t grainSize = defaultGrainSize) throw (TraverseException);
+
+/**
+ * Like optimize(), errors (e.g. division by zero) are returned as 
+ * Failure::Traverse instead of thrown, an exhausted ResourceBudget as 
+ * Failure::Budget.
+ */
+Expected<PExpression> tryOptimize(PExpression expr, OptimizerStatistics *statistics = nullptr, 
+        ThreadPool *pool = nullptr, size_t grainSize = defaultGrainSize);
+
+/**
+ * Get the negative counterpart of given expression.
+ * 
+ * For instance: for negateExpression(a) = -a
+ * If the expr is Variable or any function the Mult with 
+ * "-1" as left argument will be returned.
+ * 
+ * @param expr The expression to be negated.
+ * 
+ * @return Negative expression.
+ */
+PExpression negateExpression(PExpression expr) throw(TraverseException);
+
+/**
+ * Obtain the inverted expression. For example: invertDenominator(x) = 1/x
+ * 
+ * @param expr Expression to invert
+ * @return The inverted expression.
+ */
+PExpression invertDenominator(PExpression expr) throw(TraverseException);
 
 #endif /* OPTIMIZER_H */
 
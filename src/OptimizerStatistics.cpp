@@ -0,0 +1,121 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file OptimizerStatistics.cpp
+ *
+ * Implementation of OptimizerStatistics.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#include "OptimizerStatistics.h"
+
+#include <iomanip>
+
+void OptimizerStatistics::record(const char *rule, bool hit, std::chrono::nanoseconds time) {
+    auto found = this->index.find(rule);
+    if (found == this->index.end()) {
+        found = this->index.emplace(rule, this->rules.size()).first;
+        this->rules.push_back(RuleStatistics());
+        this->rules.back().name = rule;
+    }
+
+    RuleStatistics &ruleStatistics = this->rules[found->second];
+    ruleStatistics.attempts++;
+    ruleStatistics.hits += hit ? 1 : 0;
+    ruleStatistics.time += time;
+
+    if (!this->passes.empty()) {
+        PassStatistics &pass = this->passes.back();
+        pass.attempts++;
+        pass.hits += hit ? 1 : 0;
+        pass.ruleTime += time;
+    }
+}
+
+void OptimizerStatistics::merge(const OptimizerStatistics &other) {
+    for (const RuleStatistics &rule : other.rules) {
+        auto found = this->index.find(rule.name);
+        if (found == this->index.end()) {
+            found = this->index.emplace(rule.name, this->rules.size()).first;
+            this->rules.push_back(RuleStatistics());
+            this->rules.back().name = rule.name;
+        }
+
+        RuleStatistics &ruleStatistics = this->rules[found->second];
+        ruleStatistics.attempts += rule.attempts;
+        ruleStatistics.hits += rule.hits;
+        ruleStatistics.time += rule.time;
+
+        if (!this->passes.empty()) {
+            PassStatistics &pass = this->passes.back();
+            pass.attempts += rule.attempts;
+            pass.hits += rule.hits;
+            pass.ruleTime += rule.time;
+        }
+    }
+}
+
+void OptimizerStatistics::beginPass() {
+    this->passes.push_back(PassStatistics());
+    this->passStart = std::chrono::steady_clock::now();
+}
+
+void OptimizerStatistics::endPass() {
+    if (this->passes.empty()) {
+        return;
+    }
+    this->passes.back().time = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - this->passStart);
+}
+
+const std::vector<RuleStatistics> &OptimizerStatistics::getRules() const {
+    return this->rules;
+}
+
+const RuleStatistics *OptimizerStatistics::getRule(const std::string &rule) const {
+    auto found = this->index.find(rule);
+    if (found == this->index.end()) {
+        return nullptr;
+    }
+    return &this->rules[found->second];
+}
+
+const std::vector<PassStatistics> &OptimizerStatistics::getPasses() const {
+    return this->passes;
+}
+
+/**
+ * Convert the duration to microseconds.
+ */
+inline double toMicroseconds(std::chrono::nanoseconds time) {
+    return std::chrono::duration<double, std::micro>(time).count();
+}
+
+void OptimizerStatistics::print(std::ostream &out) const {
+    std::ios::fmtflags flags = out.flags();
+    out << std::fixed << std::setprecision(1);
+
+    out << std::left << std::setw(32) << "rule" << std::right
+            << std::setw(10) << "attempts" << std::setw(10) << "hits" << std::setw(12) << "time, us" << std::endl;
+    for (const RuleStatistics &rule : this->rules) {
+        out << std::left << std::setw(32) << rule.name << std::right
+                << std::setw(10) << rule.attempts << std::setw(10) << rule.hits
+                << std::setw(12) << toMicroseconds(rule.time) << std::endl;
+    }
+
+    out << std::endl;
+    out << std::left << std::setw(8) << "pass" << std::right
+            << std::setw(10) << "attempts" << std::setw(10) << "hits"
+            << std::setw(14) << "rules, us" << std::setw(12) << "total, us" << std::endl;
+    for (size_t n = 0; n < this->passes.size(); n++) {
+        const PassStatistics &pass = this->passes[n];
+        out << std::left << std::setw(8) << (n + 1) << std::right
+                << std::setw(10) << pass.attempts << std::setw(10) << pass.hits
+                << std::setw(14) << toMicroseconds(pass.ruleTime) << std::setw(12) << toMicroseconds(pass.time) << std::endl;
+    }
+
+    out.flags(flags);
+}
@@ -0,0 +1,108 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file OptimizerStatistics.h
+ *
+ * Definition of OptimizerStatistics.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#ifndef OPTIMIZERSTATISTICS_H
+#define OPTIMIZERSTATISTICS_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <chrono>
+#include <functional>
+#include <ostream>
+
+/**
+ * Counters of a single OptimizationRule.
+ */
+struct RuleStatistics {
+    std::string name;
+    unsigned long attempts = 0; ///< Number of apply() calls.
+    unsigned long hits = 0; ///< Number of apply() calls which returned true.
+    std::chrono::nanoseconds time = std::chrono::nanoseconds::zero(); ///< Cumulative time spent in apply().
+};
+
+/**
+ * Counters of a single pass of the Optimizer over the expression.
+ */
+struct PassStatistics {
+    unsigned long attempts = 0; ///< Number of apply() calls of all rules.
+    unsigned long hits = 0; ///< Number of successfully applied rules.
+    std::chrono::nanoseconds ruleTime = std::chrono::nanoseconds::zero(); ///< Time spent in rules.
+    std::chrono::nanoseconds time = std::chrono::nanoseconds::zero(); ///< Duration of the pass.
+};
+
+/**
+ * Collects the number of attempts, hits and the time spent per OptimizationRule
+ * and per pass of optimize().
+ *
+ * The instance is passed to the Optimizer optionally, without it nothing is
+ * measured.
+ */
+class OptimizerStatistics {
+private:
+    std::vector<RuleStatistics> rules; // in order of the first attempt
+    std::map<std::string, size_t, std::less<>> index; // name -> position in rules
+    std::vector<PassStatistics> passes;
+    std::chrono::steady_clock::time_point passStart;
+
+public:
+    /**
+     * Register the attempt to apply the rule.
+     *
+     * @param rule Name of the rule.
+     * @param hit Result of apply().
+     * @param time Time spent in apply().
+     */
+    void record(const char *rule, bool hit, std::chrono::nanoseconds time);
+
+    /**
+     * Add attempts recorded by another instance (e.g. by another thread) to 
+     * the rules and to the current pass.
+     *
+     * @param other Statistics without passes.
+     */
+    void merge(const OptimizerStatistics &other);
+
+    /**
+     * Start the next pass. Attempts recorded before the first pass are not
+     * attributed to any pass.
+     */
+    void beginPass();
+
+    /**
+     * Finish the current pass.
+     */
+    void endPass();
+
+    /**
+     * @return Statistics of rules in order of the first attempt.
+     */
+    const std::vector<RuleStatistics> &getRules() const;
+
+    /**
+     * @return Statistics of the rule, nullptr if the rule was never attempted.
+     */
+    const RuleStatistics *getRule(const std::string &rule) const;
+
+    /**
+     * @return Statistics of passes.
+     */
+    const std::vector<PassStatistics> &getPasses() const;
+
+    /**
+     * Print both tables in human readable form.
+     */
+    void print(std::ostream &out) const;
+};
+
+#endif /* OPTIMIZERSTATISTICS_H */
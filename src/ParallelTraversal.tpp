@@ -0,0 +1,183 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file ParallelTraversal.tpp
+ *
+ * Definition of the fork-join traversal of large expressions.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#ifndef PARALLELTRAVERSAL_H
+#define PARALLELTRAVERSAL_H
+
+#include <vector>
+#include <unordered_map>
+#include <functional>
+
+#include <Expression.h>
+#include <PostOrderVisitor.h>
+#include <ResourceBudget.h>
+#include <TraverseException.h>
+
+#include "ThreadPool.h"
+
+/**
+ * Finds subtrees which are processed as separate tasks by traverseParallel():
+ * the arguments of a node of at least grainSize nodes, which are not split
+ * themselves. Arguments smaller than a quarter of grainSize are left to the
+ * parent, the overhead of a task would outweigh them.
+ */
+class TaskPartition : public PostOrderVisitor<size_t> {
+private:
+    const size_t grainSize;
+
+    size_t node(const Expression &expr, const size_t *argSizes, unsigned int argCount) {
+        size_t size = 1;
+        for (unsigned int n = 0; n < argCount; n++) {
+            size += argSizes[n];
+        }
+        if (size < this->grainSize) {
+            return size;
+        }
+
+        const Expression *args[2];
+        argumentsOf(expr, args);
+        for (unsigned int n = 0; n < argCount; n++) {
+            if (args[n] != nullptr && argSizes[n] < this->grainSize && argSizes[n] * 4 >= this->grainSize) {
+                this->tasks.push_back(args[n]);
+            }
+        }
+        return size;
+    }
+
+protected:
+    size_t postVisit(const Constant &) throw (TraverseException) final {
+        return 1;
+    }
+
+    size_t postVisit(const Variable &) throw (TraverseException) final {
+        return 1;
+    }
+
+    size_t postVisit(const Sum &expr, size_t &lArg, size_t &rArg) throw (TraverseException) final {
+        size_t sizes[2] = {lArg, rArg};
+        return this->node(expr, sizes, 2);
+    }
+
+    size_t postVisit(const Sub &expr, size_t &lArg, size_t &rArg) throw (TraverseException) final {
+        size_t sizes[2] = {lArg, rArg};
+        return this->node(expr, sizes, 2);
+    }
+
+    size_t postVisit(const Div &expr, size_t &lArg, size_t &rArg) throw (TraverseException) final {
+        size_t sizes[2] = {lArg, rArg};
+        return this->node(expr, sizes, 2);
+    }
+
+    size_t postVisit(const Mult &expr, size_t &lArg, size_t &rArg) throw (TraverseException) final {
+        size_t sizes[2] = {lArg, rArg};
+        return this->node(expr, sizes, 2);
+    }
+
+    size_t postVisit(const Pow &expr, size_t &lArg, size_t &rArg) throw (TraverseException) final {
+        size_t sizes[2] = {lArg, rArg};
+        return this->node(expr, sizes, 2);
+    }
+
+    size_t postVisit(const Sin &expr, size_t &arg) throw (TraverseException) final {
+        return this->node(expr, &arg, 1);
+    }
+
+    size_t postVisit(const Cos &expr, size_t &arg) throw (TraverseException) final {
+        return this->node(expr, &arg, 1);
+    }
+
+    size_t postVisit(const Tan &expr, size_t &arg) throw (TraverseException) final {
+        return this->node(expr, &arg, 1);
+    }
+
+    size_t postVisit(const Ctan &expr, size_t &arg) throw (TraverseException) final {
+        return this->node(expr, &arg, 1);
+    }
+
+    size_t postVisit(const Ln &expr, size_t &arg) throw (TraverseException) final {
+        return this->node(expr, &arg, 1);
+    }
+
+    size_t postVisit(const Exp &expr, size_t &arg) throw (TraverseException) final {
+        return this->node(expr, &arg, 1);
+    }
+
+public:
+    std::vector<const Expression *> tasks; ///< Roots of subtrees in post-order.
+
+    TaskPartition(size_t grainSize) : grainSize(grainSize) {
+    }
+};
+
+/**
+ * Traverse the tree by several visitors in parallel.
+ *
+ * The tree is split into subtrees of about grainSize nodes (see TaskPartition),
+ * each of them is traversed by a separate visitor on the pool. Then the visitor
+ * of the calling thread traverses the upper part of the tree, where the results
+ * of these subtrees are taken as they are.
+ *
+ * The result is the same as of the sequential traversal, as long as the result
+ * of a node depends only on its subtree. Visitors must not share mutable state.
+ * Hashes of the tree are calculated beforehand, since they are cached lazily.
+ * The traversal is sequential if reference counting of SPointer is not
+ * thread-safe (see USE_INTRUSIVE_SPOINTER).
+ *
+ * @param expr Root of the tree.
+ * @param pool Executes the subtree tasks.
+ * @param grainSize Minimal size of a tree to be split.
+ * @param makeTaskVisitor Creates a visitor for a subtree task, it is called
+ * in the calling thread.
+ * @param visitor Visitor of the calling thread, traverses the upper part.
+ * @return Result of the visitor for the root.
+ */
+template <typename R, typename V>
+R traverseParallel(const Expression &expr, ThreadPool &pool, size_t grainSize,
+        std::function<std::unique_ptr<V>()> makeTaskVisitor, PostOrderVisitor<R> &visitor) throw (TraverseException) {
+    TaskPartition partition(grainSize);
+    if (!isSPointerThreadSafe || pool.size() < 2 || partition.traversePostOrder(expr) < grainSize || partition.tasks.size() < 2) {
+        return visitor.traversePostOrder(expr);
+    }
+    expr.getHash();
+
+    const std::vector<const Expression *> &subtrees = partition.tasks;
+    std::vector<std::unique_ptr<V>> taskVisitors;
+    std::vector<R> results(subtrees.size());
+    std::vector<std::function<void()>> tasks;
+    // workers charge the budget of the request
+    ResourceBudget *budget = ResourceBudget::current();
+    for (size_t i = 0; i < subtrees.size(); i++) {
+        taskVisitors.push_back(makeTaskVisitor());
+        tasks.push_back([&taskVisitors, &results, &subtrees, i, budget]() {
+            BudgetScope scope(budget);
+            results[i] = taskVisitors[i]->traversePostOrder(*subtrees[i]);
+        });
+    }
+    pool.run(tasks);
+
+    std::unordered_map<const Expression *, R> precomputed;
+    for (size_t i = 0; i < subtrees.size(); i++) {
+        precomputed.emplace(subtrees[i], std::move(results[i]));
+    }
+    visitor.setPrecomputedResults(&precomputed);
+    try {
+        R result = visitor.traversePostOrder(expr);
+        visitor.setPrecomputedResults(nullptr);
+        return result;
+    } catch (...) {
+        visitor.setPrecomputedResults(nullptr);
+        throw;
+    }
+}
+
+#endif /* PARALLELTRAVERSAL_H */
@@ -20,6 +20,14 @@
 PowConstantRule::PowConstantRule(PPow _expression) : OptimizationRule(_expression){
 }
 
+const char *PowConstantRule::name() {
+    return "PowConstantRule";
+}
+
+bool PowConstantRule::mayApply(const PPow &expr) {
+    return expr->rArg->getType() == EConstant;
+}
+
 bool PowConstantRule::apply() throw(TraverseException){    
     if(!isTypeOf<Constant>(this->expression->rArg)){
         return false;
@@ -31,6 +31,9 @@ class PowConstantRule : public OptimizationRule<PPow> {
 public:
     PowConstantRule(PPow _expression);
     bool apply() throw (TraverseException) final;
+
+    static const char *name();
+    static bool mayApply(const PPow &expr);
 };
 
 #endif /* POWCONSTANTRULE_H */
@@ -18,6 +18,14 @@
 PowOfPowRule::PowOfPowRule(PPow _expression) : OptimizationRule(_expression) {
 }
 
+const char *PowOfPowRule::name() {
+    return "PowOfPowRule";
+}
+
+bool PowOfPowRule::mayApply(const PPow &expr) {
+    return expr->lArg->getType() == EPow || expr->lArg->getType() == EDiv;
+}
+
 
 bool PowOfPowRule::apply() throw (TraverseException){
     if(isTypeOf<Pow>(this->expression->lArg)){
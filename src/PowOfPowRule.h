@@ -29,6 +29,9 @@ class PowOfPowRule : public OptimizationRule<PPow> {
 public:
     PowOfPowRule(PPow _expression);
     bool apply() throw(TraverseException) final;
+
+    static const char *name();
+    static bool mayApply(const PPow &expr);
 };
 
 #endif /* POWOFPOWRULE_H */
@@ -0,0 +1,221 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file ResultStore.cpp
+ *
+ * Implementation of the persistent store of derivatives.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#include "ResultStore.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <ParseCache.h>
+
+namespace {
+
+const char magic[4] = {'A', 'G', 'R', 'S'};
+const std::uint32_t version = 1;
+const size_t headerSize = sizeof (magic) + sizeof (version);
+const size_t minimalMapping = 1 << 20;
+
+struct RecordHeader {
+    std::uint32_t keyLength;
+    std::uint32_t valueLength;
+    std::uint64_t hash;
+};
+
+/**
+ * FNV-1a
+ */
+std::uint64_t hashOf(const std::string &key) {
+    std::uint64_t hash = 14695981039346656037ull;
+    for (char c : key) {
+        hash = (hash ^ static_cast<unsigned char> (c)) * 1099511628211ull;
+    }
+    return hash;
+}
+
+}
+
+ResultStore::ResultStore() : file(-1), mapping(nullptr), mappedSize(0), fileSize(0), indexedSize(0) {
+}
+
+ResultStore::~ResultStore() {
+    this->close();
+}
+
+void ResultStore::close() {
+    this->unmap();
+    if (this->file >= 0) {
+        ::close(this->file);
+        this->file = -1;
+    }
+    this->index.clear();
+}
+
+bool ResultStore::map() {
+    if (this->mapping != nullptr && this->fileSize <= this->mappedSize) {
+        // the mapping is larger than the file, appended records are visible in it
+        return true;
+    }
+
+    this->unmap();
+    size_t size = std::max(minimalMapping, 2 * this->fileSize);
+    void *mapped = mmap(nullptr, size, PROT_READ, MAP_SHARED, this->file, 0);
+    if (mapped == MAP_FAILED) {
+        return false;
+    }
+    this->mapping = static_cast<char *> (mapped);
+    this->mappedSize = size;
+    return true;
+}
+
+void ResultStore::unmap() {
+    if (this->mapping != nullptr) {
+        munmap(this->mapping, this->mappedSize);
+        this->mapping = nullptr;
+        this->mappedSize = 0;
+    }
+}
+
+size_t ResultStore::indexRecords(size_t offset) {
+    while (this->fileSize - offset >= sizeof (RecordHeader)) {
+        RecordHeader header;
+        std::memcpy(&header, this->mapping + offset, sizeof (header));
+        size_t recordSize = sizeof (header) + header.keyLength + header.valueLength;
+        if (this->fileSize - offset < recordSize) {
+            break;
+        }
+        this->index.emplace(header.hash, offset);
+        offset += recordSize;
+    }
+    return offset;
+}
+
+bool ResultStore::open(const std::string &path) {
+    this->file = ::open(path.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (this->file < 0) {
+        return false;
+    }
+
+    // the header is written and an incomplete record is cut off while no other
+    // process appends or opens the file, see add()
+    struct stat status;
+    if (flock(this->file, LOCK_EX) != 0 || fstat(this->file, &status) != 0) {
+        this->close();
+        return false;
+    }
+    this->fileSize = status.st_size;
+    if (this->fileSize == 0) {
+        char header[headerSize];
+        std::memcpy(header, magic, sizeof (magic));
+        std::memcpy(header + sizeof (magic), &version, sizeof (version));
+        if (write(this->file, header, headerSize) != static_cast<ssize_t> (headerSize)) {
+            this->close();
+            return false;
+        }
+        this->fileSize = headerSize;
+    }
+
+    if (this->fileSize < headerSize || !this->map()
+            || std::memcmp(this->mapping, magic, sizeof (magic)) != 0
+            || std::memcmp(this->mapping + sizeof (magic), &version, sizeof (version)) != 0) {
+        this->close();
+        return false;
+    }
+
+    this->indexedSize = this->indexRecords(headerSize);
+    if (this->indexedSize < this->fileSize && ftruncate(this->file, this->indexedSize) == 0) {
+        // the last record is incomplete
+        this->fileSize = this->indexedSize;
+    }
+    flock(this->file, LOCK_UN);
+    return true;
+}
+
+bool ResultStore::isOpen() const {
+    return this->file >= 0;
+}
+
+std::string ResultStore::key(const std::string &expression, const std::string &variable, const std::string &options) {
+    std::string key = ParseCache::normalize(expression);
+    key += '\n';
+    key += variable;
+    key += '\n';
+    key += options;
+    return key;
+}
+
+const char *ResultStore::find(const std::string &key, size_t &size) {
+    if (!this->isOpen()) {
+        return nullptr;
+    }
+    auto range = this->index.equal_range(hashOf(key));
+    const char *found = nullptr;
+    size_t foundOffset = 0;
+    for (auto record = range.first; record != range.second; ++record) {
+        RecordHeader header;
+        std::memcpy(&header, this->mapping + record->second, sizeof (header));
+        const char *recordKey = this->mapping + record->second + sizeof (header);
+        // the first record of the key wins
+        if (header.keyLength == key.size() && std::memcmp(recordKey, key.data(), key.size()) == 0
+                && (found == nullptr || record->second < foundOffset)) {
+            found = recordKey + header.keyLength;
+            foundOffset = record->second;
+            size = header.valueLength;
+        }
+    }
+    return found;
+}
+
+bool ResultStore::add(const std::string &key, const std::string &value) {
+    if (!this->isOpen()) {
+        return false;
+    }
+
+    RecordHeader header = {static_cast<std::uint32_t> (key.size()), static_cast<std::uint32_t> (value.size()), hashOf(key)};
+    std::string record(reinterpret_cast<const char *> (&header), sizeof (header));
+    record += key;
+    record += value;
+    // one write, so the record is not interleaved with records of other processes.
+    // The shared lock lets them append at the same time, but not cut off the record 
+    // in open() before it is complete
+    if (flock(this->file, LOCK_SH) != 0) {
+        return false;
+    }
+    bool isWritten = write(this->file, record.data(), record.size()) == static_cast<ssize_t> (record.size());
+    flock(this->file, LOCK_UN);
+    if (!isWritten) {
+        return false;
+    }
+
+    // other processes may have appended records too, they are indexed as well
+    struct stat status;
+    if (fstat(this->file, &status) != 0) {
+        return false;
+    }
+    this->fileSize = status.st_size;
+    if (!this->map()) {
+        this->close();
+        return false;
+    }
+    this->indexedSize = this->indexRecords(this->indexedSize);
+    return true;
+}
+
+size_t ResultStore::size() const {
+    return this->index.size();
+}
@@ -0,0 +1,110 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file ResultStore.h
+ *
+ * Definition of the persistent store of derivatives.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#ifndef RESULTSTORE_H
+#define RESULTSTORE_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+
+/**
+ * Append-only file of results (serialized derivatives) mapped into memory.
+ *
+ * The file starts with "AGRS" and the version, followed by records:
+ *
+ *     uint32 key length, uint32 value length, uint64 hash of the key, key, value
+ *
+ * in the native byte order, the file is a local cache and is not portable
+ * between architectures. The index (hash of the key -> record) is built in
+ * memory when the file is opened, by a scan over the headers of records.
+ * An incomplete record at the end (e.g. the process was killed while
+ * appending) is cut off.
+ *
+ * Values are returned as pointers to the mapped pages, the same key can be
+ * added several times, the first record wins. Records are appended by one
+ * write each, so several processes can share the file. The file is locked
+ * (flock()) exclusively while it is created or repaired by open() and shared
+ * while a record is appended. The mapping is larger than the file, it is 
+ * replaced only when the file outgrows it.
+ */
+class ResultStore {
+private:
+    int file;
+    char *mapping;
+    size_t mappedSize;
+    size_t fileSize;
+    size_t indexedSize; // end of the last indexed record
+    std::unordered_multimap<std::uint64_t, size_t> index; // offsets of records
+
+    bool map();
+    void unmap();
+
+    /**
+     * Index the records of the mapped file from the given offset.
+     *
+     * @return End of the last complete record.
+     */
+    size_t indexRecords(size_t offset);
+
+public:
+    ResultStore();
+    ~ResultStore();
+
+    ResultStore(const ResultStore &) = delete;
+    ResultStore &operator=(const ResultStore &) = delete;
+
+    /**
+     * Open the store, the file is created if it does not exist.
+     *
+     * @param path Path of the file.
+     * @return false if the file can not be opened or mapped, or if it is not
+     * a store of results.
+     */
+    bool open(const std::string &path);
+
+    bool isOpen() const;
+
+    void close();
+
+    /**
+     * The key of a derivative: the normalized expression (see ParseCache), the
+     * variable and the options which change the result.
+     */
+    static std::string key(const std::string &expression, const std::string &variable, const std::string &options);
+
+    /**
+     * Find the value of the key.
+     *
+     * @param key The key.
+     * @param size Size of the value if found.
+     * @return The value in the mapped file, nullptr if the key is not stored.
+     * The pointer is valid until the next call of find() or add().
+     */
+    const char *find(const std::string &key, size_t &size);
+
+    /**
+     * Append the record to the file.
+     *
+     * @return false if the record could not be written.
+     */
+    bool add(const std::string &key, const std::string &value);
+
+    /**
+     * @return Number of records.
+     */
+    size_t size() const;
+};
+
+#endif /* RESULTSTORE_H */
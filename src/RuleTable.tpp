@@ -0,0 +1,152 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file RuleTable.tpp
+ *
+ * Definition of the RuleTable template and of the rule tables used by Optimizer.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#ifndef RULETABLE_H
+#define RULETABLE_H
+
+#include <vector>
+#include <chrono>
+
+#include <Expression.h>
+#include <TraverseException.h>
+
+#include "OptimizerStatistics.h"
+#include "SumConstantsRule.h"
+#include "SumWithNullArgumentRule.h"
+#include "SumIdenticalExpressionsRule.h"
+#include "SumWithNegativeRule.h"
+#include "MultConstantsRule.h"
+#include "MultIdenticalExpressionsRule.h"
+#include "MultQuotientsRule.h"
+#include "MultNumeratorDenominatorRule.h"
+#include "MultWithNumeratorRule.h"
+#include "PowConstantRule.h"
+#include "PowOfPowRule.h"
+
+/**
+ * Apply the rule and record the attempt if the statistics is requested.
+ *
+ * @param rule The rule to be applied.
+ * @param name Name of the rule for the statistics.
+ * @param statistics Where the attempt is recorded, can be nullptr.
+ * @return Result of rule.apply().
+ */
+template <typename Rule>
+bool applyRule(Rule &rule, const char *name, OptimizerStatistics *statistics) throw (TraverseException) {
+    if (statistics == nullptr) {
+        return rule.apply();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    bool hit = rule.apply();
+    statistics->record(name, hit, std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start));
+    return hit;
+}
+
+/**
+ * Compile-time collection of OptimizationRule's for the expression of type PT.
+ *
+ * Every rule provides its name by the static method name() and a cheap necessary 
+ * condition of its applicability by the static method mayApply().
+ *
+ * The set of rules is fixed by the template arguments, therefore nothing has to
+ * be allocated to apply it: every rule is instantiated on the stack right before
+ * it is applied and the calls are resolved statically (the rules are final).
+ * Rules are applied in the order of template arguments.
+ *
+ * @param PT Pointer type of the expression (PSum, PMult etc).
+ * @param Rules Implementations of OptimizationRule<PT>.
+ */
+template <typename PT, typename... Rules>
+struct RuleTable;
+
+template <typename PT>
+struct RuleTable<PT> {
+
+    static bool applyFirst(const PT &, PExpression &, OptimizerStatistics * = nullptr) throw (TraverseException) {
+        return false;
+    }
+
+    static void applyAll(const PT &, std::vector<PExpression> &) throw (TraverseException) {
+    }
+};
+
+template <typename PT, typename Rule, typename... Rules>
+struct RuleTable<PT, Rule, Rules...> {
+
+    /**
+     * Apply rules one by one until the first of them succeeds. Rules whose 
+     * mayApply() fails are skipped without being instantiated.
+     *
+     * @param expr Expression to be optimized.
+     * @param result [out] The optimized expression, if one of rules has been applied.
+     * @param statistics Where attempts are recorded, can be nullptr.
+     * @return true if one of rules has been applied.
+     */
+    static bool applyFirst(const PT &expr, PExpression &result, OptimizerStatistics *statistics = nullptr) throw (TraverseException) {
+        if (Rule::mayApply(expr)) {
+            Rule rule(expr);
+            if (applyRule(rule, Rule::name(), statistics)) {
+                result = rule.getOptimizedExpression();
+                return true;
+            }
+        }
+        return RuleTable<PT, Rules...>::applyFirst(expr, result, statistics);
+    }
+
+    /**
+     * Apply all rules to the expression.
+     *
+     * @param expr Expression to be optimized.
+     * @param results [out] Results of all applicable rules.
+     */
+    static void applyAll(const PT &expr, std::vector<PExpression> &results) throw (TraverseException) {
+        if (Rule::mayApply(expr)) {
+            Rule rule(expr);
+            if (rule.apply()) {
+                results.push_back(rule.getOptimizedExpression());
+            }
+        }
+        RuleTable<PT, Rules...>::applyAll(expr, results);
+    }
+};
+
+/**
+ * Optimization rules for summation expression.
+ *
+ * @TODO think about trygonometric rules: (sin(x))^2+(cos(x)^2)
+ */
+typedef RuleTable<PSum,
+        SumConstantsRule,
+        SumWithNullArgumentRule,
+        SumIdenticalExpressionsRule,
+        SumWithNegativeRule> SummationRules;
+
+/**
+ * Optimization rules for multiplication expression.
+ */
+typedef RuleTable<PMult,
+        MultConstantsRule,
+        MultIdenticalExpressionsRule,
+        MultQuotientsRule,
+        MultNumeratorDenominatorRule,
+        MultWithNumeratorRule> MultiplicationRules;
+
+/**
+ * Optimization rules for exponentiation expression.
+ */
+typedef RuleTable<PPow,
+        PowConstantRule,
+        PowOfPowRule> ExponentiationRules;
+
+#endif /* RULETABLE_H */
@@ -18,13 +18,18 @@
 #include <Expression.h>
 #include <Parser.h>
 #include <Parser.h>
+#include <Rebalancer.h>
+#include <FlatExpression.h>
+#include <Serialization.h>
 
 #include "Differentiator.h"
 #include "Optimizer.h"
+#include "EGraphOptimizer.h"
+#include "SolverServer.h"
 
 using namespace std;
 
-SolverApplication::SolverApplication() {
+SolverApplication::SolverApplication() : useEGraph(false), printStatistics(false), rebalanceDerivative(false), pool(nullptr), precision(2), batch(false), letBindings(false), syntaxOnly(false) {
 }
 
 SolverApplication::~SolverApplication() {
@@ -38,19 +43,212 @@ void SolverApplication::setStrVariable(const string strVariable) {
     this->strVariable = strVariable;
 }
 
+void SolverApplication::setEGraphOptimization(const bool useEGraph) {
+    this->useEGraph = useEGraph;
+}
+
+void SolverApplication::setPrintStatistics(const bool printStatistics) {
+    this->printStatistics = printStatistics;
+}
+
+void SolverApplication::setRebalanceDerivative(const bool rebalanceDerivative) {
+    this->rebalanceDerivative = rebalanceDerivative;
+}
+
+void SolverApplication::setParallel(const bool parallel) {
+    this->pool = parallel ? &ThreadPool::shared() : nullptr;
+}
+
+void SolverApplication::setPrecision(const int precision) {
+    this->precision = precision;
+}
+
+void SolverApplication::setBatch(const bool batch) {
+    this->batch = batch;
+}
+
+void SolverApplication::setLetBindings(const bool letBindings) {
+    this->letBindings = letBindings;
+}
+
+void SolverApplication::setResultStore(const string storePath) {
+    this->resultStorePath = storePath;
+}
+
+void SolverApplication::setServe(const string socketPath) {
+    this->socketPath = socketPath;
+}
+
+void SolverApplication::setCheckSyntax(const bool checkSyntax) {
+    this->syntaxOnly = checkSyntax;
+}
+
+void SolverApplication::setResourceLimits(const ResourceLimits limits) {
+    this->limits = limits;
+}
+
+PExpression SolverApplication::simplify(PExpression expr) {
+    if (this->useEGraph) {
+        return optimizeEGraph(expr);
+    }
+    return optimize(expr,
+            this->printStatistics ? &this->statistics : nullptr,
+            this->pool);
+}
+
 int SolverApplication::run() {
     int returnCode=0;
-    try {
-        PExpression optimized=optimize(differentiate(optimize(parse(this->strExpression)), this->strVariable));
+    if (!this->socketPath.empty()) {
+        SolverServer::Options options;
+        options.useEGraph=this->useEGraph;
+        options.rebalanceDerivative=this->rebalanceDerivative;
+        options.letBindings=this->letBindings;
+        options.precision=this->precision;
+        options.limits=this->limits;
+        SolverServer server(options);
+        cerr << "Listening on " << this->socketPath << endl;
+        if (!server.serve(this->socketPath)) {
+            cerr << "WARNING: The socket " << this->socketPath << " can not be created." << endl;
+            return 1;
+        }
+        return 0;
+    }
+    if (this->syntaxOnly) {
+        bool isValid=true;
+        if (this->batch) {
+            string line;
+            while (getline(cin, line)) {
+                if (line.find_first_not_of(" \t\r") != string::npos) {
+                    isValid=this->printSyntaxCheck(line) && isValid;
+                }
+            }
+        } else {
+            isValid=this->printSyntaxCheck(this->strExpression);
+        }
+        cout.flush();
+        return isValid ? 0 : 1;
+    }
+    if (!this->resultStorePath.empty() && !this->resultStore.open(this->resultStorePath)) {
+        cerr << "WARNING: The result store " << this->resultStorePath << " can not be opened." << endl;
+    }
+    
+    if (this->batch) {
+        returnCode=this->runBatch(cin);
+        this->finish();
+        return returnCode;
+    }
+    
+    Expected<PExpression> result=this->solve(this->strExpression);
+    if (!result) {
+        cout << "ERROR: " << result.getFailure().message;
+        return 1;
+    }
+    this->printResult(result.getValue());
+    cout << endl;
+    this->finish();
+    
+    return returnCode;
+}
 
-        cout << to_string(optimized) << endl;
-    } catch (ParsingException ex) {
-        cout << "ERROR: " << ex.what();
-        returnCode=1;
+Expected<PExpression> SolverApplication::solve(const string &strExpression) {
+    string key;
+    if (this->resultStore.isOpen()) {
+        // only these options change the derivative
+        key=ResultStore::key(strExpression, this->strVariable, string(this->useEGraph ? "e" : "") + (this->rebalanceDerivative ? "r" : ""));
+        size_t size=0;
+        const char *stored=this->resultStore.find(key, size);
+        if (stored != nullptr) {
+            try {
+                return deserialize(stored, size);
+            } catch (ParsingException ex) {
+                // damaged record, the derivative is calculated again
+            }
+        }
+    }
+    
+    // malformed input is common in batches, it is rejected without exceptions
+    Expected<PExpression> parsed=this->parseCache.tryParse(strExpression);
+    if (!parsed) {
+        return parsed;
+    }
+    PExpression result;
+    // the parser is not budgeted, see ResourceBudget
+    ResourceBudget budget(this->limits);
+    BudgetScope scope(this->limits.isUnlimited() ? nullptr : &budget);
+    try {
+        PExpression derivative=differentiate(simplify(rebalance(parsed.getValue())), this->strVariable, this->pool);
+        if (this->rebalanceDerivative) {
+            derivative=rebalance(derivative);
+        }
+        result=simplify(derivative);
+    } catch (BudgetExceededException ex) {
+        return Failure{Failure::Budget, ex.what()};
     } catch (TraverseException ex) {
-        cout << "ERROR: " << ex.what();
-        returnCode=1;
+        return Failure{Failure::Traverse, ex.what()};
     }
     
+    if (this->resultStore.isOpen()) {
+        this->resultStore.add(key, serialize(*result));
+    }
+    return result;
+}
+
+void SolverApplication::printResult(const PExpression &result) {
+    if (this->letBindings) {
+        printLet(cout, flattenShared(*result), this->precision);
+    } else {
+        print(cout, result, this->precision);
+    }
+}
+
+namespace {
+
+/**
+ * Messages may contain the debug context on next lines, a batch keeps one line per expression.
+ */
+string firstLine(const string &message) {
+    return message.substr(0, message.find('\n'));
+}
+
+}
+
+int SolverApplication::runBatch(istream &in) {
+    int returnCode=0;
+    string line;
+    while (getline(in, line)) {
+        if (line.find_first_not_of(" \t\r") == string::npos) {
+            continue;
+        }
+        Expected<PExpression> result=this->solve(line);
+        if (result) {
+            this->printResult(result.getValue());
+            cout << '\n';
+        } else {
+            cout << "ERROR: " << firstLine(result.getFailure().message) << '\n';
+            returnCode=1;
+        }
+    }
+    cout.flush();
     return returnCode;
 }
+
+bool SolverApplication::printSyntaxCheck(const string &strExpression) {
+    SyntaxCheck result=checkSyntax(strExpression);
+    if (result.isValid) {
+        cout << "OK\n";
+    } else {
+        cout << "ERROR: " << result.reason << " Position: " << result.position << '\n';
+    }
+    return result.isValid;
+}
+
+void SolverApplication::finish() {
+    if (this->printStatistics) {
+        this->statistics.print(cerr);
+        if (this->batch) {
+            CacheStatistics parsed=this->parseCache.getStatistics();
+            cerr << endl << "parse cache: " << parsed.hits << " hits, " << parsed.misses << " misses, "
+                    << parsed.evictions << " evictions, hit rate " << static_cast<int> (parsed.hitRate() * 100.0 + 0.5) << "%" << endl;
+        }
+    }
+}
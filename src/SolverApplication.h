@@ -14,6 +14,15 @@
 #define SOLVERAPPLICATION_H
 
 #include <string>
+#include <istream>
+#include <Expected.h>
+#include <Expression.h>
+#include <ParseCache.h>
+#include <ResourceBudget.h>
+
+#include "OptimizerStatistics.h"
+#include "ResultStore.h"
+#include "ThreadPool.h"
 
 using namespace std;
 
@@ -31,9 +40,115 @@ public:
 
     void setStrVariable(const string strVariable);
 
+    /**
+     * Use the equality saturation (optimizeEGraph()) instead of greedy Optimizer.
+     */
+    void setEGraphOptimization(const bool useEGraph);
+
+    /**
+     * Print the statistics of optimization rules to stderr after the result.
+     */
+    void setPrintStatistics(const bool printStatistics);
+
+    /**
+     * Rebalance long sums and products of the derivative (see rebalance())
+     * before it is simplified. The parsed expression is always rebalanced.
+     */
+    void setRebalanceDerivative(const bool rebalanceDerivative);
+
+    /**
+     * Differentiate and simplify large expressions by all cores (see ThreadPool::shared()).
+     */
+    void setParallel(const bool parallel);
+
+    /**
+     * Number of significant digits of constants in the result (2 by default).
+     */
+    void setPrecision(const int precision);
+
+    /**
+     * Read expressions from the standard input, one per line, and print their
+     * derivatives (or errors) line by line. The expression given by 
+     * setStrExpression() is ignored.
+     */
+    void setBatch(const bool batch);
+
+    /**
+     * Print subexpressions used more than once as temporaries, e.g. 
+     * "t1 = cos(x); result = t1*t1".
+     */
+    void setLetBindings(const bool letBindings);
+
+    /**
+     * Take derivatives of already seen inputs from the store file and add 
+     * the new ones to it.
+     *
+     * @param storePath Path of the file, see ResultStore.
+     */
+    void setResultStore(const string storePath);
+
+    /**
+     * Serve requests of clients connected to the Unix socket instead of 
+     * solving one expression, see SolverServer. The options of the 
+     * application are the defaults of requests.
+     *
+     * @param socketPath Path of the socket.
+     */
+    void setServe(const string socketPath);
+
+    /**
+     * Only check the syntax of expressions (see checkSyntax()), print "OK" or
+     * the reason and the offset of the first error. No variable is needed.
+     */
+    void setCheckSyntax(const bool checkSyntax);
+
+    /**
+     * Limits of the differentiation and simplification of each expression 
+     * (see ResourceBudget), an expression which exceeds them is reported as 
+     * an error. Unlimited by default.
+     */
+    void setResourceLimits(const ResourceLimits limits);
+
 private:
     string strExpression;
     string strVariable;
+    bool useEGraph;
+    bool printStatistics;
+    OptimizerStatistics statistics;
+    bool rebalanceDerivative;
+    ThreadPool *pool;
+    int precision;
+    bool batch;
+    bool letBindings;
+    ResultStore resultStore;
+    ParseCache parseCache;
+    string resultStorePath;
+    string socketPath;
+    bool syntaxOnly;
+    ResourceLimits limits;
+    
+    PExpression simplify(PExpression expr);
+    
+    /**
+     * Differentiate and simplify the expression.
+     */
+    Expected<PExpression> solve(const string &strExpression);
+    
+    int runBatch(istream &in);
+
+    /**
+     * Print the result of checkSyntax() as one line.
+     *
+     * @return true if the expression is valid.
+     */
+    bool printSyntaxCheck(const string &strExpression);
+
+    void printResult(const PExpression &result);
+    
+    /**
+     * Print statistics, if requested.
+     */
+    void finish();
 };
 
 #endif /* SOLVERAPPLICATION_H */
@@ -0,0 +1,507 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file SolverServer.cpp
+ *
+ * Implementation of the long-running solver serving clients over a Unix socket.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#include "SolverServer.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <list>
+#include <sstream>
+#include <thread>
+
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <FlatExpression.h>
+#include <Rebalancer.h>
+
+#include "Differentiator.h"
+#include "Optimizer.h"
+#include "EGraphOptimizer.h"
+#include "ResultStore.h"
+
+namespace {
+
+std::vector<std::string> split(const std::string &text, char separator) {
+    std::vector<std::string> fields;
+    size_t start = 0;
+    size_t end;
+    while ((end = text.find(separator, start)) != std::string::npos) {
+        fields.push_back(text.substr(start, end - start));
+        start = end + 1;
+    }
+    fields.push_back(text.substr(start));
+    return fields;
+}
+
+/**
+ * @return false if the text is not a non-negative integer which fits the limit.
+ */
+template <typename T>
+bool parseLimit(const std::string &text, T &limit) {
+    if (text.empty() || text.find_first_not_of("0123456789") != std::string::npos) {
+        return false;
+    }
+    errno = 0;
+    unsigned long long value = std::strtoull(text.c_str(), nullptr, 10);
+    if (errno == ERANGE || value != static_cast<T> (value)) {
+        return false;
+    }
+    limit = static_cast<T> (value);
+    return true;
+}
+
+/**
+ * @return Empty string or the error message if an option is not known.
+ */
+std::string parseOptions(const std::string &text, SolverServer::Options &options) {
+    for (const std::string &option : split(text, ' ')) {
+        if (option.empty()) {
+            continue;
+        } else if (option == "egraph") {
+            options.useEGraph = true;
+        } else if (option == "rebalance-derivative") {
+            options.rebalanceDerivative = true;
+        } else if (option == "let") {
+            options.letBindings = true;
+        } else if (option.compare(0, 10, "precision=") == 0) {
+            const char *end = option.c_str() + option.size();
+            double precision = 0.0;
+            if (parseNumber(option.c_str() + 10, end, precision) != end
+                    || precision < 1 || precision > maxNumberPrecision || precision != static_cast<int> (precision)) {
+                return "Precision must be an integer from 1 to " + std::to_string(maxNumberPrecision) + ".";
+            }
+            options.precision = static_cast<int> (precision);
+        } else if (option.compare(0, 10, "max-nodes=") == 0) {
+            if (!parseLimit(option.substr(10), options.limits.maxNodes)) {
+                return "The limit of nodes must be a non-negative integer.";
+            }
+        } else if (option.compare(0, 11, "max-passes=") == 0) {
+            if (!parseLimit(option.substr(11), options.limits.maxPasses)) {
+                return "The limit of passes must be a non-negative integer.";
+            }
+        } else if (option.compare(0, 8, "timeout=") == 0) {
+            if (!parseLimit(option.substr(8), options.limits.maxMilliseconds)) {
+                return "The timeout must be a non-negative integer of milliseconds.";
+            }
+        } else {
+            return "Unknown option " + option + ".";
+        }
+    }
+    return "";
+}
+
+std::string error(const std::string &message) {
+    // the answer is one line, the debug context on the next lines is dropped
+    return "ERROR: " + message.substr(0, message.find('\n'));
+}
+
+/**
+ * The loop of SolverServer::serve() must not wait for a single client.
+ */
+bool setNonBlocking(int descriptor) {
+    int flags = fcntl(descriptor, F_GETFL, 0);
+    return flags >= 0 && fcntl(descriptor, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+}
+
+/**
+ * A line of a client, answered by a worker.
+ */
+struct SolverServer::Request {
+    const std::string line;
+    // guarded by answersMutex
+    std::string answer;
+    bool isAnswered = false;
+
+    explicit Request(const std::string &line) : line(line) {
+    }
+};
+
+/**
+ * Caches and the queue of requests of the workers which share the trees.
+ */
+struct SolverServer::Shard {
+    ParseCache parseCache;
+    std::mutex derivativesMutex;
+    LruCache<std::string, PExpression> derivatives;
+
+    std::mutex queueMutex;
+    std::condition_variable queued;
+    std::deque<std::shared_ptr<Request>> queue;
+    bool isClosed = false; // the workers leave when the queue is empty
+
+    explicit Shard(size_t capacity) : parseCache(capacity), derivatives(capacity) {
+    }
+};
+
+/**
+ * A connected client, used only by the thread of serve().
+ */
+struct SolverServer::Connection {
+    int socket;
+    std::string input; // the last line, it may be incomplete yet
+    std::deque<std::shared_ptr<Request>> requests; // in the order of lines, answered or not
+    std::string output; // answers which are not sent yet
+    bool isReading = true;
+
+    explicit Connection(int socket) : socket(socket) {
+    }
+};
+
+const size_t SolverServer::defaultCacheCapacity;
+const size_t SolverServer::maxPendingRequests;
+
+SolverServer::SolverServer(const Options &defaults, unsigned int workers, size_t cacheCapacity) :
+defaults(defaults),
+workers(workers > 0 ? workers : std::max(1u, std::thread::hardware_concurrency())),
+isStopped(false) {
+    // trees may be shared by the workers only with the thread-safe reference counting
+    size_t shardCount = isSPointerThreadSafe ? 1 : this->workers;
+    for (size_t n = 0; n < shardCount; n++) {
+        this->shards.push_back(std::unique_ptr<Shard>(new Shard(std::max<size_t>(1, cacheCapacity / shardCount))));
+    }
+    if (pipe(this->wakeUpPipe) != 0) {
+        this->wakeUpPipe[0] = this->wakeUpPipe[1] = -1;
+    } else {
+        // a full pipe means a pending wake up already
+        setNonBlocking(this->wakeUpPipe[0]);
+        setNonBlocking(this->wakeUpPipe[1]);
+    }
+}
+
+SolverServer::~SolverServer() {
+    if (this->wakeUpPipe[0] >= 0) {
+        close(this->wakeUpPipe[0]);
+        close(this->wakeUpPipe[1]);
+    }
+}
+
+SolverServer::Shard &SolverServer::shardOf(const std::string &request) {
+    if (this->shards.size() == 1) {
+        return *this->shards.front();
+    }
+    // the same expression goes always to the same worker
+    std::string expression = ParseCache::normalize(request.substr(0, request.find('\t')));
+    return *this->shards[std::hash<std::string>()(expression) % this->shards.size()];
+}
+
+Expected<PExpression> SolverServer::solve(Shard &shard, const std::string &expression, const std::string &variable, const Options &options) {
+    std::string key = ResultStore::key(expression, variable,
+            std::string(options.useEGraph ? "e" : "") + (options.rebalanceDerivative ? "r" : ""));
+    {
+        std::lock_guard<std::mutex> lock(shard.derivativesMutex);
+        const PExpression *found = shard.derivatives.find(key);
+        if (found != nullptr) {
+            return *found;
+        }
+    }
+
+    auto simplify = [&options](PExpression expr) {
+        return options.useEGraph ? optimizeEGraph(expr) : optimize(expr);
+    };
+    Expected<PExpression> parsed = shard.parseCache.tryParse(expression);
+    if (!parsed) {
+        return parsed;
+    }
+    PExpression result;
+    // always budgeted, stop() cancels the running requests
+    ResourceBudget budget(options.limits, &this->cancellation);
+    BudgetScope scope(&budget);
+    try {
+        PExpression derivative = differentiate(simplify(rebalance(parsed.getValue())), variable);
+        if (options.rebalanceDerivative) {
+            derivative = rebalance(derivative);
+        }
+        result = simplify(derivative);
+    } catch (BudgetExceededException ex) {
+        return Failure{Failure::Budget, ex.what()};
+    } catch (TraverseException ex) {
+        return Failure{Failure::Traverse, ex.what()};
+    }
+
+    std::lock_guard<std::mutex> lock(shard.derivativesMutex);
+    shard.derivatives.put(key, result);
+    return result;
+}
+
+std::string SolverServer::answer(const std::string &request) {
+    return this->answer(this->shardOf(request), request);
+}
+
+std::string SolverServer::answer(Shard &shard, const std::string &request) {
+    std::vector<std::string> fields = split(request, '\t');
+    if (fields.size() < 2 || fields.size() > 3) {
+        return error("The request must be: expression TAB variable [TAB options].");
+    }
+    Options options = this->defaults;
+    if (fields.size() == 3) {
+        std::string message = parseOptions(fields[2], options);
+        if (!message.empty()) {
+            return error(message);
+        }
+    }
+
+    Expected<PExpression> result = this->solve(shard, fields[0], fields[1], options);
+    if (!result) {
+        return error(result.getFailure().message);
+    }
+    std::ostringstream out;
+    if (options.letBindings) {
+        printLet(out, flattenShared(*result.getValue()), options.precision);
+    } else {
+        print(out, result.getValue(), options.precision);
+    }
+    return out.str();
+}
+
+void SolverServer::wakeUp() {
+    char signal = 0;
+    while (write(this->wakeUpPipe[1], &signal, 1) < 0 && errno == EINTR) {
+    }
+}
+
+void SolverServer::work(Shard &shard) {
+    while (true) {
+        std::shared_ptr<Request> request;
+        {
+            std::unique_lock<std::mutex> lock(shard.queueMutex);
+            shard.queued.wait(lock, [&shard]() {
+                return shard.isClosed || !shard.queue.empty();
+            });
+            if (shard.queue.empty()) {
+                return;
+            }
+            request = shard.queue.front();
+            shard.queue.pop_front();
+        }
+        std::string answer;
+        try {
+            answer = this->answer(shard, request->line);
+        } catch (const std::exception &ex) {
+            answer = error(ex.what());
+        }
+        {
+            std::lock_guard<std::mutex> lock(this->answersMutex);
+            request->answer = answer;
+            request->isAnswered = true;
+        }
+        this->wakeUp();
+    }
+}
+
+void SolverServer::receive(Connection &connection, std::vector<char> &buffer) {
+    ssize_t count = read(connection.socket, buffer.data(), buffer.size());
+    if (count < 0 && (errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK)) {
+        return;
+    }
+    if (count <= 0) {
+        // the requests sent so far are still answered
+        connection.isReading = false;
+        return;
+    }
+    connection.input.append(buffer.data(), count);
+
+    // dispatch all complete requests, the last line may be incomplete yet
+    size_t start = 0;
+    size_t end;
+    while ((end = connection.input.find('\n', start)) != std::string::npos) {
+        std::string line = connection.input.substr(start, end - start);
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (!line.empty()) {
+            std::shared_ptr<Request> request = std::make_shared<Request>(line);
+            connection.requests.push_back(request);
+            Shard &shard = this->shardOf(line);
+            {
+                std::lock_guard<std::mutex> lock(shard.queueMutex);
+                shard.queue.push_back(request);
+            }
+            shard.queued.notify_one();
+        }
+        start = end + 1;
+    }
+    connection.input.erase(0, start);
+}
+
+bool SolverServer::flush(Connection &connection) {
+    {
+        // the answers go out in the order of the requests
+        std::lock_guard<std::mutex> lock(this->answersMutex);
+        while (!connection.requests.empty() && connection.requests.front()->isAnswered) {
+            connection.output += connection.requests.front()->answer;
+            connection.output += '\n';
+            connection.requests.pop_front();
+        }
+    }
+    if (connection.output.empty()) {
+        return true;
+    }
+    // no SIGPIPE if the client has gone
+    ssize_t count = send(connection.socket, connection.output.data(), connection.output.size(), MSG_NOSIGNAL);
+    if (count < 0) {
+        return errno == EINTR || errno == EAGAIN || errno == EWOULDBLOCK;
+    }
+    connection.output.erase(0, count);
+    return true;
+}
+
+void SolverServer::dispatch(int listener) {
+    std::list<Connection> connections;
+    std::vector<pollfd> polled;
+    std::vector<char> buffer(1 << 16);
+    bool isListening = true;
+    while (true) {
+        if (this->isStopped && isListening) {
+            isListening = false;
+            for (Connection &connection : connections) {
+                connection.isReading = false;
+            }
+        }
+        for (auto connection = connections.begin(); connection != connections.end();) {
+            bool isSent = this->flush(*connection);
+            if (!isSent || (!connection->isReading && connection->requests.empty() && connection->output.empty())) {
+                close(connection->socket);
+                connection = connections.erase(connection);
+            } else {
+                ++connection;
+            }
+        }
+        if (!isListening && connections.empty()) {
+            return;
+        }
+
+        polled.clear();
+        polled.push_back(pollfd{this->wakeUpPipe[0], POLLIN, 0});
+        if (isListening) {
+            polled.push_back(pollfd{listener, POLLIN, 0});
+        }
+        for (Connection &connection : connections) {
+            short events = 0;
+            if (connection.isReading && connection.requests.size() < maxPendingRequests) {
+                events |= POLLIN;
+            }
+            if (!connection.output.empty()) {
+                events |= POLLOUT;
+            }
+            polled.push_back(pollfd{connection.socket, events, 0});
+        }
+        if (poll(polled.data(), polled.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+
+        if (polled[0].revents != 0) {
+            while (read(this->wakeUpPipe[0], buffer.data(), buffer.size()) > 0) {
+            }
+        }
+        // the connections accepted now are polled the next time
+        auto event = polled.begin() + (isListening ? 2 : 1);
+        for (auto connection = connections.begin(); event != polled.end(); ++connection, ++event) {
+            if ((event->revents & (POLLERR | POLLHUP)) != 0 && (event->revents & POLLIN) == 0) {
+                // the client has gone, nobody reads the answers
+                connection->isReading = false;
+                connection->requests.clear();
+                connection->output.clear();
+            } else if ((event->revents & POLLIN) != 0) {
+                this->receive(*connection, buffer);
+            }
+        }
+        if (isListening && polled[1].revents != 0) {
+            int client;
+            while ((client = accept(listener, nullptr, nullptr)) >= 0) {
+                setNonBlocking(client);
+                connections.emplace_back(client);
+            }
+        }
+    }
+
+    for (Connection &connection : connections) {
+        close(connection.socket);
+    }
+}
+
+bool SolverServer::serve(const std::string &socketPath) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof (address));
+    address.sun_family = AF_UNIX;
+    if (socketPath.size() >= sizeof (address.sun_path) || this->wakeUpPipe[0] < 0) {
+        return false;
+    }
+    std::strcpy(address.sun_path, socketPath.c_str());
+
+    int socket = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (socket < 0) {
+        return false;
+    }
+    unlink(socketPath.c_str());
+    if (bind(socket, reinterpret_cast<sockaddr *> (&address), sizeof (address)) != 0 || listen(socket, SOMAXCONN) != 0
+            || !setNonBlocking(socket)) {
+        close(socket);
+        return false;
+    }
+
+    std::vector<std::thread> threads;
+    unsigned int workersPerShard = this->workers / this->shards.size();
+    for (std::unique_ptr<Shard> &shard : this->shards) {
+        for (unsigned int n = 0; n < workersPerShard; n++) {
+            threads.emplace_back(&SolverServer::work, this, std::ref(*shard));
+        }
+    }
+    this->dispatch(socket);
+    for (std::unique_ptr<Shard> &shard : this->shards) {
+        {
+            std::lock_guard<std::mutex> lock(shard->queueMutex);
+            shard->isClosed = true;
+        }
+        shard->queued.notify_all();
+    }
+    for (std::thread &thread : threads) {
+        thread.join();
+    }
+
+    close(socket);
+    unlink(socketPath.c_str());
+    return true;
+}
+
+void SolverServer::stop() {
+    this->isStopped = true;
+    this->cancellation.cancel();
+    // wakes up the loop waiting in poll()
+    this->wakeUp();
+}
+
+CacheStatistics SolverServer::getStatistics() {
+    CacheStatistics statistics;
+    for (std::unique_ptr<Shard> &shard : this->shards) {
+        std::lock_guard<std::mutex> lock(shard->derivativesMutex);
+        CacheStatistics counters = shard->derivatives.getStatistics();
+        statistics.hits += counters.hits;
+        statistics.misses += counters.misses;
+        statistics.evictions += counters.evictions;
+    }
+    return statistics;
+}
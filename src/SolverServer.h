@@ -0,0 +1,144 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file SolverServer.h
+ *
+ * Definition of the long-running solver serving clients over a Unix socket.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#ifndef SOLVERSERVER_H
+#define SOLVERSERVER_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <Expected.h>
+#include <Expression.h>
+#include <LruCache.h>
+#include <Numbers.h>
+#include <ParseCache.h>
+#include <ResourceBudget.h>
+
+/**
+ * Answers requests of clients connected to a Unix domain socket.
+ *
+ * The protocol is line based. A request is a line
+ *
+ *     expression TAB variable [TAB options]
+ *
+ * where the options are separated by spaces: "egraph", "rebalance-derivative",
+ * "let", "precision=N" and the limits of the request (see ResourceBudget)
+ * "max-nodes=N", "max-passes=N", "timeout=MS". Every non-empty line is answered by one line, the
+ * derivative or "ERROR: message". Requests can be pipelined, the answers come
+ * in the same order.
+ *
+ * One thread polls the socket and all connections, it reads the lines and
+ * dispatches every request to a fixed number of worker threads, so idle
+ * connections cost no worker. Parsed expressions and derivatives are cached.
+ * With the non-atomic reference counting (see isSPointerThreadSafe) trees must
+ * not pass between threads, then every worker has its own caches and the
+ * requests are distributed by their expressions; otherwise the caches are
+ * shared by all workers. The names of variables are kept in SymbolTable::global()
+ * while cached or pending expressions contain them. Once the table is full, the
+ * names of other requests are evicted, so new names are refused only if the
+ * live expressions alone exhaust it.
+ */
+class SolverServer {
+public:
+
+    struct Options {
+        bool useEGraph = false;
+        bool rebalanceDerivative = false;
+        bool letBindings = false;
+        int precision = defaultNumberPrecision;
+        ResourceLimits limits;
+    };
+
+    static const size_t defaultCacheCapacity = 4096;
+
+    /**
+     * Number of requests of one client which may wait for their answers, the
+     * client is not read until some of them are answered.
+     */
+    static const size_t maxPendingRequests = 64;
+
+private:
+    struct Request;
+    struct Shard;
+    struct Connection;
+
+    const Options defaults;
+    const unsigned int workers;
+
+    std::vector<std::unique_ptr<Shard>> shards;
+    std::mutex answersMutex; // of the answers of all requests
+
+    std::atomic<bool> isStopped;
+    CancellationToken cancellation; // of all requests, by stop()
+    int wakeUpPipe[2]; // written by the workers and stop(), polled by serve()
+
+    Shard &shardOf(const std::string &request);
+
+    Expected<PExpression> solve(Shard &shard, const std::string &expression, const std::string &variable, const Options &options);
+    std::string answer(Shard &shard, const std::string &request);
+
+    void wakeUp();
+    void work(Shard &shard);
+    void dispatch(int listener);
+    void receive(Connection &connection, std::vector<char> &buffer);
+    bool flush(Connection &connection);
+
+public:
+    /**
+     * @param defaults Options of requests which do not specify them.
+     * @param workers Number of requests answered at once, 0 stands for the
+     * number of cores.
+     * @param cacheCapacity Number of cached parsed expressions and derivatives,
+     * it is split between the workers if they do not share the caches.
+     */
+    explicit SolverServer(const Options &defaults, unsigned int workers = 0, size_t cacheCapacity = defaultCacheCapacity);
+
+    ~SolverServer();
+
+    SolverServer(const SolverServer &) = delete;
+    SolverServer &operator=(const SolverServer &) = delete;
+
+    /**
+     * Answer one request. It can be called by several threads at once if
+     * isSPointerThreadSafe, otherwise not while serve() runs.
+     *
+     * @param request The line of the request without the line break.
+     * @return The line of the answer without the line break.
+     */
+    std::string answer(const std::string &request);
+
+    /**
+     * Listen on the socket and serve clients until stop() is called.
+     *
+     * @param socketPath Path of the socket, an existing file is replaced.
+     * @return false if the socket can not be created.
+     */
+    bool serve(const std::string &socketPath);
+
+    /**
+     * Stop accepting clients and disconnect the connected ones after the
+     * requests they have sent are answered, serve() returns then. Requests 
+     * which are not cached are cancelled, they are answered by errors.
+     */
+    void stop();
+
+    /**
+     * @return Counters of the caches of derivatives.
+     */
+    CacheStatistics getStatistics();
+};
+
+#endif /* SOLVERSERVER_H */
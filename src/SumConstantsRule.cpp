@@ -24,6 +24,14 @@
 SumConstantsRule::SumConstantsRule(PSum _expression) : OptimizationRule(_expression) {
 }
 
+const char *SumConstantsRule::name() {
+    return "SumConstantsRule";
+}
+
+bool SumConstantsRule::mayApply(const PSum &expr) {
+    return expr->lArg->getType() == EConstant && expr->rArg->getType() == EConstant;
+}
+
 bool SumConstantsRule::apply() throw (TraverseException) {
     // constant and constand - perform summation and return constant
     if (isTypeOf<Constant>(this->expression->lArg) && isTypeOf<Constant>(this->expression->rArg)) {
@@ -27,6 +27,9 @@ public:
     SumConstantsRule(PSum _expression);
 
     bool apply() throw(TraverseException) final;
+
+    static const char *name();
+    static bool mayApply(const PSum &expr);
 };
 
 #endif /* SUMCONSTANTSRULE_H */
@@ -21,19 +21,59 @@
 #include <Constant.h>
 #include <Variable.h>
 #include <ExpressionFactory.h>
+#include <StructuralEquality.h>
 #include "ExceptionThrower.h"
 
 SumIdenticalExpressionsRule::SumIdenticalExpressionsRule(PSum _expression) : OptimizationRule(_expression) {
 }
 
+const char *SumIdenticalExpressionsRule::name() {
+    return "SumIdenticalExpressionsRule";
+}
+
+bool SumIdenticalExpressionsRule::mayApply(const PSum &expr) {
+    return expr->lArg->getType() == EMult || expr->rArg->getType() == EMult || expr->lArg->getType() == expr->rArg->getType();
+}
+
+/**
+ * Represent the summation term as multiplication of a constant coefficient and
+ * a factor, without creating new expressions.
+ * 
+ * @param term The summation term.
+ * @param coefficient [out] The constant coefficient (1 if the term is not a multiplication).
+ * @param factor [out] The remaining factor.
+ * @return false if the term is a multiplication without constant arguments.
+ */
+static bool splitTerm(const PExpression &term, double &coefficient, const PExpression *&factor){
+    if(term->getType() != EMult){
+        coefficient = 1.0;
+        factor = &term;
+        return true;
+    }
+    
+    const Mult &mult = static_cast<const Mult &>(*term);
+    if(mult.rArg->getType() == EConstant){
+        coefficient = static_cast<const Constant &>(*mult.rArg).value;
+        factor = &mult.lArg;
+        return true;
+    }
+    if(mult.lArg->getType() == EConstant){
+        coefficient = static_cast<const Constant &>(*mult.lArg).value;
+        factor = &mult.rArg;
+        return true;
+    }
+    // multiplication does not contain constant
+    return false;
+}
+
 bool SumIdenticalExpressionsRule::apply() throw(TraverseException) {
     // is it appliable?
     // criteria:
     // - both left and right summation arguments contain equal expressions
     // - both left and right summation arguments complemented by constants
     
-    if(!isTypeOf<Mult>(this->expression->lArg) && !isTypeOf<Mult>(this->expression->rArg)){
-        if(equals(this->expression->lArg, this->expression->rArg)){
+    if(this->expression->lArg->getType() != EMult && this->expression->rArg->getType() != EMult){
+        if(structurallyEqual(*this->expression->lArg, *this->expression->rArg)){
             // summation terms are the same
             this->optimizedExpression=createMult(createConstant(2.0), this->expression->lArg);
             return true;
@@ -42,51 +82,21 @@ bool SumIdenticalExpressionsRule::apply() throw(TraverseException) {
         return false;
     }
     
-    // at least one term is multiplication - try to express both terms as Mult
-    
-    PMult sumTerm1;
-    if(isTypeOf<Mult>(this->expression->lArg)){
-        PMult temp=SPointerCast<Mult>(this->expression->lArg);
-        if(!isTypeOf<Constant>(temp->lArg) && !isTypeOf<Constant>(temp->rArg)){
-            // one multiplication does not contain constant - nothing to do
-            return false;
-        }else if(isTypeOf<Constant>(temp->rArg)){
-            // right argument is constant - swap arguments
-            sumTerm1=createMult(temp->rArg,temp->lArg);
-        }else{
-            sumTerm1=temp;
-        }
-    }else{
-        sumTerm1=createMult(createConstant(1.0),this->expression->lArg);
-    }
+    // at least one term is multiplication - try to express both terms as 
+    // multiplication with a constant
     
-    PMult sumTerm2;
-    if(isTypeOf<Mult>(this->expression->rArg)){
-        PMult temp=SPointerCast<Mult>(this->expression->rArg);
-        if(!isTypeOf<Constant>(temp->lArg) && !isTypeOf<Constant>(temp->rArg)){
-            return false;
-        }else if(isTypeOf<Constant>(temp->rArg)){
-            sumTerm2=createMult(temp->rArg,temp->lArg);
-        }else{
-            sumTerm2=temp;
-        }
-    }else{
-        sumTerm2=createMult(createConstant(1.0),this->expression->rArg);
+    double val1, val2;
+    const PExpression *factor1, *factor2;
+    if(!splitTerm(this->expression->lArg, val1, factor1) || !splitTerm(this->expression->rArg, val2, factor2)){
+        return false;
     }
     
-    // allright, now both sumation terms are represented as Multiplication with 
-    // a constant as left arg
-    
-    if(!equals(sumTerm1->rArg, sumTerm2->rArg)){
+    if(!structurallyEqual(**factor1, **factor2)){
         // rule does not appliable because there are no common factor
         return false;
     }
     
     // calculate sum of quotients of common factor
-    double val1 = SPointerCast<Constant>(sumTerm1->lArg)->value;
-    double val2 = SPointerCast<Constant>(sumTerm2->lArg)->value;
-    this->optimizedExpression=createMult(createConstant(val1 + val2), sumTerm1->rArg);
+    this->optimizedExpression=createMult(createConstant(val1 + val2), *factor1);
     return true;
 }
-
-
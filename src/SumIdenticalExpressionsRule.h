@@ -29,6 +29,9 @@ class SumIdenticalExpressionsRule : public OptimizationRule<PSum> {
 public:
     SumIdenticalExpressionsRule(PSum _expression);
     bool apply() throw(TraverseException) final;
+
+    static const char *name();
+    static bool mayApply(const PSum &expr);
 };
 
 #endif /* SUMIDENTICALEXPRESSIONS_H */
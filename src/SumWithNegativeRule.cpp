@@ -20,6 +20,14 @@ SumWithNegativeRule::SumWithNegativeRule(PSum _expression) : OptimizationRule(_e
 
 }
 
+const char *SumWithNegativeRule::name() {
+    return "SumWithNegativeRule";
+}
+
+bool SumWithNegativeRule::mayApply(const PSum &expr) {
+    return expr->lArg->getType() == EMult || expr->rArg->getType() == EMult;
+}
+
 bool ifMultIsANegation(PMult mult, std::function<bool(PExpression)> returnSub) {
     bool isLConst = isTypeOf<Constant>(mult->lArg);
     bool isRConst = isTypeOf<Constant>(mult->rArg);
@@ -30,6 +30,9 @@ class SumWithNegativeRule : public OptimizationRule<PSum>{
 public:
     SumWithNegativeRule(PSum _expression);
     bool apply() throw(TraverseException) final;
+
+    static const char *name();
+    static bool mayApply(const PSum &expr);
 };
 
 #endif /* SUMWITHNEGATIVERULE_H */
@@ -21,6 +21,14 @@
 SumWithNullArgumentRule::SumWithNullArgumentRule(PSum _expression) : OptimizationRule(_expression) {
 }
 
+const char *SumWithNullArgumentRule::name() {
+    return "SumWithNullArgumentRule";
+}
+
+bool SumWithNullArgumentRule::mayApply(const PSum &expr) {
+    return expr->lArg->getType() == EConstant || expr->rArg->getType() == EConstant;
+}
+
 bool SumWithNullArgumentRule::apply()  throw(TraverseException) {
     if(isTypeOf<Constant>(this->expression->lArg) && equal(SPointerCast<Constant>(this->expression->lArg)->value, 0.0)){
         this->optimizedExpression=this->expression->rArg;
@@ -23,6 +23,9 @@ class SumWithNullArgumentRule : public OptimizationRule<PSum> {
 public:
     SumWithNullArgumentRule(PSum _expression);
     bool apply() throw(TraverseException) final;
+
+    static const char *name();
+    static bool mayApply(const PSum &expr);
 };
 
 #endif /* SUMWITHNULLARGUMENTRULE_H */
@@ -0,0 +1,129 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file ThreadPool.cpp
+ *
+ * Implementation of ThreadPool.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#include "ThreadPool.h"
+
+#include <atomic>
+#include <exception>
+
+/**
+ * Tasks of one call of run().
+ */
+struct ThreadPool::Batch {
+    const std::vector<std::function<void()>> &tasks; // valid until all tasks are done
+    const size_t count;
+    std::atomic<size_t> next; // index of the next unclaimed task
+    std::vector<std::exception_ptr> errors;
+
+    std::mutex mutex;
+    std::condition_variable finished;
+    size_t done; // guarded by mutex
+
+    Batch(const std::vector<std::function<void()>> &tasks) : tasks(tasks), count(tasks.size()), next(0), errors(tasks.size()), done(0) {
+    }
+};
+
+ThreadPool::ThreadPool(unsigned int threads) : isStopped(false) {
+    if (threads == 0) {
+        threads = std::thread::hardware_concurrency();
+    }
+    for (unsigned int i = 1; i < threads; i++) {
+        this->workers.emplace_back(&ThreadPool::work, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        this->isStopped = true;
+    }
+    this->wakeUp.notify_all();
+    for (std::thread &worker : this->workers) {
+        worker.join();
+    }
+}
+
+unsigned int ThreadPool::size() const {
+    return this->workers.size() + 1;
+}
+
+void ThreadPool::runTasks(Batch &batch) {
+    for (size_t index = batch.next++; index < batch.count; index = batch.next++) {
+        try {
+            batch.tasks[index]();
+        } catch (...) {
+            batch.errors[index] = std::current_exception();
+        }
+
+        std::lock_guard<std::mutex> lock(batch.mutex);
+        if (++batch.done == batch.count) {
+            batch.finished.notify_all();
+        }
+    }
+}
+
+void ThreadPool::work() {
+    for (;;) {
+        std::shared_ptr<Batch> batch;
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            this->wakeUp.wait(lock, [this] {
+                return this->isStopped || !this->queue.empty();
+            });
+            if (this->isStopped) {
+                return;
+            }
+            batch = this->queue.front();
+            if (batch->next >= batch->count) {
+                // all tasks are claimed, the rest is up to their executors
+                this->queue.pop_front();
+                continue;
+            }
+        }
+        runTasks(*batch);
+    }
+}
+
+void ThreadPool::run(const std::vector<std::function<void()>> &tasks) {
+    if (tasks.empty()) {
+        return;
+    }
+
+    std::shared_ptr<Batch> batch = std::make_shared<Batch>(tasks);
+    if (!this->workers.empty() && tasks.size() > 1) {
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->queue.push_back(batch);
+        }
+        this->wakeUp.notify_all();
+    }
+
+    runTasks(*batch);
+    {
+        std::unique_lock<std::mutex> lock(batch->mutex);
+        batch->finished.wait(lock, [&batch] {
+            return batch->done == batch->count;
+        });
+    }
+
+    for (const std::exception_ptr &error : batch->errors) {
+        if (error != nullptr) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+ThreadPool &ThreadPool::shared() {
+    static ThreadPool pool;
+    return pool;
+}
@@ -0,0 +1,92 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file ThreadPool.h
+ *
+ * Definition of ThreadPool.
+ *
+ * @author agor
+ * @since 18.10.2026
+ */
+
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+
+/**
+ * Default number of nodes of an expression, below which it is not worth to be
+ * split into parallel tasks (see traverseParallel()).
+ */
+const size_t defaultGrainSize = 2048;
+
+/**
+ * Fixed set of worker threads which execute batches of tasks in the fork-join
+ * manner: run() distributes the tasks and returns when all of them are done.
+ *
+ * The calling thread executes tasks of its batch as well, therefore a task may
+ * call run() again (nested fork-join) without the risk of a deadlock, even if
+ * all workers are busy.
+ */
+class ThreadPool {
+private:
+    struct Batch;
+
+    std::vector<std::thread> workers;
+    std::deque<std::shared_ptr<Batch>> queue; // batches which have unclaimed tasks
+    std::mutex mutex;
+    std::condition_variable wakeUp;
+    bool isStopped;
+
+    void work();
+
+    /**
+     * Execute unclaimed tasks of the batch until there are none.
+     */
+    static void runTasks(Batch &batch);
+
+public:
+    /**
+     * @param threads Number of threads including the calling one, i.e.
+     * threads - 1 workers are started. 0 stands for the number of cores.
+     */
+    explicit ThreadPool(unsigned int threads = 0);
+
+    ThreadPool(const ThreadPool &) = delete;
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    /**
+     * Stop and join the workers.
+     */
+    virtual ~ThreadPool();
+
+    /**
+     * @return Number of threads which execute tasks, including the calling one.
+     */
+    unsigned int size() const;
+
+    /**
+     * Execute all tasks and wait until they are done.
+     *
+     * If some tasks throw, the others are still executed and the exception of
+     * the first failed task (in order of the vector) is rethrown here.
+     *
+     * @param tasks The tasks, they are executed in arbitrary order.
+     */
+    void run(const std::vector<std::function<void()>> &tasks);
+
+    /**
+     * @return The pool with one thread per core, shared by the whole application.
+     */
+    static ThreadPool &shared();
+};
+
+#endif /* THREADPOOL_H */
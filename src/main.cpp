@@ -12,7 +12,10 @@
  * \author agor
  */
 
+#include <cstdlib>
+#include <iostream>
 #include <string>
+#include <vector>
 #include "SolverApplication.h"
 
 /*
@@ -20,10 +23,65 @@
  */
 int main(int argc, char** argv) {
     SolverApplication app;
+    bool checkSyntax = false;
+    ResourceLimits limits;
 
-    if (argc == 3) {
-        app.setStrExpression(std::string(argv[1]));
-        app.setStrVariable(std::string(argv[2]));
+    // options are prefixed with "--", the rest are expression and variable;
+    // arguments after "--" are never options (e.g. the expression "--x")
+    std::vector<std::string> arguments;
+    bool isOptionsEnd = false;
+    for (int i = 1; i < argc; i++) {
+        std::string argument(argv[i]);
+        if (isOptionsEnd) {
+            arguments.push_back(argument);
+        } else if (argument == "--") {
+            isOptionsEnd = true;
+        } else if (argument == "--egraph") {
+            app.setEGraphOptimization(true);
+        } else if (argument == "--stats") {
+            app.setPrintStatistics(true);
+        } else if (argument == "--batch") {
+            app.setBatch(true);
+        } else if (argument == "--check") {
+            app.setCheckSyntax(true);
+            checkSyntax = true;
+        } else if (argument == "--let") {
+            app.setLetBindings(true);
+        } else if (argument == "--parallel") {
+            app.setParallel(true);
+        } else if (argument == "--rebalance-derivative") {
+            app.setRebalanceDerivative(true);
+        } else if (argument.compare(0, 8, "--store=") == 0) {
+            app.setResultStore(argument.substr(8));
+        } else if (argument.compare(0, 8, "--serve=") == 0) {
+            app.setServe(argument.substr(8));
+        } else if (argument.compare(0, 12, "--precision=") == 0) {
+            app.setPrecision(std::atoi(argument.c_str() + 12));
+        } else if (argument.compare(0, 12, "--max-nodes=") == 0) {
+            limits.maxNodes = std::strtoul(argument.c_str() + 12, nullptr, 10);
+        } else if (argument.compare(0, 13, "--max-passes=") == 0) {
+            limits.maxPasses = std::strtoul(argument.c_str() + 13, nullptr, 10);
+        } else if (argument.compare(0, 10, "--timeout=") == 0) {
+            limits.maxMilliseconds = std::strtoul(argument.c_str() + 10, nullptr, 10);
+        } else if (argument.compare(0, 2, "--") == 0) {
+            // a mistyped option must not become the expression or the variable
+            std::cerr << "WARNING: Unknown option " << argument << "." << std::endl;
+            std::cerr << "Usage: DerivativeSolver [options] expression variable" << std::endl;
+            return 1;
+        } else {
+            arguments.push_back(argument);
+        }
+    }
+    app.setResourceLimits(limits);
+
+    if (arguments.size() == 2) {
+        app.setStrExpression(arguments[0]);
+        app.setStrVariable(arguments[1]);
+    } else if (arguments.size() == 1 && checkSyntax) {
+        app.setStrExpression(arguments[0]);
+    } else if (arguments.size() == 1) {
+        // batch mode: expressions are read from the standard input
+        app.setStrVariable(arguments[0]);
     }
 
     return app.run();
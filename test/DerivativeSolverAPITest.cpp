@@ -0,0 +1,208 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file DerivativeSolverAPITest.cpp
+ *
+ * Tests for the C interface of the derivativesolver library.
+ *
+ * @since 18.10.2026
+ * @author agor
+ */
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "DerivativeSolverAPI.h"
+#include "SymbolTable.h"
+
+namespace {
+
+ds_expression *parseText(const char *text) {
+    ds_expression *expr = nullptr;
+    EXPECT_EQ(DS_OK, ds_parse(text, std::strlen(text), &expr));
+    return expr;
+}
+
+std::string printText(const ds_expression *expr) {
+    char buffer[256];
+    EXPECT_EQ(DS_OK, ds_print(expr, 2, buffer, sizeof (buffer), nullptr));
+    return buffer;
+}
+
+}
+
+TEST(DerivativeSolverAPI, differentiate_ParsedText_OptimizedDerivative) {
+    ds_expression *expr = parseText("x^2 + sin(x)");
+    ds_expression *derivative = nullptr;
+    ASSERT_EQ(DS_OK, ds_differentiate(expr, "x", &derivative));
+    ds_expression *optimized = nullptr;
+    ASSERT_EQ(DS_OK, ds_optimize(derivative, 0, &optimized));
+    ASSERT_EQ("(2*x)+cos(x)", printText(optimized));
+
+    ds_expression *saturated = nullptr;
+    ASSERT_EQ(DS_OK, ds_optimize(derivative, DS_OPTIMIZE_EGRAPH, &saturated));
+    ASSERT_EQ("(2*x)+cos(x)", printText(saturated));
+
+    // handles are independent of each other
+    ds_release(expr);
+    ds_release(derivative);
+    ASSERT_EQ("(2*x)+cos(x)", printText(optimized));
+    ds_release(optimized);
+    ds_release(saturated);
+}
+
+TEST(DerivativeSolverAPI, checkSyntax_Texts_PositionOfFirstError) {
+    size_t position = 1;
+    ASSERT_EQ(DS_OK, ds_check_syntax("x^2 + 1", 7, &position));
+    ASSERT_EQ(0u, position);
+    ASSERT_EQ(DS_PARSING_ERROR, ds_check_syntax("x + (y", 6, &position));
+    ASSERT_EQ(4u, position);
+    ASSERT_STREQ("No closing bracket has been found.", ds_last_error());
+
+    // an operand or argument is missing at the end
+    for (const char *text : {"x+", "x/", "x^", "sin"}) {
+        ASSERT_EQ(DS_PARSING_ERROR, ds_check_syntax(text, std::strlen(text), &position)) << text;
+        ASSERT_EQ(std::strlen(text), position) << text;
+        ASSERT_STREQ("The expression is incomplete. An operand or argument is missing.", ds_last_error()) << text;
+    }
+}
+
+TEST(DerivativeSolverAPI, checkSyntax_RandomTexts_AcceptedTextsAreSolved) {
+    const char *pieces[] = {"x", "y", "2", "0.5", " ", "(", ")", "+", "-", "*", "/", "^", "sin", "ln", "exp"};
+    std::mt19937 random(49);
+    for (int testId = 0; testId < 5000; testId++) {
+        std::string text;
+        int length = random() % 9;
+        for (int i = 0; i < length; i++) {
+            text += pieces[random() % (sizeof (pieces) / sizeof (pieces[0]))];
+        }
+        ds_expression *expr = nullptr;
+        ds_status parsed = ds_parse(text.data(), text.size(), &expr);
+        ASSERT_EQ(parsed, ds_check_syntax(text.data(), text.size(), nullptr)) << "'" << text << "'";
+        if (parsed != DS_OK) {
+            continue;
+        }
+        // the accepted trees are consistent for the differentiator and the optimizer
+        ds_expression *derivative = nullptr;
+        ASSERT_EQ(DS_OK, ds_differentiate(expr, "x", &derivative)) << "'" << text << "' " << ds_last_error();
+        ds_expression *optimized = nullptr;
+        ds_status status = ds_optimize(derivative, 0, &optimized);
+        // only the arithmetic may fail, e.g. a division by zero
+        ASSERT_EQ(nullptr, std::strstr(ds_last_error(), "not consistent")) << "'" << text << "' " << ds_last_error();
+        ASSERT_TRUE(status == DS_OK || status == DS_TRAVERSE_ERROR) << "'" << text << "'";
+        ds_release(expr);
+        ds_release(derivative);
+        ds_release(optimized);
+    }
+}
+
+TEST(DerivativeSolverAPI, evaluate_Values_ValueOfExpression) {
+    ds_expression *expr = parseText("x*y + z");
+    const char *names[] = {"x", "y"};
+    double values[] = {2.0, 3.5};
+    double result = 0.0;
+    ASSERT_EQ(DS_OK, ds_evaluate(expr, names, values, 2, &result));
+    ASSERT_TRUE(std::isnan(result));
+
+    const char *allNames[] = {"x", "y", "z"};
+    double allValues[] = {2.0, 3.5, 1.0};
+    ASSERT_EQ(DS_OK, ds_evaluate(expr, allNames, allValues, 3, &result));
+    ASSERT_DOUBLE_EQ(8.0, result);
+
+    // names which do not occur in any expression are not kept
+    const char *otherNames[] = {"x", "y", "z", "notInExpression"};
+    double otherValues[] = {2.0, 3.5, 1.0, 7.0};
+    ASSERT_EQ(DS_OK, ds_evaluate(expr, otherNames, otherValues, 4, &result));
+    ASSERT_DOUBLE_EQ(8.0, result);
+    ASSERT_EQ(SymbolTable::none, SymbolTable::global().find("notInExpression"));
+    ds_release(expr);
+}
+
+TEST(DerivativeSolverAPI, print_SmallBuffer_CutTextAndRequiredSize) {
+    ds_expression *expr = parseText("sin(x)");
+    char buffer[4];
+    size_t required = 0;
+    ASSERT_EQ(DS_BUFFER_TOO_SMALL, ds_print(expr, 2, buffer, sizeof (buffer), &required));
+    ASSERT_EQ(7u, required);
+    ASSERT_STREQ("sin", buffer);
+    ASSERT_STRNE("", ds_last_error());
+
+    ASSERT_EQ(DS_BUFFER_TOO_SMALL, ds_print(expr, 2, nullptr, 0, &required));
+    ASSERT_EQ(7u, required);
+    std::vector<char> exact(required);
+    ASSERT_EQ(DS_OK, ds_print(expr, 2, exact.data(), exact.size(), &required));
+    ASSERT_STREQ("sin(x)", exact.data());
+    ASSERT_STREQ("", ds_last_error());
+    ds_release(expr);
+}
+
+TEST(DerivativeSolverAPI, serialize_Expression_SameAfterDeserialization) {
+    ds_expression *expr = parseText("ln(x)/(x + 2.5)");
+    size_t required = 0;
+    ASSERT_EQ(DS_BUFFER_TOO_SMALL, ds_serialize(expr, nullptr, 0, &required));
+    std::vector<char> data(required);
+    ASSERT_EQ(DS_OK, ds_serialize(expr, data.data(), data.size(), &required));
+    ASSERT_EQ(data.size(), required);
+
+    ds_expression *restored = nullptr;
+    ASSERT_EQ(DS_OK, ds_deserialize(data.data(), data.size(), &restored));
+    ASSERT_EQ(printText(expr), printText(restored));
+    ds_release(expr);
+    ds_release(restored);
+}
+
+TEST(DerivativeSolverAPI, errors_StatusAndMessage) {
+    ds_expression *expr = nullptr;
+    ASSERT_EQ(DS_PARSING_ERROR, ds_parse("x^(3+)", 6, &expr));
+    ASSERT_EQ(nullptr, expr);
+    ASSERT_NE(nullptr, std::strstr(ds_last_error(), "incomplete"));
+
+    ASSERT_EQ(DS_PARSING_ERROR, ds_deserialize("AGEX", 4, &expr));
+
+    expr = parseText("x/0");
+    ds_expression *derivative = nullptr;
+    ASSERT_EQ(DS_TRAVERSE_ERROR, ds_optimize(expr, 0, &derivative));
+    ASSERT_EQ(nullptr, derivative);
+    ASSERT_NE(nullptr, std::strstr(ds_last_error(), "Division by zero."));
+
+    ASSERT_EQ(DS_INVALID_ARGUMENT, ds_differentiate(expr, nullptr, &derivative));
+    ASSERT_EQ(DS_INVALID_ARGUMENT, ds_optimize(expr, 8, &derivative));
+    ASSERT_EQ(DS_INVALID_ARGUMENT, ds_print(expr, 0, nullptr, 0, nullptr));
+    ds_release(expr);
+    ds_release(nullptr);
+
+    // std::length_error of the text, no exception passes the interface
+    expr = nullptr;
+    ASSERT_EQ(DS_INTERNAL_ERROR, ds_parse("x", SIZE_MAX, &expr));
+    ASSERT_EQ(nullptr, expr);
+    ASSERT_STRNE("", ds_last_error());
+}
+
+TEST(DerivativeSolverAPI, setLimits_ExceededByCall_BudgetExceeded) {
+    ds_expression *expr = parseText("sin(x)^3");
+    ds_expression *result = nullptr;
+    ds_set_limits(5, 0, 0);
+    ASSERT_EQ(DS_BUDGET_EXCEEDED, ds_differentiate(expr, "x", &result));
+    ASSERT_EQ(nullptr, result);
+    ASSERT_NE(nullptr, std::strstr(ds_last_error(), "limit of nodes"));
+
+    // each call has its own budget
+    ds_set_limits(0, 20, 0);
+    ASSERT_EQ(DS_OK, ds_optimize(expr, 0, &result));
+    ds_release(result);
+    ASSERT_EQ(DS_OK, ds_optimize(expr, 0, &result));
+    ds_release(result);
+
+    ds_set_limits(0, 0, 0);
+    ASSERT_EQ(DS_OK, ds_differentiate(expr, "x", &result));
+    ds_release(result);
+    ds_release(expr);
+}
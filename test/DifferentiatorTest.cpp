@@ -22,6 +22,9 @@
 #include "Div.h"
 
 #include "ExpressionFactory.h"
+#include "Rebalancer.h"
+#include "StructuralEquality.h"
+#include "ResourceBudget.h"
 
 class FX_Differentiator : public testing::Test {
 protected:
@@ -466,4 +469,90 @@ TEST_F(FX_Differentiator, visit_ExponentWithoutArgument_TraverseException) {
 TEST_F(FX_Differentiator, differentiate_NullExpression_TraverseException) {
     PExpression nullExpr;
     ASSERT_THROW(differentiate(nullExpr, "x"), TraverseException);
-}
\ No newline at end of file
+}
+TEST_F(FX_Differentiator, differentiate_VeryDeepExpression_NoStackOverflow) {
+    // x+x+...+x is parsed into a left-deep chain
+    PExpression expr = createVariable("x");
+    for (int i = 0; i < 200000; i++) {
+        expr = createSum(expr, createVariable("x"));
+    }
+    
+    PExpression difExpr;
+    ASSERT_NO_THROW(difExpr = differentiate(expr, "x"));
+    
+    int depth = 0;
+    while (isTypeOf<Sum>(difExpr)) {
+        ASSERT_TRUE(isTypeOf<Constant>(SPointerCast<Sum>(difExpr)->rArg));
+        difExpr = SPointerCast<Sum>(difExpr)->lArg;
+        depth++;
+    }
+    ASSERT_EQ(200000, depth);
+}
+
+TEST_F(FX_Differentiator, differentiate_Parallel_SameAsSequential) {
+    PExpression expr = createVariable("x");
+    for (int i = 1; i < 2000; i++) {
+        expr = createSum(expr, createMult(createSin(createMult(createConstant(i), createVariable("x"))), createVariable("y")));
+    }
+    expr = rebalance(expr);
+    ThreadPool pool(4);
+    
+    PExpression sequential = differentiate(expr, "x");
+    PExpression parallel = differentiate(expr, "x", &pool, 64);
+    
+    ASSERT_TRUE(structurallyEqual(*sequential, *parallel));
+    ASSERT_EQ(to_string(sequential), to_string(parallel));
+}
+
+TEST_F(FX_Differentiator, differentiate_ParallelIncompleteExpression_TraverseException) {
+    PExpression expr = createVariable("x");
+    for (int i = 1; i < 2000; i++) {
+        expr = createSum(expr, createMult(createVariable("x"), i == 1000 ? nullptr : createVariable("x")));
+    }
+    expr = rebalance(expr);
+    ThreadPool pool(4);
+    
+    ASSERT_THROW(differentiate(expr, "x", &pool, 64), TraverseException);
+}
+
+TEST_F(FX_Differentiator, tryDifferentiate_IncompleteExpression_Failure) {
+    Expected<PExpression> result = tryDifferentiate(createSum(createVariable("x"), createConstant(1.0)), "x");
+    ASSERT_TRUE(result.hasValue());
+    ASSERT_EQ("1+0", to_string(result.getValue()));
+
+    result = tryDifferentiate(createMult(createVariable("x"), nullptr), "x");
+    ASSERT_FALSE(result);
+    ASSERT_EQ(Failure::Traverse, result.getFailure().kind);
+    ASSERT_FALSE(tryDifferentiate(nullptr, "x"));
+}
+
+TEST_F(FX_Differentiator, differentiate_ParallelWithBudget_NodesOfAllThreadsCharged) {
+    PExpression expr = createVariable("x");
+    for (int i = 1; i < 2000; i++) {
+        expr = createSum(expr, createMult(createConstant(i), createSin(createVariable("x"))));
+    }
+    expr = rebalance(expr);
+    ThreadPool pool(4);
+    
+    ResourceBudget sequential((ResourceLimits()));
+    {
+        BudgetScope scope(&sequential);
+        differentiate(expr, "x");
+    }
+    ResourceBudget parallel((ResourceLimits()));
+    {
+        BudgetScope scope(&parallel);
+        differentiate(expr, "x", &pool, 64);
+    }
+    ASSERT_LT(0u, sequential.getNodes());
+    ASSERT_EQ(sequential.getNodes(), parallel.getNodes());
+    
+    ResourceLimits limits;
+    limits.maxNodes = sequential.getNodes() - 1;
+    ResourceBudget limited(limits);
+    BudgetScope scope(&limited);
+    ASSERT_THROW(differentiate(expr, "x", &pool, 64), BudgetExceededException);
+    Expected<PExpression> result = tryDifferentiate(expr, "x");
+    ASSERT_FALSE(result);
+    ASSERT_EQ(Failure::Budget, result.getFailure().kind);
+}
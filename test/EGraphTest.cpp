@@ -0,0 +1,150 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file EGraphTest.cpp
+ *
+ * Tests for EGraph and optimizeEGraph().
+ *
+ * @since 18.10.2026
+ * @author agor
+ */
+
+#include <gtest/gtest.h>
+
+#include "EGraph.h"
+#include "EGraphOptimizer.h"
+#include "Optimizer.h"
+#include "ExpressionFactory.h"
+#include "ResourceBudget.h"
+
+class FX_EGraph : public testing::Test {
+protected:
+
+    virtual void SetUp() {
+    }
+
+    virtual void TearDown() {
+    }
+};
+
+TEST_F(FX_EGraph, add_IdenticalSubexpressions_SameClass) {
+    EGraph graph;
+    EClassId sum = graph.add(createSum(createSin(createVariable("x")), createSin(createVariable("x"))));
+
+    ASSERT_EQ(1u, graph.nodes(sum).size());
+    const ENode &node = graph.nodes(sum)[0];
+    ASSERT_EQ(node.args[0], node.args[1]);
+    // x, sin(x) and the sum
+    ASSERT_EQ(3u, graph.size());
+}
+
+TEST_F(FX_EGraph, rebuild_EqualArguments_CongruentClassesMerged) {
+    EGraph graph;
+    EClassId sinA = graph.add(createSin(createVariable("a")));
+    EClassId sinB = graph.add(createSin(createVariable("b")));
+    ASSERT_NE(graph.find(sinA), graph.find(sinB));
+
+    graph.merge(graph.add(createVariable("a")), graph.add(createVariable("b")));
+    graph.rebuild();
+
+    ASSERT_EQ(graph.find(sinA), graph.find(sinB));
+}
+
+TEST_F(FX_EGraph, extract_EquivalentForms_SmallestExtracted) {
+    EGraph graph;
+    EClassId mult = graph.add(createMult(createVariable("x"), createConstant(1.0)));
+    EClassId var = graph.add(createVariable("x"));
+    graph.merge(mult, var);
+    graph.rebuild();
+
+    PExpression extracted = graph.extract(mult);
+    ASSERT_TRUE(equals(createVariable("x"), extracted)) << to_string(extracted);
+}
+
+TEST_F(FX_EGraph, optimizeEGraph_SimplifiableCases_Simplified) {
+    std::vector<PExpression> tests;
+    std::vector<PExpression> expResults;
+
+    // x*1+0 => x
+    tests.push_back(createSum(createMult(createVariable("x"), createConstant(1.0)), createConstant(0.0)));
+    expResults.push_back(createVariable("x"));
+
+    // (2+3)*x - x => 4*x
+    tests.push_back(createSub(createMult(createSum(createConstant(2.0), createConstant(3.0)), createVariable("x")), createVariable("x")));
+    expResults.push_back(createMult(createConstant(4.0), createVariable("x")));
+
+    // ln(exp(x^1)) => x
+    tests.push_back(createLn(createExp(createPow(createVariable("x"), createConstant(1.0)))));
+    expResults.push_back(createVariable("x"));
+
+    // sin(0)*x + cos(x) => cos(x)
+    tests.push_back(createSum(createMult(createSin(createConstant(0.0)), createVariable("x")), createCos(createVariable("x"))));
+    expResults.push_back(createCos(createVariable("x")));
+
+    for (unsigned int testId = 0; testId < tests.size(); testId++) {
+        PExpression actResult;
+        EXPECT_NO_THROW(actResult = optimizeEGraph(tests[testId])) << "Test ID=" << testId << " threw an exception!";
+        EXPECT_TRUE(equals(expResults[testId], actResult)) <<
+                "Result does not match for test ID=" << testId << "! "
+                << to_string(expResults[testId]) << " != " << to_string(actResult);
+    }
+}
+
+TEST_F(FX_EGraph, optimizeEGraph_NoIterationsAllowed_GreedyResultExtracted) {
+    PExpression expr = createSum(createMult(createVariable("x"), createConstant(1.0)), createConstant(0.0));
+    EGraphLimits limits;
+    limits.maxIterations = 0;
+
+    ASSERT_TRUE(equals(createVariable("x"), optimizeEGraph(expr, limits)));
+}
+
+TEST_F(FX_EGraph, optimizeEGraph_LongSumsOverNodeLimit_NotWorseThanGreedy) {
+    // x+x+...+x and x*1+x*2+...+x*n are far beyond EGraphLimits::maxNodes and too deep for recursion
+    PExpression sameTerms = createVariable("x");
+    for (int i = 1; i < 200000; i++) {
+        sameTerms = createSum(sameTerms, createVariable("x"));
+    }
+    PExpression differentTerms = createMult(createVariable("x"), createConstant(1.0));
+    for (int i = 2; i <= 20000; i++) {
+        differentTerms = createSum(differentTerms, createMult(createVariable("x"), createConstant(i)));
+    }
+
+    for (const PExpression &expr : {sameTerms, differentTerms}) {
+        PExpression greedy = optimize(expr);
+        PExpression actResult = optimizeEGraph(expr);
+        ASSERT_LE(to_string(actResult).size(), to_string(greedy).size()) << to_string(greedy) << " vs " << to_string(actResult);
+    }
+}
+
+TEST_F(FX_EGraph, optimizeEGraph_NodeLimitReached_ValidResult) {
+    // (x+1)^2 * (x+1)^3 / (x+1) with a tiny budget
+    PExpression xPlus1 = createSum(createVariable("x"), createConstant(1.0));
+    PExpression expr = createDiv(
+        createMult(createPow(xPlus1, createConstant(2.0)), createPow(xPlus1, createConstant(3.0))),
+        xPlus1);
+    EGraphLimits limits;
+    limits.maxNodes = 12;
+
+    PExpression actResult;
+    ASSERT_NO_THROW(actResult = optimizeEGraph(expr, limits));
+    ASSERT_NE(nullptr, actResult);
+    ASSERT_TRUE(actResult->isComplete());
+}
+
+TEST_F(FX_EGraph, optimizeEGraph_DivisionByZero_TraverseException) {
+    ASSERT_THROW(optimizeEGraph(createDiv(createVariable("x"), createConstant(0.0))), TraverseException);
+}
+
+TEST_F(FX_EGraph, optimizeEGraph_PassLimitOfBudget_BudgetExceededException) {
+    // unlike EGraphLimits, an exhausted ResourceBudget aborts the request
+    PExpression expr = createSum(createMult(createVariable("x"), createConstant(1.0)), createConstant(0.0));
+    ResourceLimits limits;
+    limits.maxPasses = 1;
+    ResourceBudget budget(limits);
+    BudgetScope scope(&budget);
+
+    ASSERT_THROW(optimizeEGraph(expr), BudgetExceededException);
+    ASSERT_EQ(2u, budget.getPasses());
+}
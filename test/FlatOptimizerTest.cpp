@@ -0,0 +1,79 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file FlatOptimizerTest.cpp
+ *
+ * Tests for the optimization of flat expressions.
+ *
+ * @since 18.10.2026
+ * @author agor
+ */
+
+#include <gtest/gtest.h>
+
+#include "FlatOptimizer.h"
+#include "Differentiator.h"
+#include "Parser.h"
+#include "Equivalence.h"
+
+class FX_FlatOptimizer : public testing::Test {
+protected:
+
+    virtual void SetUp() {
+    }
+
+    virtual void TearDown() {
+    }
+
+    std::string optimizeString(const std::string &strExpr) {
+        return to_string(optimize(flatten(*parse(strExpr))));
+    }
+};
+
+TEST_F(FX_FlatOptimizer, optimize_LocalRules_Simplified) {
+    ASSERT_EQ("5", optimizeString("2+3"));
+    ASSERT_EQ("0.5", optimizeString("sin(0)+1/2"));
+    ASSERT_EQ("x", optimizeString("0+x*1"));
+    ASSERT_EQ("0", optimizeString("sin(x)*0"));
+    ASSERT_EQ("x", optimizeString("x^1-0"));
+    ASSERT_EQ("1", optimizeString("y^0"));
+    ASSERT_EQ("2*sin(x)", optimizeString("sin(x)+sin(x)"));
+    ASSERT_EQ("0", optimizeString("(x+1)-(x+1)"));
+    ASSERT_EQ("x^2", optimizeString("x*x"));
+    ASSERT_EQ("1", optimizeString("ln(x)/ln(x)"));
+    ASSERT_EQ("x+y", optimizeString("ln(exp(x+y))"));
+    ASSERT_EQ("x/0", optimizeString("x/0"));
+}
+
+TEST_F(FX_FlatOptimizer, optimize_IdenticalSubexpressions_SharedNode) {
+    FlatExpression flat = flatten(*parse("sin(x+y)*cos(x+y)+sin(x+y)"));
+
+    FlatExpression optimized = optimize(flat);
+
+    // x, y, x+y, sin, cos, *, +
+    ASSERT_EQ(7u, optimized.size());
+    ASSERT_EQ(to_string(flat), to_string(optimized));
+}
+
+TEST_F(FX_FlatOptimizer, optimize_Derivative_EquivalentToTree) {
+    const char *expressions[] = {
+        "x^2+3*x", "sin(x)*cos(x)", "ln(x^2+1)/exp(x)", "tan(2*x)-ctan(x)", "x^x"
+    };
+
+    for (const char *strExpr : expressions) {
+        PExpression expr = parse(strExpr);
+        FlatExpression derivative = differentiate(flatten(*expr), "x");
+
+        ASSERT_EQ(to_string(differentiate(expr, "x")), to_string(derivative)) << strExpr;
+
+        PExpression optimized = optimize(derivative).toExpression();
+        ASSERT_TRUE(probablyEquivalent(*differentiate(expr, "x"), *optimized)) << strExpr;
+        ASSERT_LE(optimize(derivative).size(), derivative.size()) << strExpr;
+    }
+}
+
+TEST_F(FX_FlatOptimizer, optimize_EmptyExpression_TraverseException) {
+    ASSERT_THROW(optimize(FlatExpression()), TraverseException);
+}
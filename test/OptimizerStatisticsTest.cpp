@@ -0,0 +1,100 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file OptimizerStatisticsTest.cpp
+ * 
+ * Tests for OptimizerStatistics.
+ *
+ * @since 18.10.2026
+ * @author agor
+ */
+
+#include <gtest/gtest.h>
+
+#include <sstream>
+
+#include "OptimizerStatistics.h"
+#include "Optimizer.h"
+#include "SumConstantsRule.h"
+#include "ExpressionFactory.h"
+
+class FX_OptimizerStatistics : public testing::Test {
+protected:
+
+    virtual void SetUp() {
+    }
+
+    virtual void TearDown() {
+    }
+};
+
+TEST_F(FX_OptimizerStatistics, record_SeveralAttempts_Accumulated) {
+    OptimizerStatistics statistics;
+    statistics.record("A", false, std::chrono::nanoseconds(10));
+    statistics.beginPass();
+    statistics.record("B", true, std::chrono::nanoseconds(20));
+    statistics.record("A", true, std::chrono::nanoseconds(30));
+    statistics.endPass();
+
+    ASSERT_EQ(2u, statistics.getRules().size());
+    ASSERT_EQ("A", statistics.getRules()[0].name);
+    ASSERT_EQ(2ul, statistics.getRule("A")->attempts);
+    ASSERT_EQ(1ul, statistics.getRule("A")->hits);
+    ASSERT_EQ(40, statistics.getRule("A")->time.count());
+    ASSERT_EQ(nullptr, statistics.getRule("C"));
+
+    // the first attempt was recorded outside of the pass
+    ASSERT_EQ(1u, statistics.getPasses().size());
+    ASSERT_EQ(2ul, statistics.getPasses()[0].attempts);
+    ASSERT_EQ(2ul, statistics.getPasses()[0].hits);
+    ASSERT_EQ(50, statistics.getPasses()[0].ruleTime.count());
+}
+
+TEST_F(FX_OptimizerStatistics, optimize_SumOfConstants_HitRecorded) {
+    OptimizerStatistics statistics;
+    PExpression result = optimize(createSum(createConstant(2.0), createConstant(3.0)), &statistics);
+
+    ASSERT_TRUE(equals(createConstant(5.0), result));
+    const RuleStatistics *rule = statistics.getRule(SumConstantsRule::name());
+    ASSERT_NE(nullptr, rule);
+    ASSERT_EQ(1ul, rule->attempts);
+    ASSERT_EQ(1ul, rule->hits);
+    ASSERT_FALSE(statistics.getPasses().empty());
+    ASSERT_EQ(1ul, statistics.getPasses()[0].hits);
+    // nothing to optimize in subsequent passes
+    ASSERT_EQ(0ul, statistics.getPasses().back().attempts);
+}
+
+TEST_F(FX_OptimizerStatistics, print_AnyStatistics_RulesAndPassesPrinted) {
+    OptimizerStatistics statistics;
+    optimize(createSin(createMult(createConstant(0.0), createVariable("x"))), &statistics);
+
+    std::stringstream out;
+    statistics.print(out);
+    ASSERT_NE(std::string::npos, out.str().find("MultConstantsRule"));
+    ASSERT_NE(std::string::npos, out.str().find("FunctionEvaluateRule<Sin>"));
+    ASSERT_NE(std::string::npos, out.str().find("pass"));
+}
+
+TEST_F(FX_OptimizerStatistics, merge_OtherStatistics_AddedToRulesAndPass) {
+    OptimizerStatistics statistics;
+    statistics.beginPass();
+    statistics.record("A", true, std::chrono::nanoseconds(10));
+    OptimizerStatistics other;
+    other.record("B", false, std::chrono::nanoseconds(20));
+    other.record("A", true, std::chrono::nanoseconds(30));
+
+    statistics.merge(other);
+    statistics.endPass();
+
+    ASSERT_EQ(2u, statistics.getRule("A")->attempts);
+    ASSERT_EQ(2u, statistics.getRule("A")->hits);
+    ASSERT_EQ(40, statistics.getRule("A")->time.count());
+    ASSERT_EQ(1u, statistics.getRule("B")->attempts);
+    ASSERT_EQ(0u, statistics.getRule("B")->hits);
+    ASSERT_EQ(3u, statistics.getPasses()[0].attempts);
+    ASSERT_EQ(2u, statistics.getPasses()[0].hits);
+    ASSERT_EQ(60, statistics.getPasses()[0].ruleTime.count());
+}
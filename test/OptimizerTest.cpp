@@ -18,6 +18,10 @@
 #include "Sum.h"
 #include "Doubles.h"
 #include "ExpressionFactory.h"
+#include "Equivalence.h"
+#include "Rebalancer.h"
+#include "StructuralEquality.h"
+#include "ResourceBudget.h"
 
 class FX_Optimizer : public testing::Test {
 protected:
@@ -315,6 +319,8 @@ TEST_F(FX_Optimizer, optimize_SimpleOptimizations_Successfull) {
         EXPECT_TRUE(equals(expResults[testId], actResult)) << 
                 "Result does not match for test ID=" << testId << "! (" 
                 << expected << " != " << actual;
+        // optimization must not change the function
+        EXPECT_TRUE(probablyEquivalent(*tests[testId], *actResult)) << "Test ID=" << testId;
     }
 }
 
@@ -345,4 +351,67 @@ TEST_F(FX_Optimizer, optimize_ExceptionalCases_TraverseException) {
     for(unsigned int testId=0; testId < tests.size(); testId++){
         EXPECT_THROW(optimize(tests[testId]), TraverseException) << "Test ID=" << testId << " did not throw an exception!";
     }
-}
\ No newline at end of file
+}
+
+TEST_F(FX_Optimizer, tryOptimize_ExceptionalCases_Failure) {
+    ASSERT_EQ("2", to_string(tryOptimize(createSum(createConstant(1), createConstant(1))).getValue()));
+
+    Expected<PExpression> result = tryOptimize(createDiv(createConstant(1), createConstant(0)));
+    ASSERT_FALSE(result);
+    ASSERT_EQ(Failure::Traverse, result.getFailure().kind);
+    ASSERT_EQ(0u, result.getFailure().message.find("Division by zero."));
+    ASSERT_FALSE(tryOptimize(createLn(createConstant(-2.0))));
+    ASSERT_FALSE(tryOptimize(nullptr));
+}
+
+TEST_F(FX_Optimizer, tryOptimize_BudgetExhausted_BudgetFailure) {
+    PExpression expr = createSum(createMult(createConstant(2), createVariable("x")), createConstant(1));
+    ResourceLimits limits;
+    // optimize() makes 20 passes at least
+    limits.maxPasses = 20;
+    {
+        ResourceBudget budget(limits);
+        BudgetScope scope(&budget);
+        ASSERT_TRUE(tryOptimize(expr));
+        ASSERT_EQ(20u, budget.getPasses());
+    }
+    limits.maxPasses = 19;
+    {
+        ResourceBudget budget(limits);
+        BudgetScope scope(&budget);
+        Expected<PExpression> result = tryOptimize(expr);
+        ASSERT_FALSE(result);
+        ASSERT_EQ(Failure::Budget, result.getFailure().kind);
+        ASSERT_EQ(0u, result.getFailure().message.find("The request has exceeded the limit of optimization passes."));
+    }
+    {
+        CancellationToken token;
+        token.cancel();
+        ResourceBudget budget(ResourceLimits(), &token);
+        BudgetScope scope(&budget);
+        Expected<PExpression> result = tryOptimize(expr);
+        ASSERT_FALSE(result);
+        ASSERT_EQ(Failure::Budget, result.getFailure().kind);
+    }
+}
+TEST_F(FX_Optimizer, optimize_Parallel_SameAsSequential) {
+    PExpression expr = createVariable("x");
+    for (int i = 1; i < 500; i++) {
+        expr = createSum(expr, createMult(createMult(createConstant(i % 7), createVariable("x")), createPow(createVariable("y"), createConstant(i % 3))));
+    }
+    expr = rebalance(expr);
+    ThreadPool pool(4);
+    OptimizerStatistics sequentialStatistics;
+    OptimizerStatistics parallelStatistics;
+    
+    PExpression sequential = optimize(expr, &sequentialStatistics);
+    PExpression parallel = optimize(expr, &parallelStatistics, &pool, 64);
+    
+    ASSERT_EQ(to_string(sequential), to_string(parallel));
+    ASSERT_EQ(sequentialStatistics.getPasses().size(), parallelStatistics.getPasses().size());
+    for (const RuleStatistics &rule : sequentialStatistics.getRules()) {
+        ASSERT_NE(nullptr, parallelStatistics.getRule(rule.name));
+        ASSERT_EQ(rule.attempts, parallelStatistics.getRule(rule.name)->attempts) << rule.name;
+        ASSERT_EQ(rule.hits, parallelStatistics.getRule(rule.name)->hits) << rule.name;
+    }
+}
@@ -0,0 +1,181 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file ResultStoreTest.cpp
+ *
+ * Tests for the persistent store of derivatives.
+ *
+ * @since 18.10.2026
+ * @author agor
+ */
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include "ResultStore.h"
+
+class FX_ResultStore : public testing::Test {
+protected:
+    const char *path = "ResultStoreTest.store";
+
+    virtual void SetUp() {
+        std::remove(path);
+    }
+
+    virtual void TearDown() {
+        std::remove(path);
+    }
+
+    std::string find(ResultStore &store, const std::string &key) {
+        size_t size = 0;
+        const char *value = store.find(key, size);
+        return value == nullptr ? "<none>" : std::string(value, size);
+    }
+};
+
+TEST_F(FX_ResultStore, find_AddedRecords_FoundAfterReopening) {
+    {
+        ResultStore store;
+        ASSERT_TRUE(store.open(path));
+        ASSERT_EQ("<none>", find(store, "a"));
+        ASSERT_TRUE(store.add("a", "value of a"));
+        ASSERT_TRUE(store.add("b", std::string("\0binary\0", 8)));
+        ASSERT_EQ("value of a", find(store, "a"));
+    }
+
+    ResultStore store;
+    ASSERT_TRUE(store.open(path));
+    ASSERT_EQ(2u, store.size());
+    ASSERT_EQ("value of a", find(store, "a"));
+    ASSERT_EQ(std::string("\0binary\0", 8), find(store, "b"));
+    ASSERT_EQ("<none>", find(store, "c"));
+}
+
+TEST_F(FX_ResultStore, find_SameKeyAddedTwice_FirstValue) {
+    ResultStore store;
+    ASSERT_TRUE(store.open(path));
+
+    store.add("a", "first");
+    store.add("a", "second");
+
+    ASSERT_EQ("first", find(store, "a"));
+}
+
+TEST_F(FX_ResultStore, open_TwoStoresOfOneFile_SeeRecordsOfEachOther) {
+    ResultStore first;
+    ResultStore second;
+    ASSERT_TRUE(first.open(path));
+    ASSERT_TRUE(second.open(path));
+
+    first.add("a", "1");
+    second.add("b", "2");
+
+    ASSERT_EQ("1", find(second, "a"));
+    ASSERT_EQ("2", find(second, "b"));
+    ResultStore third;
+    ASSERT_TRUE(third.open(path));
+    ASSERT_EQ(2u, third.size());
+}
+
+TEST_F(FX_ResultStore, open_IncompleteLastRecord_CutOff) {
+    {
+        ResultStore store;
+        ASSERT_TRUE(store.open(path));
+        store.add("a", "1");
+    }
+    {
+        std::ofstream out(path, std::ios::app | std::ios::binary);
+        out << "partial";
+    }
+
+    ResultStore store;
+    ASSERT_TRUE(store.open(path));
+    ASSERT_EQ(1u, store.size());
+    ASSERT_TRUE(store.add("b", "2"));
+    ASSERT_EQ("1", find(store, "a"));
+    ASSERT_EQ("2", find(store, "b"));
+}
+
+TEST_F(FX_ResultStore, add_ManyRecords_AllFound) {
+    // the file outgrows the initial mapping several times
+    ResultStore store;
+    ASSERT_TRUE(store.open(path));
+    std::string value(1000, 'v');
+    for (int i = 0; i < 5000; i++) {
+        ASSERT_TRUE(store.add(std::to_string(i), value + std::to_string(i)));
+    }
+
+    ASSERT_EQ(5000u, store.size());
+    for (int i = 0; i < 5000; i += 7) {
+        ASSERT_EQ(value + std::to_string(i), find(store, std::to_string(i)));
+    }
+}
+
+TEST_F(FX_ResultStore, open_ProcessesCreateFileAtOnce_OneHeaderAndAllRecords) {
+    const int processes = 8;
+    const int records = 50;
+    // the children wait until the pipe is closed, then they open the store at once
+    int start[2];
+    ASSERT_EQ(0, pipe(start));
+    std::vector<pid_t> children;
+    for (int process = 0; process < processes; process++) {
+        pid_t child = fork();
+        ASSERT_LE(0, child);
+        if (child == 0) {
+            char byte;
+            ::close(start[1]);
+            while (read(start[0], &byte, 1) > 0) {
+            }
+            ResultStore store;
+            bool isValid = store.open(path);
+            for (int i = 0; i < records && isValid; i++) {
+                isValid = store.add(std::to_string(process) + ":" + std::to_string(i), std::to_string(i));
+            }
+            _exit(isValid ? 0 : 1);
+        }
+        children.push_back(child);
+    }
+    ::close(start[0]);
+    ::close(start[1]);
+    for (pid_t child : children) {
+        int status = 0;
+        ASSERT_EQ(child, waitpid(child, &status, 0));
+        ASSERT_TRUE(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+
+    ResultStore store;
+    ASSERT_TRUE(store.open(path));
+    ASSERT_EQ(static_cast<size_t> (processes * records), store.size());
+    for (int process = 0; process < processes; process++) {
+        ASSERT_EQ(std::to_string(records - 1), find(store, std::to_string(process) + ":" + std::to_string(records - 1)));
+    }
+}
+
+TEST_F(FX_ResultStore, open_NotAStore_False) {
+    {
+        std::ofstream out(path);
+        out << "some text";
+    }
+    ResultStore store;
+
+    ASSERT_FALSE(store.open(path));
+    ASSERT_FALSE(store.isOpen());
+    ASSERT_FALSE(store.add("a", "1"));
+    ASSERT_EQ("<none>", find(store, "a"));
+    ASSERT_FALSE(store.open("no/such/directory/file"));
+}
+
+TEST_F(FX_ResultStore, key_SpacesIgnored) {
+    ASSERT_EQ(ResultStore::key("x^2 + 1", "x", ""), ResultStore::key(" x^2+1\t", "x", ""));
+    ASSERT_NE(ResultStore::key("x^2+1", "x", ""), ResultStore::key("x^2+1", "y", ""));
+    ASSERT_NE(ResultStore::key("x^2+1", "x", ""), ResultStore::key("x^2+1", "x", "e"));
+}
@@ -0,0 +1,69 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file RuleTableTest.cpp
+ * 
+ * Tests for RuleTable template.
+ *
+ * @since 18.10.2026
+ * @author agor
+ */
+
+#include <gtest/gtest.h>
+
+#include "RuleTable.tpp"
+#include <ExpressionFactory.h>
+
+class FX_RuleTable : public testing::Test {
+protected:
+
+    virtual void SetUp() {
+    }
+
+    virtual void TearDown() {
+    }
+};
+
+TEST_F(FX_RuleTable, applyFirst_NoRuleApplicable_False) {
+    PExpression result;
+    ASSERT_FALSE(SummationRules::applyFirst(createSum(createVariable("x"), createVariable("y")), result));
+    ASSERT_EQ(nullptr, result);
+}
+
+TEST_F(FX_RuleTable, applyFirst_SeveralRulesApplicable_FirstApplied) {
+    // both SumConstantsRule and SumWithNullArgumentRule are applicable
+    PExpression result;
+    ASSERT_TRUE(SummationRules::applyFirst(createSum(createConstant(0.0), createConstant(3.0)), result));
+    ASSERT_TRUE(equals(createConstant(3.0), result)) << to_string(result);
+}
+
+TEST_F(FX_RuleTable, applyAll_SeveralRulesApplicable_AllResultsCollected) {
+    std::vector<PExpression> results;
+    // MultIdenticalExpressionsRule: x^2, no other rule is applicable
+    MultiplicationRules::applyAll(createMult(createVariable("x"), createVariable("x")), results);
+    ASSERT_EQ(1u, results.size());
+    ASSERT_TRUE(equals(createPow(createVariable("x"), createConstant(2.0)), results[0])) << to_string(results[0]);
+
+    results.clear();
+    RuleTable<PSum, SumConstantsRule, SumWithNullArgumentRule>::applyAll(createSum(createConstant(0.0), createConstant(3.0)), results);
+    ASSERT_EQ(2u, results.size());
+}
+
+TEST_F(FX_RuleTable, applyFirst_MayApplyFails_RuleNotTried) {
+    PSum expr = createSum(createConstant(0.0), createConstant(3.0));
+    OptimizerStatistics statistics;
+    PExpression result;
+    ASSERT_TRUE(SummationRules::applyFirst(expr, result, &statistics));
+    ASSERT_TRUE(equals(createConstant(3.0), result));
+    ASSERT_EQ(1ul, statistics.getRule(SumConstantsRule::name())->hits);
+    ASSERT_EQ(nullptr, statistics.getRule(SumWithNullArgumentRule::name()));
+
+    result = nullptr;
+    ASSERT_FALSE(SummationRules::applyFirst(createSum(createVariable("x"), createConstant(1.0)), result, &statistics));
+    ASSERT_EQ(1ul, statistics.getRule(SumWithNullArgumentRule::name())->attempts);
+    // not a product and the arguments differ in type, mayApply() fails
+    ASSERT_EQ(nullptr, statistics.getRule(SumIdenticalExpressionsRule::name()));
+    ASSERT_EQ(nullptr, statistics.getRule(SumWithNegativeRule::name()));
+}
@@ -0,0 +1,208 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file SolverServerTest.cpp
+ *
+ * Tests for the solver serving clients over a Unix socket.
+ *
+ * @since 18.10.2026
+ * @author agor
+ */
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include "SolverServer.h"
+
+TEST(SolverServer, answer_Request_Derivative) {
+    SolverServer server(SolverServer::Options(), 1);
+    ASSERT_EQ("2*x", server.answer("x^2\tx"));
+    ASSERT_EQ("1", server.answer("x + y\tx"));
+    ASSERT_EQ("(cos(x)^2)-(sin(x)^2)", server.answer("sin(x)cos(x)\tx"));
+}
+
+TEST(SolverServer, answer_Options_OverrideDefaults) {
+    SolverServer::Options defaults;
+    defaults.precision = 1;
+    SolverServer server(defaults, 1);
+    ASSERT_EQ("0.5*((x+3)^-0.5)", server.answer("(x+exp(1))^0.5\tx"));
+    ASSERT_EQ("0.5*((x+2.7)^-0.5)", server.answer("(x+exp(1))^0.5\tx\tprecision=2"));
+    ASSERT_EQ("t1 = sin(x); t2 = cos(x)*exp(t1); result = (t2*t1)+t2", server.answer("exp(sin(x))*sin(x)\tx\tlet egraph"));
+}
+
+TEST(SolverServer, answer_InvalidRequests_OneLineErrors) {
+    SolverServer server(SolverServer::Options(), 1);
+    ASSERT_EQ("ERROR: Division by zero. Context: 0", server.answer("x/0\tx"));
+    ASSERT_EQ(0u, server.answer("x^(3+)\tx").find("ERROR: The expression is incomplete."));
+    ASSERT_EQ(0u, server.answer("x + (2 sin)\tx").find("ERROR: The specified expression is ambiguous."));
+    ASSERT_EQ(0u, server.answer("x^2").find("ERROR: The request must be"));
+    ASSERT_EQ("ERROR: Unknown option fast.", server.answer("x^2\tx\tfast"));
+    ASSERT_EQ(0u, server.answer("x^2\tx\tprecision=100").find("ERROR: Precision must be"));
+}
+
+TEST(SolverServer, answer_Limits_BudgetErrors) {
+    SolverServer::Options defaults;
+    defaults.limits.maxPasses = 19;
+    SolverServer server(defaults, 1);
+    ASSERT_EQ("ERROR: The request has exceeded the limit of optimization passes. Context: Limit: 19 passes", server.answer("x^2\tx"));
+    ASSERT_EQ("2*x", server.answer("x^2\tx\tmax-passes=0"));
+    ASSERT_EQ("ERROR: The request has exceeded the limit of nodes. Context: Limit: 10 nodes", server.answer("sin(x)^3\tx\tmax-nodes=10 max-passes=0"));
+    ASSERT_EQ("ERROR: The limit of nodes must be a non-negative integer.", server.answer("x^2\tx\tmax-nodes=-1"));
+    ASSERT_EQ("ERROR: The timeout must be a non-negative integer of milliseconds.", server.answer("x^2\tx\ttimeout=99999999999"));
+
+    // cached derivatives are answered, the others are cancelled
+    server.stop();
+    ASSERT_EQ("2*x", server.answer("x^2\tx\tmax-passes=0"));
+    ASSERT_EQ("ERROR: The request has been cancelled. Context: N.A.", server.answer("x^3\tx\tmax-passes=0"));
+}
+
+TEST(SolverServer, answer_RepeatedRequests_DerivativeFromCache) {
+    SolverServer server(SolverServer::Options(), 1);
+    ASSERT_EQ("2*x", server.answer("x^2\tx"));
+    ASSERT_EQ("2*x", server.answer(" x ^ 2\tx"));
+    ASSERT_EQ("0", server.answer("x^2\ty"));
+    // only the options which change the derivative are a part of the key
+    ASSERT_EQ("2*x", server.answer("x^2\tx\tegraph"));
+    ASSERT_EQ("2*x", server.answer("x^2\tx\tprecision=3"));
+
+    CacheStatistics statistics = server.getStatistics();
+    ASSERT_EQ(2u, statistics.hits);
+    ASSERT_EQ(3u, statistics.misses);
+}
+
+namespace {
+
+/**
+ * @return The connected socket, -1 on failure.
+ */
+int connectTo(const char *path) {
+    sockaddr_un address;
+    std::memset(&address, 0, sizeof (address));
+    address.sun_family = AF_UNIX;
+    std::strcpy(address.sun_path, path);
+    int client = socket(AF_UNIX, SOCK_STREAM, 0);
+    // the server may not listen yet
+    for (int attempt = 0; client >= 0 && attempt < 500; attempt++) {
+        if (connect(client, reinterpret_cast<sockaddr *> (&address), sizeof (address)) == 0) {
+            return client;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    close(client);
+    return -1;
+}
+
+/**
+ * Read until the number of lines is received or the server disconnects.
+ */
+std::string readLines(int client, long lines) {
+    std::string answers;
+    char buffer[256];
+    while (std::count(answers.begin(), answers.end(), '\n') < lines) {
+        ssize_t count = read(client, buffer, sizeof (buffer));
+        if (count <= 0) {
+            break;
+        }
+        answers.append(buffer, count);
+    }
+    return answers;
+}
+
+}
+
+TEST(SolverServer, serve_PipelinedRequests_AnswersInOrder) {
+    const char *path = "SolverServerTest.sock";
+    SolverServer server(SolverServer::Options(), 2);
+    bool served = false;
+    std::thread thread([&]() {
+        served = server.serve(path);
+    });
+
+    int client = connectTo(path);
+    ASSERT_LE(0, client);
+
+    // the second request is split between two writes
+    std::string requests = "x^2\tx\r\n\nx/0\tx\nsin(";
+    ASSERT_EQ(static_cast<ssize_t> (requests.size()), write(client, requests.data(), requests.size()));
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    ASSERT_EQ(5, write(client, "x)\tx\n", 5));
+    ASSERT_EQ("2*x\nERROR: Division by zero. Context: 0\ncos(x)\n", readLines(client, 3));
+
+    // the connected client is disconnected
+    server.stop();
+    thread.join();
+    char buffer[16];
+    ASSERT_EQ(0, read(client, buffer, sizeof (buffer)));
+    close(client);
+    ASSERT_TRUE(served);
+    ASSERT_NE(0, access(path, F_OK));
+}
+
+TEST(SolverServer, serve_IdleConnections_OtherClientsAnswered) {
+    const char *path = "SolverServerTest.sock";
+    SolverServer server(SolverServer::Options(), 1);
+    std::thread thread([&]() {
+        server.serve(path);
+    });
+
+    // neither of them occupies the only worker
+    int idle = connectTo(path);
+    int incomplete = connectTo(path);
+    ASSERT_LE(0, idle);
+    ASSERT_LE(0, incomplete);
+    ASSERT_EQ(4, write(incomplete, "x^2\t", 4));
+
+    int client = connectTo(path);
+    ASSERT_LE(0, client);
+    ASSERT_EQ(6, write(client, "x^2\tx\n", 6));
+    // the requests sent before the end of writing are answered
+    ASSERT_EQ(0, shutdown(client, SHUT_WR));
+    ASSERT_EQ("2*x\n", readLines(client, 2));
+    close(client);
+
+    server.stop();
+    thread.join();
+    char buffer[16];
+    ASSERT_EQ(0, read(idle, buffer, sizeof (buffer)));
+    ASSERT_EQ(0, read(incomplete, buffer, sizeof (buffer)));
+    close(idle);
+    close(incomplete);
+}
+
+TEST(SolverServer, serve_ManyPipelinedRequests_AnswersInOrder) {
+    const char *path = "SolverServerTest.sock";
+    SolverServer server(SolverServer::Options(), 4);
+    std::thread thread([&]() {
+        server.serve(path);
+    });
+
+    int client = connectTo(path);
+    ASSERT_LE(0, client);
+    // more than maxPendingRequests, the answers come from several workers
+    std::string requests;
+    std::string expected;
+    for (int i = 0; i < 1000; i++) {
+        requests += i % 2 == 0 ? "x^2\tx\n" : "sin(x)\tx\n";
+        expected += i % 2 == 0 ? "2*x\n" : "cos(x)\n";
+    }
+    for (size_t sent = 0; sent < requests.size(); sent += 1000) {
+        size_t size = std::min<size_t>(1000, requests.size() - sent);
+        ASSERT_EQ(static_cast<ssize_t> (size), write(client, requests.data() + sent, size));
+    }
+    ASSERT_EQ(expected, readLines(client, 1000));
+
+    server.stop();
+    thread.join();
+    close(client);
+}
@@ -0,0 +1,106 @@
+/* Licensed to Oleg Tsemaylo under the MIT license.
+ * Refer to the LICENSE.txt file in the project root for more information.
+ */
+
+/**
+ * @file ThreadPoolTest.cpp
+ *
+ * Tests for ThreadPool.
+ *
+ * @since 18.10.2026
+ * @author agor
+ */
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+
+#include "ThreadPool.h"
+
+class FX_ThreadPool : public testing::Test {
+protected:
+
+    virtual void SetUp() {
+    }
+
+    virtual void TearDown() {
+    }
+};
+
+TEST_F(FX_ThreadPool, run_ManyTasks_AllExecutedOnce) {
+    ThreadPool pool(4);
+    std::vector<int> executed(1000, 0);
+    std::vector<std::function<void()>> tasks;
+    for (size_t i = 0; i < executed.size(); i++) {
+        tasks.push_back([&executed, i]() {
+            executed[i]++;
+        });
+    }
+
+    pool.run(tasks);
+
+    ASSERT_EQ(4u, pool.size());
+    for (int count : executed) {
+        ASSERT_EQ(1, count);
+    }
+}
+
+TEST_F(FX_ThreadPool, run_SingleThread_ExecutedByCaller) {
+    ThreadPool pool(1);
+    int sum = 0;
+    std::vector<std::function<void()>> tasks;
+    for (int i = 1; i <= 10; i++) {
+        tasks.push_back([&sum, i]() {
+            sum += i;
+        });
+    }
+
+    pool.run(tasks);
+
+    ASSERT_EQ(1u, pool.size());
+    ASSERT_EQ(55, sum);
+}
+
+TEST_F(FX_ThreadPool, run_FailedTasks_FirstExceptionRethrown) {
+    ThreadPool pool(4);
+    std::atomic<int> executed(0);
+    std::vector<std::function<void()>> tasks;
+    for (int i = 0; i < 100; i++) {
+        tasks.push_back([&executed, i]() {
+            executed++;
+            if (i == 30 || i == 70) {
+                throw std::runtime_error(std::to_string(i));
+            }
+        });
+    }
+
+    try {
+        pool.run(tasks);
+        FAIL() << "No exception";
+    } catch (const std::runtime_error &ex) {
+        ASSERT_STREQ("30", ex.what());
+    }
+    ASSERT_EQ(100, executed);
+}
+
+TEST_F(FX_ThreadPool, run_NestedRun_NoDeadlock) {
+    ThreadPool pool(2);
+    std::atomic<int> executed(0);
+    std::vector<std::function<void()>> tasks;
+    for (int i = 0; i < 8; i++) {
+        tasks.push_back([&pool, &executed]() {
+            std::vector<std::function<void()>> nested;
+            for (int j = 0; j < 8; j++) {
+                nested.push_back([&executed]() {
+                    executed++;
+                });
+            }
+            pool.run(nested);
+        });
+    }
+
+    pool.run(tasks);
+
+    ASSERT_EQ(64, executed);
+}
@@ -47,6 +47,24 @@ check(){
    fi
 }
 
+check_batch(){
+   testId=$1
+   expected=$2
+   input=$3
+   variable=$4
+   options=$5
+
+   actual=$(printf "$input" | $CMD --batch $options $variable)
+   if [ "$expected" = "$actual" ]; then
+      echo "$testId - OK"
+   else
+      echo "$testId - FAILED"
+      echo "   Expected: $expected"
+      echo "   Actual: $actual"
+      failedTests=1
+   fi
+}
+
 if [ "$DO_VALGRIND_TEST" = "1" ]; then
    VALGRIND="valgrind --error-exitcode=${VALGRIND_ERROR_CODE} --leak-check=full"
 fi
@@ -80,9 +98,26 @@ check T18 '-2*(x^-3)'                                        '1/x^2'
 check T19 '(2^cos(x))*(-0.69*sin(x))'                        '2^cos(x)'                'x'
 check T20 '((x^-1)*0.7)/((ln(x)-8)^0.3)'                     '(ln(x)-8)^0.7'           'x'
 
-check T21 'The specified expression is ambiguous. Not able to completely reduce syntax tree.'     'x^(3+)' 'x'     'substring' 
+check T21 'The expression is incomplete. An operand or argument is missing.'     'x^(3+)' 'x'     'substring' 
 check T22 'Division by zero.'     'x/0' 'x'      'substring'
 
+check_batch T23 "$(printf '2*x\nERROR: Division by zero. Context: 0\n1')" 'x^2\nx/0\n\nx+y\n' 'x'
+check T26 'OK' 'sin(x)^2 + 2x' '--check'
+check T27 "ERROR: Unknown character. Position: 4" "x + 'y'" '--check'
+check_batch T28 "$(printf 'OK\nERROR: No closing bracket has been found. Position: 2\nOK')" 'x^2\nx+(y\n\n-x\n' '' '--check'
+check_batch T29 "$(printf '2*x\nERROR: The request has exceeded the limit of nodes. Context: Limit: 500 nodes')" 'x^2\nsin(x)^3\n' 'x' '--max-nodes=500'
+check T30 'The request has exceeded the limit of optimization passes.' 'x^2' 'x --max-passes=19' 'substring'
+check T31 '' 'x^2' 'x --egrahp'
+check T32 '-1' '--' '-x x'
+deepExpression="$(printf 'sin(%.0s' $(seq 20000))x$(printf ')%.0s' $(seq 20000))"
+check T33 'The expression is nested too deeply.' "$deepExpression" 'x' 'substring'
+check T34 'ERROR: The expression is nested too deeply. Position: 4003' "$deepExpression" '--check'
+
+rm -f testApplication.store
+check_batch T24 "$(printf '2*x\ncos(x)')" 'x^2\nsin(x)\n' 'x' '--store=testApplication.store'
+check_batch T25 "$(printf '2*x\ncos(x)\n1')" 'x^2\nsin(x)\nx\n' 'x' '--store=testApplication.store'
+rm -f testApplication.store
+
 echo "========================================"
 
 exit $failedTests